@@ -0,0 +1,170 @@
+/**
+ * RecordingBenchmark.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Game.h"
+#include "MemoryManager.h"
+#include "Renderer.h"
+#include "SpriteComponent.h"
+#include "SpriteStorage.h"
+#include "Texture.h"
+#include "TransferScheduler.h"
+#include "WorldManager.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vulkan/vulkan.h>
+
+const uint32 BENCHMARK_SPRITES = 100000;
+const uint32 BENCHMARK_FRAMES = 300;
+const uint32 BENCHMARK_WARMUP_FRAMES = 30;
+const uint32 BENCHMARK_LATE_SPRITES = 50000;
+
+class RecordingBenchmark : public Game {
+public:
+    void begin() override {
+        // Create Textures
+        textures = {
+                Texture::createTextureFromFile("blue.png").unwrap(),
+                Texture::createTextureFromFile("gohan.png").unwrap(),
+                Texture::createTextureFromFile("goku.png").unwrap(),
+                Texture::createTextureFromFile("vegeta.png").unwrap()
+        };
+
+        for (auto &texture : textures) {
+            texture->load();
+        }
+
+        createSprites(BENCHMARK_SPRITES);
+    }
+
+    void update() override {
+
+    }
+
+    /* Cria count sprites em posições aleatórias, com uma das quatro texturas. */
+    void createSprites(uint32 count) {
+        WorldManager &worldManager = WorldManager::getManager();
+
+        for (uint32 i = 0; i < count; ++i) {
+            glm::vec2 pos = glm::vec2(rand()%25600/100.0f-rand()%25600/100.0f,
+                                      rand()%25600/100.0f-rand()%25600/100.0f);
+            glm::quat rot = glm::angleAxis(glm::radians(rand()%18000/100.0f),
+                                           glm::vec3(0.0f,0.0f,1.0f));
+            glm::vec2 scl = glm::vec2(2.0f, 2.0f);
+
+            std::shared_ptr<SpriteComponent> sprite =
+                    SpriteComponent::createSpriteComponent(pos, rot, scl, textures[rand() % 4]).unwrap();
+            worldManager.addObject(sprite);
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<Texture>> textures;
+};
+
+int main() {
+    RecordingBenchmark benchmark;
+    WorldManager &worldManager = WorldManager::getManager();
+
+    if (benchmark.startup().hasError()) {
+        std::cout << "ERROR: Failed to startup Benchmark..." << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<Renderer> renderer = worldManager.getRenderer().unwrap();
+    benchmark.begin();
+    renderer->load();
+
+    std::cout << "Resident Staging After Load: " << renderer->getTransferScheduler()->getStagingSize() << " bytes"
+              << std::endl;
+    std::cout << "Recording " << BENCHMARK_SPRITES << " sprites over " << BENCHMARK_FRAMES << " frames on "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    real64 baseline = 0.0;
+    for (uint32 jobs : { 1u, 2u, 4u, 8u }) {
+        std::chrono::duration<real64, std::milli> recordTime(0.0);
+        renderer->setRecordJobs(jobs);
+
+        for (uint32 frame = 0; frame < BENCHMARK_WARMUP_FRAMES + BENCHMARK_FRAMES; ++frame) {
+            renderer->begin();
+
+            // Time Only Instance Writes And Command Recording
+            auto recordStart = std::chrono::high_resolution_clock::now();
+            Result<void> drawResult = renderer->draw();
+            if (frame >= BENCHMARK_WARMUP_FRAMES) {
+                recordTime += std::chrono::high_resolution_clock::now() - recordStart;
+            }
+
+            renderer->end();
+
+            if (drawResult.hasError()) {
+                std::cout << "ERROR: Failed to draw Benchmark frame..." << std::endl;
+                benchmark.shutdown();
+                return 1;
+            }
+        }
+
+        real64 average = recordTime.count() / BENCHMARK_FRAMES;
+        if (jobs == 1) {
+            baseline = average;
+        }
+
+        std::cout << renderer->getRecordJobs() << " job(s): " << average << " ms/frame, speedup "
+                  << baseline / average << "x" << std::endl;
+    }
+
+    // Sprites Created After Load Must Grow Instance Buffer, Never Be Dropped
+    uint32 capacity = renderer->getInstanceCapacity();
+    benchmark.createSprites(BENCHMARK_LATE_SPRITES);
+
+    uint32 expected = worldManager.getSpriteStorage().unwrap()->getSize();
+    for (uint32 frame = 0; frame < 2; ++frame) {
+        renderer->begin();
+        Result<void> drawResult = renderer->draw();
+        renderer->end();
+
+        if (drawResult.hasError() || renderer->getRecordedInstanceCount() != expected) {
+            std::cout << "ERROR: Recorded " << renderer->getRecordedInstanceCount() << " of " << expected
+                      << " sprites after creating sprites past load..." << std::endl;
+            benchmark.shutdown();
+            return 1;
+        }
+    }
+
+    std::cout << "Late Sprites: " << expected << " recorded, instance capacity " << capacity << " -> "
+              << renderer->getInstanceCapacity() << std::endl;
+
+    // Staging Is Reclaimed Once Transfer Fences Signal
+    std::cout << "Resident Staging After Frames: " << renderer->getTransferScheduler()->getStagingSize() << " bytes"
+              << std::endl;
+
+    // Snapshot Allocator Usage To Size Blocks And Pools
+    if (MemoryManager::getManager().dumpStats("RecordingBenchmarkMemory.json").hasError()) {
+        std::cout << "WARNING: Failed to dump memory statistics..." << std::endl;
+    }
+
+    // Small Buffers And Textures Land In Pools, Everything Else In Shared Blocks
+    uint64 pooledAllocations = 0, pooledBlocks = 0, blockAllocations = 0, blocks = 0;
+    for (auto &alloc : MemoryManager::getManager().getStats().allocators) {
+        if (std::string(alloc.kind) == "pool") {
+            pooledAllocations += alloc.allocationCount;
+            pooledBlocks += alloc.blockCount;
+        }
+        else if (std::string(alloc.kind) == "tlsf") {
+            blockAllocations += alloc.allocationCount;
+            blocks += alloc.blockCount;
+        }
+    }
+
+    std::cout << "Pooled Resources: " << pooledAllocations << " in " << pooledBlocks << " blocks, Block Resources: "
+              << blockAllocations << " in " << blocks << " blocks" << std::endl;
+
+    benchmark.shutdown();
+    return EXIT_SUCCESS;
+}
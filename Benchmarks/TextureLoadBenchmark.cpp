@@ -0,0 +1,156 @@
+/**
+ * TextureLoadBenchmark.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Game.h"
+#include "Renderer.h"
+#include "SpriteComponent.h"
+#include "Texture.h"
+#include "TextureCache.h"
+#include "TextureFile.h"
+#include "TransferScheduler.h"
+#include "WorldManager.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vulkan/vulkan.h>
+
+const uint32 BENCHMARK_ROUNDS = 20;
+
+class TextureLoadBenchmark : public Game {
+public:
+    void begin() override {
+
+    }
+
+    void update() override {
+
+    }
+};
+
+/**
+ * Carrega cada arquivo uma vez e aguarda até que seus pixels estejam no dispositivo. Caso bCached seja verdadeiro, os
+ * arquivos são pedidos ao TextureCache, como em um nível recarregado, e as texturas da rodada anterior são reusadas.
+ *
+ */
+static real64 loadTextures(const std::vector<std::string> &filenames,
+                           const std::shared_ptr<Renderer> &renderer,
+                           bool bCached = false) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::shared_ptr<Texture>> textures;
+
+    for (auto &filename : filenames) {
+        std::shared_ptr<Texture> texture = bCached ? renderer->getTextureCache()->acquire(filename).unwrap() :
+                                                     Texture::createTextureFromFile(filename.c_str()).unwrap();
+
+        texture->load();
+        textures.push_back(std::move(texture));
+    }
+
+    for (auto &texture : textures) {
+        renderer->getTransferScheduler()->wait(texture->getTransferTicket());
+    }
+
+    std::chrono::duration<real64, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+/* Desenha count quadros, o suficiente para que os quadros em execução terminem e o TextureCache seja atualizado. */
+static void drawFrames(const std::shared_ptr<Renderer> &renderer, uint32 count) {
+    for (uint32 frame = 0; frame < count; ++frame) {
+        renderer->begin();
+        renderer->draw();
+        renderer->end();
+    }
+}
+
+int main() {
+    TextureLoadBenchmark benchmark;
+    WorldManager &worldManager = WorldManager::getManager();
+    std::vector<std::string> images = { "blue.png", "gohan.png", "goku.png", "vegeta.png" };
+    std::vector<std::string> cooked;
+
+    if (benchmark.startup().hasError()) {
+        std::cout << "ERROR: Failed to startup Benchmark..." << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<Renderer> renderer = worldManager.getRenderer().unwrap();
+
+    // Cook Sprites Once, As The Offline Step Would
+    for (auto &image : images) {
+        std::string filename = image.substr(0, image.find_last_of('.')) + TEXTURE_FILE_EXTENSION;
+
+        if (cookTexture(Texture::loadImage(image.c_str()).unwrap(), filename.c_str()).hasError()) {
+            std::cout << "ERROR: Failed to cook " << image << "..." << std::endl;
+            return 1;
+        }
+
+        cooked.push_back(filename);
+    }
+
+    std::cout << "Loading " << images.size() << " textures over " << BENCHMARK_ROUNDS << " rounds" << std::endl;
+
+    // Warm File Cache For Both Paths
+    loadTextures(images, renderer);
+    loadTextures(cooked, renderer);
+    loadTextures(images, renderer, true);
+
+    real64 decoded = 0.0;
+    real64 mapped = 0.0;
+    real64 cached = 0.0;
+    for (uint32 round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        decoded += loadTextures(images, renderer);
+        mapped += loadTextures(cooked, renderer);
+        cached += loadTextures(images, renderer, true);
+    }
+
+    decoded /= BENCHMARK_ROUNDS;
+    mapped /= BENCHMARK_ROUNDS;
+    cached /= BENCHMARK_ROUNDS;
+
+    std::cout << "FreeImage Decode: " << decoded << " ms/round" << std::endl;
+    std::cout << "Mapped " << TEXTURE_FILE_EXTENSION << " (With Mips): " << mapped << " ms/round, speedup "
+              << decoded / mapped << "x" << std::endl;
+    std::cout << "Texture Cache Reload: " << cached << " ms/round, speedup " << decoded / cached << "x ("
+              << renderer->getTextureCache()->getHitCount() << " hits, "
+              << renderer->getTextureCache()->getMissCount() << " misses)" << std::endl;
+
+    // Textures Of Destroyed Sprites Must Return To The Cache And Become Evictable
+    std::shared_ptr<TextureCache> cache = renderer->getTextureCache();
+    std::vector<std::shared_ptr<SpriteComponent>> sprites;
+    for (auto &image : images) {
+        sprites.push_back(SpriteComponent::createSpriteComponent(glm::vec2(0.0f, 0.0f),
+                                                                 glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                                                                 glm::vec2(1.0f, 1.0f),
+                                                                 cache->acquire(image).unwrap()).unwrap());
+    }
+
+    uint64 referencedSize = cache->getUnreferencedSize();
+    uint32 entryCount = cache->getEntryCount();
+    sprites.clear();
+
+    drawFrames(renderer, MAX_FRAMES_IN_FLIGHT);
+    uint64 releasedSize = cache->getUnreferencedSize();
+
+    cache->setBudget(0);
+    drawFrames(renderer, MAX_FRAMES_IN_FLIGHT + 1);
+
+    if (releasedSize <= referencedSize || cache->getEntryCount() >= entryCount) {
+        std::cout << "ERROR: Textures of destroyed sprites were not released (" << referencedSize << " -> "
+                  << releasedSize << " unreferenced bytes, " << entryCount << " -> " << cache->getEntryCount()
+                  << " entries)..." << std::endl;
+        benchmark.shutdown();
+        return 1;
+    }
+
+    std::cout << "Destroyed Sprites: " << releasedSize - referencedSize << " bytes released, " << entryCount
+              << " -> " << cache->getEntryCount() << " cache entries" << std::endl;
+
+    benchmark.shutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/**
+ * TransformBenchmark.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "SpriteComponent.h"
+#include "SpriteTransform.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+const uint32 BENCHMARK_SIZES[] = { 10000, 100000, 1000000 };
+const uint32 BENCHMARK_ITERATIONS = 50;
+
+template<typename Function>
+static real64 measure(Function function) {
+    // Warm Caches Before Timing
+    function();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32 i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        function();
+    }
+
+    std::chrono::duration<real64, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / BENCHMARK_ITERATIONS;
+}
+
+int main() {
+    std::cout << "Transform Kernel: " << getSpriteTransformPath() << std::endl;
+
+    for (uint32 count : BENCHMARK_SIZES) {
+        std::vector<glm::vec2> positions(count);
+        std::vector<float> rotations(count);
+        std::vector<glm::vec2> scales(count);
+        std::vector<glm::mat4> models(count);
+        std::vector<InstanceData> scalarInstances(count);
+        std::vector<InstanceData> instances(count);
+
+        // Generate Sprites
+        for (uint32 i = 0; i < count; i++) {
+            positions[i] = glm::vec2(rand()%25600/100.0f-rand()%25600/100.0f,
+                                     rand()%25600/100.0f-rand()%25600/100.0f);
+            rotations[i] = glm::radians(rand()%72000/100.0f-360.0f);
+            scales[i] = glm::vec2(rand()%400/100.0f+0.5f, rand()%400/100.0f+0.5f);
+        }
+
+        // Previous Path, Three Matrices Per Sprite
+        real64 glmTime = measure([&] {
+            for (uint32 i = 0; i < count; i++) {
+                glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(positions[i].x, positions[i].y, 0.0f));
+                glm::mat4 rotate = glm::mat4_cast(glm::angleAxis(rotations[i], glm::vec3(0.0f, 0.0f, 1.0f)));
+                glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(scales[i].x, scales[i].y, 1.0f));
+
+                models[i] = translate * rotate * scale;
+            }
+        });
+
+        real64 scalarTime = measure([&] {
+            buildSpriteTransformsScalar(positions.data(), rotations.data(), scales.data(), count,
+                                        scalarInstances.data());
+        });
+
+        real64 kernelTime = measure([&] {
+            buildSpriteTransforms(positions.data(), rotations.data(), scales.data(), count, instances.data());
+        });
+
+        // Compare Kernel Against Scalar Reference
+        float maxError = 0.0f;
+        for (uint32 i = 0; i < count; i++) {
+            for (int32 j = 0; j < 4; j++) {
+                maxError = std::max(maxError, std::abs(instances[i].basis[j] - scalarInstances[i].basis[j]));
+            }
+        }
+
+        std::cout << count << " Sprites: glm " << glmTime << " ms, scalar " << scalarTime << " ms, "
+                  << getSpriteTransformPath() << " " << kernelTime << " ms (" << glmTime / kernelTime
+                  << "x over glm), max error " << maxError << std::endl;
+    }
+
+    return 0;
+}
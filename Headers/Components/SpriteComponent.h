@@ -9,13 +9,29 @@
 #define SPRITECOMPONENT_H_
 
 #include "Result.h"
+#include "SpriteStorage.h"
 
 struct Transform {
-    glm::mat4 model;
     glm::mat4 view;
     glm::mat4 proj;
 };
 
+struct InstanceData {
+    glm::vec4 basis;
+
+    glm::vec2 translation;
+
+    uint32 textureIndex;
+
+    uint32 padding;
+
+    glm::vec4 uvRect;
+
+    static struct VkVertexInputBindingDescription getBindingDescription() noexcept;
+
+    static std::vector<struct VkVertexInputAttributeDescription> getAttributeDescription() noexcept;
+};
+
 struct Vertex {
     glm::vec3 position;
     glm::vec3 color;
@@ -28,33 +44,23 @@ struct Vertex {
 
 class SpriteComponent {
 private:
-    glm::vec2 position;
-
-    glm::quat rotation;
+    std::shared_ptr<class SpriteStorage> storage;
 
-    glm::vec2 scale;
-
-    std::shared_ptr<class Buffer> vertexBuffer;
-
-    std::shared_ptr<class Texture> texture;
+    SpriteHandle handle;
 
 private:
     explicit SpriteComponent();
 
-    std::vector<Vertex> getVertexData() const noexcept;
-
-    Result<void> setupVertexBuffer();
-
 public:
     virtual ~SpriteComponent();
 
+    inline SpriteHandle getHandle() const noexcept { return this->handle; }
+
     glm::mat4 getModelTransform() const noexcept;
 
     std::shared_ptr<class Texture> getTexture() const noexcept;
 
-    std::shared_ptr<class Buffer> getVertexBuffer() const noexcept;
-
-    Result<void> load();
+    glm::vec4 getUvRect() const noexcept;
 
     virtual void begin();
 
@@ -75,6 +81,12 @@ public:
                                                                           glm::vec2 sc,
                                                                           std::shared_ptr<class Texture> txt);
 
+    /* Cria um sprite que amostra somente a região de uma página de um TextureAtlas. */
+    static Result<std::shared_ptr<SpriteComponent>> createSpriteComponent(glm::vec2 pos,
+                                                                          glm::quat rot,
+                                                                          glm::vec2 sc,
+                                                                          const struct AtlasRegion &region);
+
 public:
     SpriteComponent(const SpriteComponent &) = delete;
     SpriteComponent(SpriteComponent &&) = delete;
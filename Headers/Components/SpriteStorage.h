@@ -0,0 +1,159 @@
+/**
+ * SpriteStorage.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef SPRITESTORAGE_H_
+#define SPRITESTORAGE_H_
+
+#include "Result.h"
+
+#include <unordered_map>
+
+/* A máscara que marca um sprite como modificado para todos os frames em andamento. */
+const uint8 SPRITE_DIRTY_ALL_FRAMES = 0xFF;
+
+/* O retângulo de coordenadas de textura que cobre a textura inteira, com o offset em xy e a escala em zw. */
+const glm::vec4 FULL_UV_RECT = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+
+struct SpriteHandle {
+    uint32 index;
+
+    uint32 generation;
+};
+
+/**
+ * A classe SpriteStorage guarda os dados de todos os sprites em vetores contíguos, um para cada atributo, de forma
+ * que as passagens por frame (atualização e construção de transformações) percorram a memória linearmente. Os sprites
+ * são referenciados por SpriteHandle, que permanece válido mesmo quando outros sprites são removidos e os dados são
+ * compactados.
+ *
+ * Cada sprite possui uma máscara de modificação com um bit por frame em andamento. Os métodos que alteram um sprite
+ * devem invocar markDirty, de forma que o Renderer reescreva somente os sprites modificados.
+ *
+ * As texturas são mantidas somente enquanto algum sprite as utiliza. Ao serem descartadas, elas passam ao Renderer
+ * através de takeRetiredTextures, que as mantém vivas até que nenhum quadro em execução possa amostrá-las, permitindo
+ * que o TextureCache as trate como texturas sem referências.
+ *
+ * Os métodos createSprite e destroySprite não são seguros para uso concorrente, enquanto os acessos a sprites
+ * distintos podem ser feitos a partir de várias threads.
+ *
+ */
+class SpriteStorage final {
+private:
+    std::vector<uint32> sparse;
+
+    std::vector<uint32> generations;
+
+    std::vector<uint32> freeSlots;
+
+    std::vector<uint32> owners;
+
+    std::vector<glm::vec2> positions;
+
+    /* Os ângulos de rotação em torno do eixo Z, em radianos. */
+    std::vector<float> rotations;
+
+    std::vector<glm::vec2> scales;
+
+    std::vector<uint32> textureIds;
+
+    /* A região da textura amostrada por cada sprite, diferente de FULL_UV_RECT em sprites de um TextureAtlas. */
+    std::vector<glm::vec4> uvRects;
+
+    /* Um bit por frame em andamento, indicando que a cópia do sprite naquele frame está desatualizada. */
+    std::vector<uint8> dirtyMasks;
+
+    std::vector<std::shared_ptr<class Texture>> textures;
+
+    /* O número de sprites que utilizam cada textura, de forma que ela seja descartada junto de seu último sprite. */
+    std::vector<uint32> textureReferences;
+
+    std::unordered_map<class Texture *, uint32> textureLookup;
+
+    /* As texturas descartadas que o Renderer ainda não recolheu, pois quadros em execução podem amostrá-las. */
+    std::vector<std::shared_ptr<class Texture>> retiredTextures;
+
+    uint64 layoutVersion;
+
+    /* Incrementada sempre que uma textura é descartada e outra passa a ocupar seu identificador. */
+    uint64 textureVersion;
+
+private:
+    explicit SpriteStorage();
+
+    uint32 registerTexture(std::shared_ptr<class Texture> texture);
+
+    /**
+     * Devolve a referência de um sprite à textura id. Quando ela não possui mais sprites, a última textura assume o
+     * identificador id, de forma que os identificadores permaneçam contíguos, e os sprites que a utilizam são
+     * marcados como modificados. A textura descartada é guardada em retiredTextures.
+     *
+     */
+    void releaseTexture(uint32 id);
+
+public:
+    ~SpriteStorage();
+
+    static Result<std::shared_ptr<SpriteStorage>> createSpriteStorage();
+
+    Result<SpriteHandle> createSprite(glm::vec2 pos,
+                                      glm::quat rot,
+                                      glm::vec2 sc,
+                                      std::shared_ptr<class Texture> txt,
+                                      glm::vec4 uvRect = FULL_UV_RECT);
+
+    void destroySprite(SpriteHandle handle);
+
+    bool isValid(SpriteHandle handle) const noexcept;
+
+    glm::mat4 getModelTransform(uint32 index) const noexcept;
+
+    /**
+     * O método sortByTexture reordena os vetores de forma que os sprites de uma mesma textura fiquem contíguos, na
+     * ordem dos identificadores de textura, preservando a validade dos SpriteHandle.
+     *
+     */
+    void sortByTexture();
+
+    inline uint32 getIndex(SpriteHandle handle) const noexcept { return this->sparse[handle.index]; }
+
+    inline void markDirty(uint32 index) noexcept { this->dirtyMasks[index] = SPRITE_DIRTY_ALL_FRAMES; }
+
+    /* Marca todos os sprites como modificados, como quando as cópias de todos os frames deixam de existir. */
+    void markAllDirty() noexcept;
+
+    inline uint8 *getDirtyMasks() noexcept { return this->dirtyMasks.data(); }
+
+    inline uint64 getLayoutVersion() const noexcept { return this->layoutVersion; }
+
+    inline uint64 getTextureVersion() const noexcept { return this->textureVersion; }
+
+    /* Transfere ao chamador as texturas descartadas desde a última chamada. */
+    std::vector<std::shared_ptr<class Texture>> takeRetiredTextures() noexcept;
+
+    inline uint32 getSize() const noexcept { return static_cast<uint32>(this->owners.size()); }
+
+    inline glm::vec2 *getPositions() noexcept { return this->positions.data(); }
+
+    inline float *getRotations() noexcept { return this->rotations.data(); }
+
+    inline glm::vec2 *getScales() noexcept { return this->scales.data(); }
+
+    inline const uint32 *getTextureIds() const noexcept { return this->textureIds.data(); }
+
+    inline const glm::vec4 *getUvRects() const noexcept { return this->uvRects.data(); }
+
+    inline const std::vector<std::shared_ptr<class Texture>> &getTextures() const noexcept { return this->textures; }
+
+public:
+    SpriteStorage(const SpriteStorage &) = delete;
+    SpriteStorage(SpriteStorage &&) = delete;
+
+    SpriteStorage &operator=(const SpriteStorage &) = delete;
+    SpriteStorage &operator=(SpriteStorage &&) = delete;
+};
+
+#endif /* SPRITESTORAGE_H_ */
@@ -0,0 +1,37 @@
+/**
+ * SpriteTransform.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef SPRITETRANSFORM_H_
+#define SPRITETRANSFORM_H_
+
+#include "Result.h"
+
+/**
+ * As funções buildSpriteTransforms constroem, para count sprites, a transformação afim 2D (translação, rotação em
+ * torno do eixo Z e escala) a partir dos vetores de posições, ângulos em radianos e escalas, escrevendo os atributos
+ * basis e translation de cada InstanceData de instances. Os atributos textureIndex e uvRect não são modificados.
+ *
+ * A versão padrão utiliza instruções AVX2 quando a engine é compilada com REALENGINE_ENABLE_AVX2, SSE2 nas demais
+ * plataformas x86 e recai para a versão escalar nas outras arquiteturas.
+ *
+ */
+void buildSpriteTransforms(const glm::vec2 *positions,
+                           const float *rotations,
+                           const glm::vec2 *scales,
+                           uint32 count,
+                           struct InstanceData *instances) noexcept;
+
+void buildSpriteTransformsScalar(const glm::vec2 *positions,
+                                 const float *rotations,
+                                 const glm::vec2 *scales,
+                                 uint32 count,
+                                 struct InstanceData *instances) noexcept;
+
+/* Retorna o nome do conjunto de instruções utilizado por buildSpriteTransforms. */
+const char *getSpriteTransformPath() noexcept;
+
+#endif /* SPRITETRANSFORM_H_ */
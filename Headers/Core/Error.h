@@ -49,6 +49,8 @@ enum class Error : uint16 {
     FailedToInitializeGLFW,
     FailedToPresentImage,
     FailedToMapMemory,
+    FailedToFlushMemory,
+    FailedToInvalidateMemory,
     FailedToRetrieveBuffer,
     FailedToRetrieveImage,
     FailedToRetrieveQueue,
@@ -56,6 +58,7 @@ enum class Error : uint16 {
     FailedToOpenShaderFile,
     FailedToLoadImage,
     FailedToLockPointer,
+    TooManyTextures,
     IndexOutOfRange,
     InstanceNotStartedUp,
     DeviceNotStartedUp,
@@ -68,7 +71,16 @@ enum class Error : uint16 {
     FailedRetrievingPhysicalDevices,
     NoMemoryAvailableInAllocator,
     SubmitParametersNotMatching,
-    UnknownImageFormat
+    UnknownImageFormat,
+    DeviceMemoryBudgetExceeded,
+    NoSuitableMemoryType,
+    FailedToWaitForFence,
+    FailedToOpenStatsFile,
+    TextureAlreadyLoaded,
+    AtlasPageFull,
+    FailedToMapFile,
+    InvalidTextureFile,
+    FailedToWriteTextureFile
 };
 
 #endif /* ERROR_H_ */
@@ -0,0 +1,57 @@
+/**
+ * MappedFile.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include "Result.h"
+
+/**
+ * O MappedFile mapeia um arquivo inteiro, somente para leitura, no espaço de endereçamento do processo. As páginas são
+ * lidas do disco sob demanda pelo sistema operacional, de forma que o conteúdo possa ser copiado diretamente para a
+ * memória de staging sem nenhuma cópia intermediária.
+ *
+ * A classe MappedFile necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class MappedFile final {
+private:
+    void *data;
+
+    uint64 size;
+
+    /* Os handles do arquivo e do mapeamento, mantidos abertos somente no Windows. */
+    void *fileHandle;
+
+    void *mappingHandle;
+
+private:
+    explicit MappedFile();
+
+public:
+    ~MappedFile();
+
+    static Result<std::shared_ptr<MappedFile>> createMappedFile(const utf8 *filename);
+
+    inline const uint8 *getData() const noexcept { return static_cast<const uint8 *>(this->data); }
+
+    inline uint64 getSize() const noexcept { return this->size; }
+
+public:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+};
+
+#endif /* MAPPEDFILE_H_ */
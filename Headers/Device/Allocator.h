@@ -8,8 +8,12 @@
 #ifndef ALLOCATOR_H_
 #define ALLOCATOR_H_
 
+#include "Memory.h"
 #include "Result.h"
 
+#include <atomic>
+#include <chrono>
+
 /**
  * A classe abstrata Allocator tem como objetivo fornecer um conjunto de métodos simples que todos os alocadores
  * precisamter, sejam eles StackAllocators, PoolAllocators ou outros. Através desta interface, outros objetos poderão
@@ -17,34 +21,123 @@
  *
  */
 class Allocator {
+private:
+    /* O instante, em ticks de std::chrono::steady_clock, da última alocação ou liberação efetuada pelo alocador. */
+    std::atomic<int64> lastUseTime;
+
+    /* O número de regiões atualmente distribuídas pelo alocador. */
+    std::atomic<uint64> allocationCount;
+
+    /* O número de regiões distribuídas desde a criação do alocador, incluindo as que já foram liberadas. */
+    std::atomic<uint64> totalAllocationCount;
+
+    /* O maior valor de getUsedSize observado desde a criação do alocador. */
+    std::atomic<uint64> peakUsedSize;
+
 protected:
     /**
      * Um construtor padrão da interface que serve apenas para permitir a criação correta de seus descendentes. Um
      * objeto do tipo Allocator não poderá ser criado devido a virtualidade pura de seus métodos.
      *
      */
-    explicit Allocator() = default;
+    explicit Allocator() : allocationCount(0), totalAllocationCount(0), peakUsedSize(0) { this->markUsed(); }
+
+    /**
+     * O método markUsed deve ser invocado pelos descendentes a cada alocação ou liberação, de forma que o
+     * MemoryManager consiga identificar os alocadores que permanecem ociosos.
+     *
+     */
+    inline void markUsed() noexcept {
+        this->lastUseTime = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    /**
+     * Os métodos markAllocated e markFreed devem ser invocados pelos descendentes após cada alocação e liberação,
+     * já com getUsedSize atualizado, mantendo as estatísticas que o MemoryManager expõe através de getStats.
+     *
+     */
+    inline void markAllocated() noexcept {
+        uint64 used = this->getUsedSize();
+        uint64 peak = this->peakUsedSize.load();
+
+        while (used > peak && !this->peakUsedSize.compare_exchange_weak(peak, used)) {}
+
+        this->allocationCount++;
+        this->totalAllocationCount++;
+        this->markUsed();
+    }
+
+    inline void markFreed(uint64 count = 1) noexcept {
+        this->allocationCount -= count;
+        this->markUsed();
+    }
 
 public:
     /**
      * O método que os alocadores necessitam para que outros objetos possam efetuar requisições de alocações de espaços
      * de memória de vídeo.
      *
-     * A memória é retornada na forma de um unique_ptr de forma a manter garantida a exclusividade do objeto Memory e
-     * de evitar leaks de memória de vídeo.
+     * A memória é retornada como um objeto Memory por valor, de forma que a alocação não exija nenhuma alocação na
+     * CPU. Quem recebe a região passa a ser responsável por devolvê-la através do método free.
      *
      */
-    virtual Result<std::unique_ptr<class Memory>> allocate(uint64 siz) = 0;
+    virtual Result<Memory> allocate(uint64 siz) = 0;
 
     /**
      * O método que os alocadores necessitam para que outros objetos possam liberar alocações de memória de vídeo que
      * haviam feito anteriormente.
      *
-     * A memória é tomada na forma de uma referência de unique_ptr e deverá nulificar esse ponteiro além de retornar o
-     * objeto Memory para a propriedade do alocador.
+     * A memória é tomada na forma de uma referência e será invalidada após retornar a região para a propriedade do
+     * alocador.
+     *
+     */
+    virtual void free(Memory &mem) = 0;
+
+    /**
+     * O método que os alocadores necessitam para que outros objetos possam acessar, a partir da CPU, a memória de
+     * vídeo que eles administram, desde que esta seja visível ao host.
+     *
+     * Como um mesmo VkDeviceMemory não pode ser mapeado mais de uma vez simultaneamente, o alocador mapeia todo o
+     * bloco de memória de onde mem foi distribuída uma única vez e retorna o ponteiro para o início dele, ao qual os
+     * objetos devem somar o offset das regiões que receberam. O mapeamento permanece válido durante toda a vida do
+     * alocador.
+     *
+     */
+    virtual Result<void *> map(const Memory &mem) = 0;
+
+    /**
+     * O método que os alocadores necessitam para informar o tamanho do bloco de memória de vídeo de onde mem foi
+     * distribuída, utilizado para limitar as regiões sincronizadas entre host e dispositivo.
+     *
+     */
+    virtual uint64 getBlockSize(const Memory &mem) noexcept = 0;
+
+    /**
+     * O método que os alocadores necessitam para informar o tamanho total dos blocos de memória de vídeo que
+     * administram, utilizado pelo MemoryManager para contabilizar o uso de cada heap.
      *
      */
-    virtual void free(std::unique_ptr<class Memory> &mem) = 0;
+    virtual uint64 getAllocatorSize() const noexcept = 0;
+
+    /**
+     * O método que os alocadores necessitam para informar quantos bytes do seu bloco estão atualmente distribuídos.
+     * Um alocador cujo uso é zero pode ter seu bloco devolvido ao dispositivo pelo MemoryManager.
+     *
+     */
+    virtual uint64 getUsedSize() const noexcept = 0;
+
+    /* Retorna quantos blocos de memória de vídeo o alocador possui atualmente. */
+    virtual uint32 getBlockCount() noexcept = 0;
+
+    inline uint64 getAllocationCount() const noexcept { return this->allocationCount; }
+
+    inline uint64 getPeakUsedSize() const noexcept { return this->peakUsedSize; }
+
+    inline uint64 getTotalAllocationCount() const noexcept { return this->totalAllocationCount; }
+
+    inline std::chrono::steady_clock::time_point getLastUseTime() const noexcept {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(this->lastUseTime.load()));
+    }
 
 public:
     Allocator(const Allocator &) = delete;
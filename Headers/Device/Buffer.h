@@ -8,6 +8,7 @@
 #ifndef BUFFER_H_
 #define BUFFER_H_
 
+#include "Memory.h"
 #include "Result.h"
 
 /**
@@ -47,10 +48,25 @@ protected:
     /* O atributo que contém o uso para o qual este Buffer é destinado. */
     uint32 usage;
 
-    std::shared_ptr<class PoolAllocator> allocator;
+    /* O atributo que guarda as propriedades de memória requisitadas para este Buffer durante sua criação. */
+    uint32 requiredFlags;
 
-    /* O atributo que guarda o unique_ptr da memória de vídeo associada à este Buffer. */
-    std::unique_ptr<class Memory> memory;
+    /* O atributo que guarda as propriedades de memória desejáveis, porém opcionais, para este Buffer. Caso nenhum
+     * tipo de memória as possua junto de requiredFlags, o Buffer é alocado apenas com requiredFlags. */
+    uint32 preferredFlags;
+
+    /* O atributo que guarda as propriedades do tipo de memória efetivamente escolhido para este Buffer, utilizado
+     * para decidir se as escritas e leituras da CPU precisam ser sincronizadas explicitamente. */
+    uint32 memoryFlags;
+
+    /* O atributo que armazena o ponteiro persistente para a região de memória deste Buffer, obtido na primeira
+     * chamada ao método map. */
+    uint8 *mapping;
+
+    std::shared_ptr<class Allocator> allocator;
+
+    /* O atributo que guarda a região da memória de vídeo associada à este Buffer. */
+    Memory memory;
 
     /* O atributo que lista as múltiplas filas de processamento que poderão utilizar este Buffer,
      * se ele for compartilhado. */
@@ -84,6 +100,24 @@ protected:
      */
     struct VkBufferCreateInfo getBufferCreateInfo() const noexcept;
 
+    /**
+     * O método auxiliar getMappedMemoryRange tem como função criar e preencher a estrutura VkMappedMemoryRange que
+     * descreve uma região deste Buffer, alinhada ao nonCoherentAtomSize do dispositivo físico, para as operações de
+     * flush e invalidate.
+     *
+     */
+    struct VkMappedMemoryRange getMappedMemoryRange(uint64 off, uint64 siz) const noexcept;
+
+    /**
+     * O método auxiliar createExclusiveBuffer concentra a criação de Buffers exclusivos para as sobrecargas de
+     * createBuffer, recebendo as propriedades de memória obrigatórias e as desejáveis.
+     *
+     */
+    static Result<std::shared_ptr<Buffer>> createExclusiveBuffer(uint64 siz,
+                                                                 uint32 usg,
+                                                                 uint32 requiredFlags,
+                                                                 uint32 preferredFlags);
+
     /**
      * O método auxiliar getGraphicsDevice tem como objetivo adquirir o dispositivo lógico da aplicação através
      * da API Vulkan.
@@ -98,6 +132,15 @@ protected:
      */
     Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
 
+    Result<std::shared_ptr<class Renderer>> getRenderer() const noexcept;
+
+    /**
+     * O método auxiliar stageBuffer preenche um Buffer que não é visível à CPU, escrevendo os dados no buffer circular
+     * de staging do TransferScheduler e aguardando somente o lote que contém a cópia para este Buffer.
+     *
+     */
+    Result<void> stageBuffer(uint64 siz, const void *data);
+
 public:
     /**
      * O destrutor padrão de Buffer, cujo objetivo é retornar a memória associada para o alocador que a
@@ -120,6 +163,23 @@ public:
      */
     static Result<std::shared_ptr<Buffer>> createBuffer(uint64 siz, uint32 usg);
 
+    /**
+     * Esta sobrecarga do método createBuffer permite escolher as propriedades da memória de vídeo que sustentará o
+     * Buffer. A versão sem este parâmetro utiliza memória HOST_VISIBLE e HOST_COHERENT, equivalente a
+     * MemoryUsage::Upload, enquanto esta permite, por exemplo, requisitar apenas HOST_VISIBLE e utilizar heaps não
+     * coerentes (geralmente com cache na CPU), desde que as escritas sejam publicadas através do método flushRange.
+     *
+     */
+    static Result<std::shared_ptr<Buffer>> createBuffer(uint64 siz, uint32 usg, uint32 flags);
+
+    /**
+     * Esta sobrecarga do método createBuffer escolhe a memória de vídeo a partir da intenção de uso do Buffer. Buffers
+     * MemoryUsage::GpuOnly são alocados em heaps DEVICE_LOCAL e recebem automaticamente o uso TRANSFER_DST, de forma
+     * que o método fillBuffer possa preenchê-los através de staging.
+     *
+     */
+    static Result<std::shared_ptr<Buffer>> createBuffer(uint64 siz, uint32 usg, MemoryUsage memoryUsage);
+
     /**
      * O método createShaderBuffer é o que permite a criação de objetos do tipo Buffer que sejam concorrentes,
      * ou seja, que precisam ser compartilhados entre múltiplas filas de processamento gráfico e, portanto,
@@ -135,7 +195,45 @@ public:
                                                               uint32 usg,
                                                               std::vector<std::weak_ptr<class Queue>> &queues);
 
-    Result<void> fillBuffer(uint64 size, void *data);
+    /**
+     * O método fillBuffer copia size bytes de data para o início do Buffer. Buffers visíveis à CPU são escritos
+     * diretamente através do mapeamento, enquanto os demais são preenchidos através de um Buffer de staging.
+     *
+     */
+    Result<void> fillBuffer(uint64 size, const void *data);
+
+    /**
+     * O método map tem como objetivo retornar um ponteiro para a região de memória de vídeo associada a este Buffer
+     * no espaço de endereçamento da CPU, através do qual os dados podem ser escritos ou lidos diretamente.
+     *
+     * O mapeamento é realizado apenas na primeira chamada e o ponteiro é armazenado, permanecendo válido durante
+     * toda a vida do Buffer. Desta forma, uploads contínuos não pagam o custo de mapear e desmapear a memória a
+     * cada escrita.
+     *
+     */
+    Result<void *> map();
+
+    /**
+     * O método flushRange torna visíveis ao dispositivo as escritas feitas pela CPU na região [off, off + siz) do
+     * Buffer. Em memórias HOST_COHERENT o método não realiza nenhuma operação.
+     *
+     */
+    Result<void> flushRange(uint64 off, uint64 siz);
+
+    /**
+     * O método invalidateRange torna visíveis à CPU as escritas feitas pelo dispositivo na região [off, off + siz)
+     * do Buffer, devendo ser chamado antes da leitura. Em memórias HOST_COHERENT o método não realiza nenhuma
+     * operação.
+     *
+     */
+    Result<void> invalidateRange(uint64 off, uint64 siz);
+
+    /**
+     * O método isCoherent informa se a memória escolhida para este Buffer é HOST_COHERENT, caso em que as
+     * operações de flush e invalidate são desnecessárias.
+     *
+     */
+    bool isCoherent() const noexcept;
 
     /**
      * Este método tem como objetivo permitir a obtenção da handle ao objeto do tipo VkBuffer para que outros
@@ -149,6 +247,19 @@ public:
 
     Result<struct VkDeviceMemory_T *> getVulkanMemory() const noexcept;
 
+    inline const std::shared_ptr<class Allocator> &getAllocator() const noexcept { return this->allocator; }
+
+    /**
+     * O método relocate move o conteúdo deste Buffer para uma região de um bloco de memória de vídeo mais ocupado
+     * que source, gravando a cópia em cmdBuffer. Como a memória de um VkBuffer não pode ser trocada, um novo VkBuffer
+     * é criado e a handle e a região anteriores são entregues em retired, para serem destruídas quando nenhum quadro
+     * em execução ainda as utilize. O método retorna quantos bytes foram copiados.
+     *
+     */
+    Result<uint64> relocate(struct VkCommandBuffer_T *cmdBuffer,
+                            const class TlsfAllocator &source,
+                            struct RetiredResource &retired);
+
 public:
     Buffer(const Buffer &) = delete;
     Buffer(Buffer &&) = delete;
@@ -0,0 +1,132 @@
+/**
+ * Defragmenter.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef DEFRAGMENTER_H_
+#define DEFRAGMENTER_H_
+
+#include "Memory.h"
+#include "Result.h"
+
+#include <deque>
+
+/* O tempo máximo, em milissegundos, que o Defragmenter pode consumir da CPU em cada quadro. */
+const real64 DEFAULT_DEFRAGMENTATION_BUDGET = 0.5;
+
+/* O número máximo de bytes que o Defragmenter pode copiar na GPU em cada quadro. */
+const uint64 DEFAULT_DEFRAGMENTATION_BYTES = 16ull * 1024 * 1024;
+
+/* A fração de uso abaixo da qual um bloco de memória de vídeo é esvaziado pelo Defragmenter. */
+const real64 DEFAULT_DEFRAGMENTATION_THRESHOLD = 0.25;
+
+/**
+ * A estrutura RetiredResource guarda os handles e a região de memória que um Buffer ou Image abandonou ao ser movido,
+ * que só podem ser destruídos quando nenhum quadro em execução na GPU ainda os utilize.
+ *
+ */
+struct RetiredResource {
+    struct VkBuffer_T *buffer;
+
+    struct VkImage_T *image;
+
+    struct VkImageView_T *view;
+
+    std::shared_ptr<class Allocator> allocator;
+
+    Memory memory;
+
+    uint64 frame;
+};
+
+/**
+ * O Defragmenter compacta incrementalmente a memória de vídeo de sessões longas. A cada quadro, ele escolhe o bloco de
+ * memória mais esparso do MemoryManager e move os Buffers e Images que ainda vivem nele para blocos mais ocupados,
+ * gravando as cópias no command buffer do quadro. Uma vez vazio, o bloco é eliminado pelo MemoryManager como qualquer
+ * outro alocador ocioso.
+ *
+ * Como o Vulkan não permite trocar a memória de um recurso já ligado, cada movimentação cria um novo handle e os
+ * handles antigos são destruídos somente após framesInFlight quadros. O trabalho de cada quadro é limitado tanto pelo
+ * tempo de CPU quanto pela quantidade de bytes copiados, de forma que a compactação nunca cause um travamento.
+ *
+ * Somente os blocos TLSF são compactados. Os recursos pequenos que vivem nos PoolAllocators nunca são movidos, de forma
+ * que a memória de um pool só é devolvida quando o pool inteiro fica ocioso e é eliminado pelo MemoryManager.
+ *
+ */
+class Defragmenter final {
+private:
+    std::vector<std::weak_ptr<class Buffer>> buffers;
+
+    std::vector<std::weak_ptr<class Image>> images;
+
+    /* O bloco sendo esvaziado no momento, ou nullptr enquanto nenhum bloco esparso foi encontrado. */
+    std::shared_ptr<class TlsfAllocator> source;
+
+    /* O último bloco que não pôde ser esvaziado, ignorado na próxima busca por blocos esparsos. */
+    const class TlsfAllocator *skipped;
+
+    std::deque<RetiredResource> retired;
+
+    /* Indica que todos os recursos conhecidos deixaram source e que o bloco aguarda ser liberado. */
+    bool draining;
+
+    real64 budget;
+
+    uint64 budgetBytes;
+
+    real64 threshold;
+
+    uint64 frame;
+
+    uint32 framesInFlight;
+
+    /* O contador incrementado sempre que algum recurso muda de handle, para que os descritores sejam reescritos. */
+    uint64 version;
+
+private:
+    explicit Defragmenter();
+
+    Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
+
+    void releaseRetired(bool bAll);
+
+    void stopEvacuation();
+
+public:
+    ~Defragmenter();
+
+    static Result<std::shared_ptr<Defragmenter>> createDefragmenter(uint32 framesInFlight);
+
+    inline uint64 getVersion() const noexcept { return this->version; }
+
+    void registerBuffer(const std::shared_ptr<class Buffer> &buffer);
+
+    void registerImage(const std::shared_ptr<class Image> &image);
+
+    /* Adia a destruição de uma VkImageView que ainda pode estar em uso pelos quadros em execução. */
+    void retireImageView(struct VkImageView_T *view);
+
+    void setBudget(real64 milliseconds, uint64 bytes) noexcept;
+
+    void setThreshold(real64 fraction) noexcept;
+
+    /**
+     * O método step executa uma etapa da compactação, devendo ser invocado uma vez por quadro, depois que a fence do
+     * quadro foi aguardada e antes do início do render pass. Os handles que não estão mais em uso por nenhum quadro
+     * são destruídos e, caso bRelocate seja verdadeiro, as cópias são gravadas em cmdBuffer. O Renderer só permite
+     * movimentações quando nenhum upload está pendente, já que um recurso não pode ser copiado enquanto é escrito.
+     *
+     */
+    void step(struct VkCommandBuffer_T *cmdBuffer, bool bRelocate);
+
+public:
+    Defragmenter(const Defragmenter &) = delete;
+    Defragmenter(Defragmenter &&) = delete;
+
+    Defragmenter &operator=(const Defragmenter &) = delete;
+    Defragmenter &operator=(Defragmenter &&) = delete;
+};
+
+#endif /* DEFRAGMENTER_H_ */
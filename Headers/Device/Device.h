@@ -38,6 +38,11 @@ private:
      * dispositivo lógico. */
     bool bIsDebug = false;
 
+    /* O atributo que informa se o dispositivo físico escolhido suporta a indexação não uniforme de vetores de
+     * texturas nos shaders, através da extensão VK_EXT_descriptor_indexing, e se ela foi ativada no dispositivo
+     * lógico. */
+    bool bDescriptorIndexing = false;
+
     /* O atributo que armazena a handle do dispositivo lógico da API Vulkan. O dispositivo lógico é utilizado para
      * realizar a maior parte das operações, tanto de renderização como de movimentação de dados. */
     struct VkDevice_T *device;
@@ -85,6 +90,18 @@ private:
      */
     bool checkPhysicalDeviceLimits(struct VkPhysicalDevice_T *pd) const noexcept;
 
+    /**
+     * O método auxiliar que verifica se o dispositivo físico especificado suporta a extensão
+     * VK_EXT_descriptor_indexing com a funcionalidade shaderSampledImageArrayNonUniformIndexing, que permite
+     * escolher a textura de um vetor com um índice diferente para cada instância dentro de uma mesma chamada de
+     * desenho.
+     *
+     * Diferentemente dos outros métodos de verificação, esta funcionalidade é opcional e, caso não esteja
+     * disponível, o dispositivo físico continua apto a ser escolhido.
+     *
+     */
+    bool checkPhysicalDeviceDescriptorIndexing(struct VkPhysicalDevice_T *pd) const noexcept;
+
     Result<void> createQueues(
             std::vector<struct VkDeviceQueueCreateInfo> *deviceQueueCreateInfo);
 
@@ -112,9 +129,13 @@ private:
      * são capazes de processamento gráfico e as retorna em um vetor para serem utilizadas na criação do dispositivo
      * lógico, reservando-as para o uso da aplicação.
      *
+     * Caso exista uma família dedicada somente a transferências, uma fila desta família é reservada ao final do
+     * vetor para que os uploads do TransferScheduler executem em paralelo à fila gráfica. As prioridades de cada
+     * família são guardadas separadamente em queuePriorities, que deve permanecer vivo até a criação do dispositivo.
+     *
      */
     std::vector<struct VkDeviceQueueCreateInfo> getDeviceQueueCreateInfo(
-            std::vector<float> *queuePriorities) const noexcept;
+            std::vector<std::vector<float>> *queuePriorities) const noexcept;
 
     /**
      * Um método auxiliar que obtém as propriedades das famílias de filas de processamento gráfico do dispositivo
@@ -191,6 +212,13 @@ public:
      */
     Result<struct VkPhysicalDevice_T *> getVulkanPhysicalDevice() const noexcept;
 
+    /**
+     * Esse método informa se a indexação não uniforme de vetores de texturas foi ativada no dispositivo lógico,
+     * permitindo que os objetos de tipo Renderer desenhem instâncias com texturas diferentes em uma única chamada.
+     *
+     */
+    bool supportsDescriptorIndexing() const noexcept;
+
     /**
      * O método startup tem o propósito de invocar os dois métodos auxiliares selectVulkanPhysicalDevice e
      * createVulkanDevice e verificar se os dois rodaram sem erros.
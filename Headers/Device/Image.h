@@ -8,6 +8,7 @@
 #ifndef IMAGE_H_
 #define IMAGE_H_
 
+#include "Memory.h"
 #include "Result.h"
 
 /**
@@ -74,13 +75,20 @@ protected:
      * deve-se especificar os tamanhos em texels. */
     std::unique_ptr<struct VkExtent3D> extent;
 
-    /* O atributo que guarda o unique_ptr da memória de vídeo associada à este Image. */
-    std::unique_ptr<class Memory> memory;
+    /* O atributo que guarda o alocador de onde a memória de vídeo deste Image foi distribuída. */
+    std::shared_ptr<class Allocator> allocator;
+
+    /* O atributo que guarda a região da memória de vídeo associada à este Image. */
+    Memory memory;
 
     /* O atributo que lista as múltiplas filas de processamento que poderão utilizar este Image,
      * se ele for compartilhado. */
     std::vector<std::weak_ptr<class Queue>> queueList;
 
+    /* O atributo que conta quantas vezes este Image foi movido pelo Defragmenter, permitindo que as
+     * VkImageViews criadas a partir da handle anterior sejam recriadas. */
+    uint32 relocations;
+
 protected:
     /**
      * O construtor padrão e privado de objetos do tipo Image, seu único objetivo é criar um objeto com seus
@@ -194,6 +202,31 @@ public:
      */
     Result<struct VkImage_T *> getVulkanImage() const noexcept;
 
+    inline const std::shared_ptr<class Allocator> &getAllocator() const noexcept { return this->allocator; }
+
+    inline uint32 getLayout() const noexcept { return this->layout; }
+
+    inline uint32 getMipLevels() const noexcept { return this->mipLevels; }
+
+    inline uint32 getRelocationCount() const noexcept { return this->relocations; }
+
+    /**
+     * O método relocate move os texels deste Image para uma região de um bloco de memória de vídeo mais ocupado que
+     * source, gravando a cópia de todos os mipLevels em cmdBuffer. O Image deve estar no layout
+     * SHADER_READ_ONLY_OPTIMAL e ter sido criado com o uso TRANSFER_SRC, voltando ao mesmo layout após a cópia.
+     *
+     * Um novo VkImage é criado e a handle e a região anteriores são entregues em retired, de forma que as
+     * VkImageViews existentes devem ser recriadas. O método retorna quantos bytes foram copiados.
+     *
+     */
+    Result<uint64> relocate(struct VkCommandBuffer_T *cmdBuffer,
+                            const class TlsfAllocator &source,
+                            struct RetiredResource &retired);
+
+    /* Registra o layout resultante de uma transição gravada fora de transitionLayout, como nas transferências de
+     * posse entre famílias de filas. */
+    inline void setLayout(uint32 newLayout) noexcept { this->layout = newLayout; }
+
     void transitionLayout(struct VkCommandBuffer_T *cmdBuffer,
                           uint32 newLayout,
                           uint32 sourceStage,
@@ -0,0 +1,159 @@
+/**
+ * LinearAllocator.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef LINEARALLOCATOR_H_
+#define LINEARALLOCATOR_H_
+
+#include "Allocator.h"
+
+/* O tamanho padrão, em bytes, da região de cada quadro em execução de um LinearAllocator. */
+const uint64 DEFAULT_FRAME_ARENA_SIZE = 4ull * 1024 * 1024;
+
+/* O alinhamento mínimo das regiões distribuídas, suficiente para uniform, storage e vertex buffers. */
+const uint64 LINEAR_MIN_ALIGNMENT = 256;
+
+/**
+ * O LinearAllocator distribui memória de vídeo para dados que vivem por apenas um quadro, como transformações,
+ * geometria de depuração e escritas de staging. Um único bloco, mapeado durante toda a vida do alocador, é dividido
+ * em uma região por quadro em execução e cada alocação é apenas o avanço de um offset dentro da região do quadro
+ * atual, sem nenhuma fragmentação.
+ *
+ * As regiões não são liberadas individualmente: o método free não realiza nenhuma operação e a região inteira de um
+ * quadro é reaproveitada através de beginFrame, que deve ser invocado somente após a fence daquele quadro sinalizar.
+ * Um VkBuffer é ligado ao bloco inteiro, de forma que o offset de cada Memory distribuída é também seu offset dentro
+ * de getVulkanBuffer.
+ *
+ * Os LinearAllocators podem ser manejados somente através de shared_ptr e weak_ptr e devem ser criados através do
+ * MemoryManager. O método allocate pode ser invocado a partir de várias threads, enquanto beginFrame deve partir da
+ * thread que submete os quadros.
+ *
+ * A classe LinearAllocator necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class LinearAllocator final : public Allocator {
+private:
+    /* O alinhamento mínimo das regiões distribuídas, nunca inferior a LINEAR_MIN_ALIGNMENT. */
+    uint64 alignment;
+
+    /* O VkBuffer ligado ao bloco inteiro, através do qual os dados transitórios são lidos pela GPU. */
+    struct VkBuffer_T *buffer;
+
+    /* O atributo que guarda as propriedades requisitadas para a zona de memória alocada. */
+    uint32 flags;
+
+    /* O atributo que guarda o tipo de memória do dispositivo físico em que o bloco está alocado. */
+    uint32 heap;
+
+    /* As propriedades do tipo de memória efetivamente escolhido, usadas para decidir se flush é necessário. */
+    uint32 memoryFlags;
+
+    /* O ponteiro para o início do bloco no espaço de endereçamento da CPU. */
+    void *mapping;
+
+    struct VkDeviceMemory_T *memory;
+
+    /* O tamanho da região de cada quadro, múltiplo de alignment. */
+    uint64 frameSize;
+
+    uint32 frameCount;
+
+    /* O quadro cuja região recebe as alocações atuais. */
+    uint32 frameIndex;
+
+    /* O offset, relativo ao início da região do quadro atual, da próxima alocação. */
+    std::atomic<uint64> head;
+
+    /* O número de alocações feitas na região do quadro atual. */
+    std::atomic<uint64> frameAllocations;
+
+    /* Os bytes e alocações que cada região ainda retém, pois seus quadros podem estar em execução na GPU. */
+    std::vector<uint64> frameHeads;
+
+    std::vector<uint64> frameAllocationCounts;
+
+    /* A soma de frameHeads, exceto a do quadro atual. */
+    std::atomic<uint64> retainedSize;
+
+private:
+    explicit LinearAllocator();
+
+    Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
+
+    struct VkMemoryAllocateInfo getMemoryAllocateInfo(uint64 siz) const noexcept;
+
+public:
+    ~LinearAllocator();
+
+    inline uint64 getAllocatorAlignment() const noexcept { return this->alignment; }
+
+    inline uint32 getAllocatorFlags() const noexcept { return this->flags; }
+
+    inline uint32 getAllocatorHeap() const noexcept { return this->heap; }
+
+    inline uint64 getAllocatorSize() const noexcept override { return this->frameSize * this->frameCount; }
+
+    inline uint32 getBlockCount() noexcept override { return 1; }
+
+    inline uint64 getBlockSize(const Memory &) noexcept override { return this->getAllocatorSize(); }
+
+    inline uint64 getFrameSize() const noexcept { return this->frameSize; }
+
+    inline uint64 getUsedSize() const noexcept override { return this->retainedSize + this->head; }
+
+    /* Retorna o VkBuffer ligado ao bloco inteiro do alocador. */
+    inline struct VkBuffer_T *getVulkanBuffer() const noexcept { return this->buffer; }
+
+    /**
+     * No LinearAllocator, este método apenas avança o offset da região do quadro atual, falhando com
+     * NoMemoryAvailableInAllocator quando a região não comporta mais siz bytes.
+     *
+     */
+    Result<Memory> allocate(uint64 siz) override;
+
+    Result<Memory> allocate(uint64 siz, uint64 align);
+
+    /**
+     * O método beginFrame torna a região de index a região atual e descarta todas as alocações feitas nela, devendo
+     * ser invocado somente após a fence do quadro index ter sinalizado.
+     *
+     */
+    void beginFrame(uint32 index) noexcept;
+
+    /* Torna visíveis ao dispositivo as escritas da região do quadro atual, caso a memória não seja HOST_COHERENT. */
+    Result<void> flush();
+
+    /* As regiões são descartadas somente por beginFrame, portanto este método apenas invalida mem. */
+    void free(Memory &mem) override;
+
+    /* Retorna o início do bloco mapeado, ou um erro caso mem não tenha sido distribuída por este alocador. */
+    Result<void *> map(const Memory &mem) override;
+
+    /**
+     * Este método estático é a forma correta e padrão de efetuar a criação de um objeto do tipo LinearAllocator. Um
+     * bloco de frameCount regiões de frameSize bytes é alocado em um tipo de memória com as propriedades flags,
+     * mapeado e ligado a um VkBuffer com o uso usage.
+     *
+     */
+    static Result<std::shared_ptr<LinearAllocator>> createAllocator(uint64 frameSize,
+                                                                    uint32 frameCount,
+                                                                    uint32 usage,
+                                                                    uint32 flags);
+
+public:
+    LinearAllocator(const LinearAllocator &) = delete;
+    LinearAllocator(LinearAllocator &&) = delete;
+
+    LinearAllocator &operator=(const LinearAllocator &) = delete;
+    LinearAllocator &operator=(LinearAllocator &&) = delete;
+};
+
+#endif /* LINEARALLOCATOR_H_ */
@@ -10,24 +10,38 @@
 
 #include "Result.h"
 
+/**
+ * A enumeração MemoryUsage descreve a intenção de uso de um recurso, a partir da qual são escolhidas as propriedades
+ * da memória de vídeo que o sustentará:
+ *      1. GpuOnly: lida pela GPU a cada quadro e escrita raramente, fica em heaps DEVICE_LOCAL e é preenchida
+ *  através de um Buffer de staging;
+ *      2. Upload: escrita pela CPU e copiada pela GPU, como os Buffers de staging, fica em memória HOST_VISIBLE e
+ *  HOST_COHERENT;
+ *      3. Readback: escrita pela GPU e lida pela CPU, fica em memória HOST_VISIBLE, de preferência HOST_CACHED;
+ *      4. Dynamic: reescrita pela CPU a cada quadro e lida pela GPU, fica em memória HOST_VISIBLE, de preferência
+ *  também DEVICE_LOCAL quando o dispositivo oferecer tal tipo de memória.
+ *
+ */
+enum class MemoryUsage : uint32 {
+    GpuOnly,
+    Upload,
+    Readback,
+    Dynamic
+};
+
 /**
  * A classe Memory cria uma abstração simples sobre o objeto VkDeviceMemory da API Vulkan. A ideia básica desta classe
  * é armazenar a handle para uma área de memória em particular e o offset da memória em questão, visto que várias
  * regiões de memória irão compartilhar o mesmo handle para minimizar o número de alocações.
  *
- * Uma constatação importante é que objetos do tipo Memory podem ser utilizados somente através de unique_ptr, o que
- * garante que cada objeto seja exclusivo e tenha apenas um dono em um determinado momento.
- *
- * A classe Memory necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
- *      1. O construtor padrão que permite a criação de objetos resetados;
- *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
- *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
- *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
- *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ * Objetos do tipo Memory são tipos de valor leves, compostos apenas pela handle, pelo offset e pelo tipo de memória,
+ * e podem ser copiados livremente sem nenhuma alocação na CPU. A posse da região, no entanto, continua sendo de quem
+ * a recebeu do alocador, que deve devolvê-la através do método free exatamente uma vez. Um objeto Memory construído
+ * pelo construtor padrão não representa nenhuma região e é considerado inválido.
  *
  */
-class Memory {
-protected:
+class Memory final {
+private:
     /* A heap do dispositivo físico em que esta região de memória está localizada. */
     uint32 heap;
 
@@ -39,17 +53,15 @@ protected:
      * por este objeto. */
     uint64 offset;
 
-protected:
+public:
     /**
-     * O construtor padrão de objetos Memory, sua única função é dar valores nulos aos atributos da classe. O
-     * construtor é privado de maneira que o objeto pode ser criado apenas através do método estático createMemory que
-     * retorna um unique_ptr, impedindo duplicações deste tipo de objeto.
+     * O construtor padrão de objetos Memory, sua única função é dar valores nulos aos atributos da classe, resultando
+     * em uma região inválida.
      *
      */
-    explicit Memory();
+    Memory() noexcept;
 
-public:
-    virtual ~Memory();
+    Memory(struct VkDeviceMemory_T *mem, uint64 off, uint32 hp) noexcept;
 
     /**
      * Um método cujo objetivo é determinar a heap ideal da memória do dispositivo físico (GPU) na qual deve-se
@@ -64,24 +76,19 @@ public:
     static Result<uint32> chooseHeapFromFlags(const struct VkMemoryRequirements &memoryRequirements,
                                               uint32 requiredFlags) noexcept;
 
-    /**
-     * O método createMemory é a forma padrão de criar objetos do tipo Memory, configurando os atributos conforme os
-     * parâmetros recebidos pelo método e retornando um unique_ptr que impede a replicação do objeto.
-     *
-     */
-    static std::unique_ptr<Memory> createMemory(struct VkDeviceMemory_T *mem,
-                                                uint64 off, uint32 hp) noexcept;
+    /* Retorna as propriedades de memória que um recurso com a intenção de uso usage deve obrigatoriamente possuir. */
+    static uint32 getRequiredFlags(MemoryUsage usage) noexcept;
+
+    /* Retorna as propriedades de memória que um recurso com a intenção de uso usage deve possuir, se possível. */
+    static uint32 getPreferredFlags(MemoryUsage usage) noexcept;
 
     inline struct VkDeviceMemory_T *getMemory() const noexcept { return this->memory; }
 
-    inline uint64 getMemoryOffset() const noexcept { return this->offset; }
+    inline uint32 getMemoryHeap() const noexcept { return this->heap; }
 
-public:
-    Memory(const Memory &) = delete;
-    Memory(Memory &&) = delete;
+    inline uint64 getMemoryOffset() const noexcept { return this->offset; }
 
-    Memory &operator=(const Memory &) = delete;
-    Memory &operator=(Memory &&) = delete;
+    inline bool isValid() const noexcept { return this->memory != nullptr; }
 };
 
 #endif /* MEMORY_H_ */
@@ -10,14 +10,46 @@
 
 #include "Allocator.h"
 
+#include <mutex>
+
+/* O número de pedaços de memória do primeiro bloco de um PoolAllocator criado pelo MemoryManager. */
+const uint32 DEFAULT_POOL_CHUNK_COUNT = 100;
+
+/* O tamanho máximo, em bytes, de cada bloco encadeado pelo PoolAllocator durante seu crescimento. */
+const uint64 MAX_POOL_BLOCK_SIZE = 256ull * 1024 * 1024;
+
+/**
+ * A estrutura PoolBlock descreve um dos blocos de memória de vídeo encadeados por um PoolAllocator. Os pedaços de
+ * todos os blocos são numerados em sequência, de forma que o bloco possui os pedaços de índice firstChunk até
+ * firstChunk + chunkCount - 1.
+ *
+ */
+struct PoolBlock {
+    struct VkDeviceMemory_T *memory;
+
+    void *mapping;
+
+    uint64 size;
+
+    uint32 firstChunk;
+
+    uint32 chunkCount;
+};
+
 /**
  * O PoolAllocator é a classe do tipo de alocador mais fundamental presente na Real Engine. Devido ao fato da
  * Real Engine funcionar em um sistema de tiles, em que todos os sprites ocuparão o mesmo espaço de memória, o
  * PoolAllocator é a solução mais eficiente para distribuir memória de vídeo com grande eficiência e sem
  * perigo de fragmentação.
  *
+ * Quando todos os pedaços estão ocupados, o PoolAllocator cresce geometricamente, encadeando um novo bloco de
+ * memória de vídeo com tantos pedaços quanto todos os blocos anteriores somados, limitado a MAX_POOL_BLOCK_SIZE
+ * bytes. Dessa forma, um único PoolAllocator atende a qualquer quantidade de pedaços com poucas alocações do tipo
+ * VkDeviceMemory.
+ *
  * Os PoolAllocators podem ser manejados somente através de shared_ptr e weak_ptr e devem ser criados e distribuídos
- * pelo subsistema de memória de vídeo, ou seja, o MemoryManager.
+ * pelo subsistema de memória de vídeo, ou seja, o MemoryManager. Os métodos allocate e free podem ser invocados a
+ * partir de várias threads.
  *
  * A classe PoolAllocator necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
  *      1. O construtor padrão que permite a criação de objetos resetados;
@@ -33,27 +65,30 @@ private:
      * realizadas em velocidade máxima. */
     uint64 alignment;
 
+    /* Os blocos de memória de vídeo encadeados pelo PoolAllocator, na ordem em que foram alocados. */
+    std::vector<PoolBlock> blocks;
+
     /* O atributo que determina o tamanho de cada uma das regiões de memória que serão distribuídas. */
     uint64 chunkSize;
 
     /* O atributo que guarda as propriedades da zona de memória alocada. */
     uint32 flags;
 
-    /* A lista linkada que armazena as regiões de memória que estão disponíveis para serem alocadas como unique_ptr
-     * sob a autoridade do alocador. */
-    std::forward_list<std::unique_ptr<class Memory>> freeList;
+    /* A pilha compacta com os índices das regiões de memória que estão disponíveis para serem alocadas, de forma que
+     * alocações e liberações sejam feitas em tempo constante e sem alocações na CPU. */
+    std::vector<uint32> freeChunks;
 
     /* O atributo que guarda em qual heap da memória do dispositivo físico a memória do PoolAllocator está
      * armazenada. */
     uint32 heap;
 
-    /* O atributo que armazena o handle da memória do PoolAllocator, esta é a origem de todas as regiões de memória
-     * que serão distribuídas pelo objeto. */
-    struct VkDeviceMemory_T *memory;
+    std::mutex mutex;
 
-    /* O atributo que guarda o tamanho do bloco de memória que o PoolAllocator alocou. Ao dividir-se o size pelo
-     * chunkSize se tem o número de blocos de memória que podem ser distribuídos pelo alocador. */
-    uint64 size;
+    /* O atributo que guarda a soma dos tamanhos de todos os blocos de memória que o PoolAllocator alocou. */
+    std::atomic<uint64> size;
+
+    /* O atributo que conta quantas regiões de memória estão atualmente sob a posse de outros objetos. */
+    std::atomic<uint64> usedChunks;
 
 private:
     /**
@@ -64,17 +99,21 @@ private:
     explicit PoolAllocator();
 
     /**
-     * Um método auxiliar cujo propósito está em particionar a extensa fatia de memória que foi alocada durante a
-     * criação do objeto. Este método irá fatiar a memória de tamanho size em (chunkSize / size) pedaços de memória
-     * de tamanho chunkSize.
+     * Um método auxiliar cujo propósito está em alocar, junto a API Vulkan, um novo bloco de memória de vídeo de
+     * siz bytes e particioná-lo em pedaços de tamanho chunkSize, encadeando-o aos blocos existentes.
      *
-     * Cada pedaço de memória fatiado pelo método será representado por uma estrutura do tipo Memory, manipulada
-     * através de um unique_ptr garantindo que apenas uma cópia do objeto possa existir. Estes vários pedaços serão
-     * então utilizados para alimentar a lista linkada freeList como memória disponível para o PoolAllocator
-     * alocar à objetos que requisitarem.
+     * Cada pedaço de memória fatiado pelo método é representado apenas pelo seu índice, empilhado em freeChunks em
+     * ordem decrescente para que os primeiros pedaços sejam distribuídos primeiro. Os objetos do tipo Memory são
+     * construídos somente no momento da alocação, a partir do índice retirado da pilha.
      *
      */
-    void chunkMemory();
+    Result<void> addBlock(uint64 siz);
+
+    /* Retorna o bloco que contém o pedaço de índice chunk, através de uma busca binária sobre firstChunk. */
+    const PoolBlock *findBlock(uint32 chunk) const noexcept;
+
+    /* Retorna o bloco cuja handle de memória de vídeo é mem, ou nullptr caso não pertença a este alocador. */
+    PoolBlock *findBlock(struct VkDeviceMemory_T *mem) noexcept;
 
     /**
      * O método auxiliar getGraphicsDevice tem como objetivo adquirir o dispositivo lógico da aplicação através
@@ -92,10 +131,11 @@ private:
 
     /**
      * O método auxiliar que tem como função criar e preencher a estrutura do tipo VkMemoryAllocateInfo. Esta
-     * estrutura é necessária para requisitar uma alocação de memória ao dispositivo físico, através da API Vulkan.
+     * estrutura é necessária para requisitar uma alocação de memória de siz bytes ao dispositivo físico, através da
+     * API Vulkan.
      *
      */
-    struct VkMemoryAllocateInfo getMemoryAllocateInfo() const noexcept;
+    struct VkMemoryAllocateInfo getMemoryAllocateInfo(uint64 siz) const noexcept;
 
     /**
      * O método auxiliar que tem como função criar e preencher a estrutura do tipo VkMemoryRequirements. Esta
@@ -103,12 +143,13 @@ private:
      * ao chamar o método estático de chooseHeapFromFlags.
      *
      */
-    struct VkMemoryRequirements getMemoryRequirements() const noexcept;
+    struct VkMemoryRequirements getMemoryRequirements(uint64 siz) const noexcept;
 
 public:
     /**
      * O destrutor de objetos do tipo PoolAllocator. Este é um método fundamental destes objetos, visto que é
-     * responsável por dealocar a memória junto a API Vulkan e também limpar a lista de memória disponível.
+     * responsável por dealocar todos os blocos de memória junto a API Vulkan e também limpar a pilha de memória
+     * disponível.
      *
      * É importante notar que, como objetos do tipo PoolAllocator são manipulados por shared_ptr, este destrutor será
      * chamado se e, somente se, houver a destruição de todos os shared_ptr que referenciam este objeto.
@@ -130,46 +171,65 @@ public:
 
     inline uint32 getAllocatorFlags() const noexcept { return this->flags; }
 
-    inline bool hasMemory() const noexcept { return !this->freeList.empty(); }
+    inline uint32 getAllocatorHeap() const noexcept { return this->heap; }
+
+    inline uint64 getAllocatorSize() const noexcept override { return this->size; }
+
+    uint32 getBlockCount() noexcept override;
+
+    uint64 getBlockSize(const Memory &mem) noexcept override;
+
+    /* Retorna quantos pedaços existem no total, somando os livres e os distribuídos. */
+    uint64 getChunkCount() noexcept;
+
+    inline uint64 getUsedSize() const noexcept override { return this->usedChunks * this->chunkSize; }
 
     /**
      * O método que os alocadores necessitam para que outros objetos possam efetuar requisições de alocações
      * de espaços de memória de vídeo.
      *
-     * A memória é retornada na forma de um unique_ptr de forma a manter garantida a exclusividade do objeto
-     * Memory e de evitar leaks de memória de vídeo.
+     * A memória é retornada como um objeto Memory por valor, sem nenhuma alocação na CPU.
      *
-     * Por se tratar de um PoolAllocator, este método retornará o primeiro elemento da lista linkada freeList,
-     * removendo-o da lista e transferindo a propriedade do objeto do tipo Memory para o requisitante. Este pedaço
-     * de memória transferido terá tamanho igual a chunkSize, portanto, o parâmetro do método é ignorado.
+     * Por se tratar de um PoolAllocator, este método retirará o índice do topo da pilha freeChunks e transferirá a
+     * posse do pedaço correspondente para o requisitante, encadeando um novo bloco caso a pilha esteja vazia. Este
+     * pedaço de memória terá tamanho igual a chunkSize, portanto, requisições com siz maior que chunkSize
+     * retornam o erro NoMemoryAvailableInAllocator.
      *
      */
-    Result<std::unique_ptr<class Memory>> allocate(uint64 siz = 0) override;
+    Result<Memory> allocate(uint64 siz = 0) override;
 
     /**
      * O método que os alocadores necessitam para que outros objetos possam liberar alocações de memória de vídeo que
      * haviam feito anteriormente.
      *
-     * A memória é tomada na forma de uma referência de unique_ptr e deverá nulificar esse ponteiro além de
-     * retornar o objeto Memory para a propriedade do alocador.
+     * A memória é tomada na forma de uma referência e será invalidada após retornar a região para a propriedade do
+     * alocador.
+     *
+     * No PoolAllocator, este método meramente calculará o índice do pedaço a partir do seu bloco e offset e o
+     * empilhará em freeChunks.
      *
-     * No PoolAllocator, este método meramente tomará a propriedade do objeto que lhe foi encaminhado e o
-     * adicionará na frente  da lista linkada freeList.
+     */
+    void free(Memory &mem) override;
+
+    /**
+     * No PoolAllocator, cada bloco encadeado é mapeado separadamente na primeira vez em que uma de suas regiões é
+     * mapeada.
      *
      */
-    void free(std::unique_ptr<class Memory> &mem) override;
+    Result<void *> map(const Memory &mem) override;
 
     /**
      * Este método estático é a forma correta e padrão de efetuar a criação de um objeto do tipo PoolAllocator.
      *
-     * O método criará um PoolAllocator que conforme com as propriedades passadas nos parâmetros, alocará a memória
-     * com a API Vulkan e, por fim, retornará um shared_ptr que permite compartilhar o objeto entre vários
-     * outros objetos que necessitem utilizá-lo.
+     * O método criará um PoolAllocator que conforme com as propriedades passadas nos parâmetros, em um dos tipos de
+     * memória permitidos por memoryTypeBits, alocará o primeiro bloco de memória com a API Vulkan e, por fim,
+     * retornará um shared_ptr que permite compartilhar o objeto entre vários outros objetos que necessitem utilizá-lo.
      *
      */
     static Result<std::shared_ptr<PoolAllocator>> createAllocator(uint64 initialSize,
                                                                   uint64 partitionSize,
                                                                   uint64 alignment,
+                                                                  uint32 memoryTypeBits,
                                                                   uint32 flags);
 
 public:
@@ -26,8 +26,6 @@
  */
 class Queue {
 protected:
-    struct VkCommandBuffer_T *buffer;
-
     struct VkCommandPool_T *pool;
 
     struct VkQueue_T *queue;
@@ -39,15 +37,14 @@ protected:
 protected:
     explicit Queue();
 
-    struct VkCommandBufferAllocateInfo getCommandBufferAllocateInfo() const noexcept;
-    
-    struct VkCommandBufferBeginInfo getCommandBufferBeginInfo() const noexcept;
+    struct VkCommandBufferAllocateInfo getCommandBufferAllocateInfo(uint32 level) const noexcept;
 
     struct VkCommandPoolCreateInfo getCommandPoolCreateInfo() const noexcept;
 
     Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
 
-    struct VkSubmitInfo getSubmitInfo(struct VkSemaphore_T *const *signals,
+    struct VkSubmitInfo getSubmitInfo(struct VkCommandBuffer_T *const *cmdBuffer,
+                                      struct VkSemaphore_T *const *signals,
                                       uint32 signalCount,
                                       struct VkSemaphore_T *const *waits,
                                       uint32 waitCount,
@@ -56,7 +53,12 @@ protected:
 public:
     virtual ~Queue();
 
-    void bindPipeline(struct VkPipeline_T *pipeline);
+    /**
+     * O método allocateBuffer aloca um novo command buffer, do nível especificado, a partir do command pool desta
+     * fila. O command buffer pertence ao chamador, que deve devolvê-lo através do método freeBuffer.
+     *
+     */
+    Result<struct VkCommandBuffer_T *> allocateBuffer(uint32 level) const noexcept;
 
     static Result<std::shared_ptr<Queue>> createQueue(struct VkDevice_T *device,
                                                       uint32 familyIndex,
@@ -64,15 +66,14 @@ public:
 
     inline uint32 getFamily() const noexcept { return this->familyIndex; }
 
-    Result<struct VkCommandBuffer_T *> getVulkanBuffer() const noexcept;
-
     Result<struct VkCommandPool_T *> getVulkanPool() const noexcept;
 
     Result<struct VkQueue_T *> getVulkanQueue() const noexcept;
 
-    void resetBuffers();
+    void freeBuffer(struct VkCommandBuffer_T *cmdBuffer) const noexcept;
 
-    Result<void> submit(struct VkSemaphore_T *const *signals,
+    Result<void> submit(struct VkCommandBuffer_T *cmdBuffer,
+                        struct VkSemaphore_T *const *signals,
                         uint32 signalCount,
                         struct VkSemaphore_T *const *waits,
                         uint32 waitCount,
@@ -0,0 +1,230 @@
+/**
+ * TlsfAllocator.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TLSFALLOCATOR_H_
+#define TLSFALLOCATOR_H_
+
+#include "Allocator.h"
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+/* O logaritmo do número de subdivisões lineares de cada classe de tamanho. */
+const uint32 TLSF_SL_INDEX_COUNT_LOG2 = 5;
+
+const uint32 TLSF_SL_INDEX_COUNT = 1u << TLSF_SL_INDEX_COUNT_LOG2;
+
+/* O alinhamento mínimo, em bytes, de todas as regiões distribuídas pelo TlsfAllocator. */
+const uint64 TLSF_MIN_ALIGNMENT_LOG2 = 4;
+
+const uint64 TLSF_MIN_ALIGNMENT = 1ull << TLSF_MIN_ALIGNMENT_LOG2;
+
+const uint32 TLSF_FL_INDEX_SHIFT = TLSF_SL_INDEX_COUNT_LOG2 + TLSF_MIN_ALIGNMENT_LOG2;
+
+/* O logaritmo do tamanho máximo de um bloco de memória administrado pelo TlsfAllocator. */
+const uint32 TLSF_FL_INDEX_MAX = 40;
+
+const uint32 TLSF_FL_INDEX_COUNT = TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1;
+
+const uint64 TLSF_SMALL_BLOCK_SIZE = 1ull << TLSF_FL_INDEX_SHIFT;
+
+/**
+ * A estrutura TlsfBlock descreve uma região contígua do bloco de memória de um TlsfAllocator, livre ou ocupada. As
+ * regiões vizinhas na memória são encadeadas através de prevPhysical e nextPhysical, para que regiões livres
+ * adjacentes possam ser unidas em tempo constante, e as regiões livres de uma mesma classe de tamanho são encadeadas
+ * através de prevFree e nextFree.
+ *
+ */
+struct TlsfBlock {
+    uint64 offset;
+
+    uint64 size;
+
+    TlsfBlock *prevPhysical;
+
+    TlsfBlock *nextPhysical;
+
+    TlsfBlock *prevFree;
+
+    TlsfBlock *nextFree;
+
+    bool bFree;
+};
+
+/**
+ * O TlsfAllocator é o alocador de propósito geral da Real Engine, capaz de distribuir regiões de tamanhos e
+ * alinhamentos variados a partir de um único bloco de memória de vídeo, de forma que recursos de tamanhos diferentes
+ * compartilhem poucas alocações do tipo VkDeviceMemory.
+ *
+ * O alocador implementa o algoritmo Two-Level Segregated Fit (TLSF), no qual as regiões livres são organizadas em
+ * listas segregadas por classes de tamanho (primeiro nível em potências de dois e segundo nível em subdivisões
+ * lineares), indexadas por mapas de bits. Tanto a alocação quanto a liberação são executadas em tempo constante e a
+ * fragmentação é limitada, pois regiões livres adjacentes são sempre unidas.
+ *
+ * Os TlsfAllocators podem ser manejados somente através de shared_ptr e weak_ptr e devem ser criados e distribuídos
+ * pelo subsistema de memória de vídeo, ou seja, o MemoryManager. Os métodos allocate e free podem ser invocados a
+ * partir de várias threads.
+ *
+ * A classe TlsfAllocator necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class TlsfAllocator final : public Allocator {
+private:
+    /* O alinhamento mínimo das regiões distribuídas por este alocador, nunca inferior a TLSF_MIN_ALIGNMENT. */
+    uint64 alignment;
+
+    /* O atributo que guarda as propriedades requisitadas para a zona de memória alocada. */
+    uint32 flags;
+
+    /* O atributo que guarda o tipo de memória do dispositivo físico em que o bloco do TlsfAllocator está alocado. */
+    uint32 heap;
+
+    /* O atributo que guarda o ponteiro para o bloco de memória mapeado na CPU, ou nullptr se ele ainda não foi
+     * mapeado. */
+    void *mapping;
+
+    /* O atributo que armazena o handle do bloco de memória de vídeo de onde todas as regiões são distribuídas. */
+    struct VkDeviceMemory_T *memory;
+
+    uint64 size;
+
+    /* O número de bytes atualmente distribuídos, incluindo o preenchimento exigido pelo alinhamento. */
+    std::atomic<uint64> usedSize;
+
+    /* O mapa de bits do primeiro nível, com um bit para cada classe que possua ao menos uma região livre. */
+    uint32 flBitmap;
+
+    /* Os mapas de bits do segundo nível, um para cada classe do primeiro nível. */
+    std::array<uint32, TLSF_FL_INDEX_COUNT> slBitmaps;
+
+    /* As cabeças das listas de regiões livres de cada par de classes. */
+    std::array<std::array<TlsfBlock *, TLSF_SL_INDEX_COUNT>, TLSF_FL_INDEX_COUNT> freeHeads;
+
+    /* O armazenamento das descrições de regiões, cujos endereços permanecem estáveis durante a vida do alocador. */
+    std::deque<TlsfBlock> blockStorage;
+
+    /* As descrições de regiões que foram descartadas após uniões e que podem ser reaproveitadas. */
+    std::vector<TlsfBlock *> spareBlocks;
+
+    /* As regiões ocupadas, indexadas pelo offset que foi entregue no objeto Memory. */
+    std::unordered_map<uint64, TlsfBlock *> usedBlocks;
+
+    std::mutex mutex;
+
+private:
+    explicit TlsfAllocator();
+
+    TlsfBlock *acquireBlock();
+
+    /**
+     * O método auxiliar findSuitableBlock procura, através dos mapas de bits, a primeira lista não vazia cuja classe
+     * seja igual ou superior à classe (fl, sl) e retorna sua primeira região, ou nullptr se não houver nenhuma.
+     *
+     */
+    TlsfBlock *findSuitableBlock(uint32 &fl, uint32 &sl) const noexcept;
+
+    Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
+
+    struct VkMemoryAllocateInfo getMemoryAllocateInfo() const noexcept;
+
+    void insertFreeBlock(TlsfBlock *block) noexcept;
+
+    /**
+     * Os métodos auxiliares mappingInsert e mappingSearch calculam a classe (fl, sl) de um tamanho. O primeiro retorna
+     * a classe em que uma região daquele tamanho deve ser inserida, enquanto o segundo arredonda o tamanho para cima
+     * de forma que qualquer região da classe retornada seja grande o suficiente.
+     *
+     */
+    static void mappingInsert(uint64 siz, uint32 &fl, uint32 &sl) noexcept;
+
+    static void mappingSearch(uint64 siz, uint32 &fl, uint32 &sl) noexcept;
+
+    void releaseBlock(TlsfBlock *block);
+
+    void removeFreeBlock(TlsfBlock *block) noexcept;
+
+    /**
+     * O método auxiliar splitBlock reduz a região block para siz bytes e retorna uma nova região, livre, com o
+     * restante do espaço.
+     *
+     */
+    TlsfBlock *splitBlock(TlsfBlock *block, uint64 siz);
+
+public:
+    ~TlsfAllocator();
+
+    inline uint64 getAllocatorAlignment() const noexcept { return this->alignment; }
+
+    inline uint32 getAllocatorFlags() const noexcept { return this->flags; }
+
+    inline uint32 getAllocatorHeap() const noexcept { return this->heap; }
+
+    inline uint64 getAllocatorSize() const noexcept override { return this->size; }
+
+    inline uint32 getBlockCount() noexcept override { return 1; }
+
+    inline uint64 getBlockSize(const Memory &mem) noexcept override { return this->size; }
+
+    inline uint64 getUsedSize() const noexcept override { return this->usedSize; }
+
+    /**
+     * O método que os alocadores necessitam para que outros objetos possam efetuar requisições de alocações de
+     * espaços de memória de vídeo. A região retornada respeita o alinhamento mínimo do alocador.
+     *
+     */
+    Result<Memory> allocate(uint64 siz) override;
+
+    /**
+     * Uma versão do método allocate que garante que o offset da região retornada seja múltiplo de align, que deve ser
+     * uma potência de dois, conforme exigido pelos VkMemoryRequirements de Buffers e Images.
+     *
+     */
+    Result<Memory> allocate(uint64 siz, uint64 align);
+
+    /**
+     * O método canAllocate verifica, em tempo constante, se uma região de siz bytes com alinhamento align pode ser
+     * distribuída por este alocador no momento.
+     *
+     */
+    bool canAllocate(uint64 siz, uint64 align) noexcept;
+
+    /**
+     * No TlsfAllocator, este método marca a região como livre e a une às regiões livres adjacentes antes de
+     * devolvê-la às listas segregadas.
+     *
+     */
+    void free(Memory &mem) override;
+
+    Result<void *> map(const Memory &mem) override;
+
+    /**
+     * Este método estático é a forma correta e padrão de efetuar a criação de um objeto do tipo TlsfAllocator. O
+     * bloco de memória de tamanho initialSize é alocado no tipo de memória heap e administrado inteiramente pelo
+     * alocador.
+     *
+     */
+    static Result<std::shared_ptr<TlsfAllocator>> createAllocator(uint64 initialSize,
+                                                                  uint64 alignment,
+                                                                  uint32 heap,
+                                                                  uint32 flags);
+
+public:
+    TlsfAllocator(const TlsfAllocator &) = delete;
+    TlsfAllocator(TlsfAllocator &&) = delete;
+
+    TlsfAllocator &operator=(const TlsfAllocator &) = delete;
+    TlsfAllocator &operator=(TlsfAllocator &&) = delete;
+};
+
+#endif /* TLSFALLOCATOR_H_ */
@@ -10,6 +10,71 @@
 
 #include "Result.h"
 
+const uint32 DEFAULT_FRAMES_IN_FLIGHT = 2;
+
+const uint32 MAX_FRAMES_IN_FLIGHT = 8;
+
+const uint32 MAX_BOUND_TEXTURES = 64;
+
+const uint32 MAX_RECORD_JOBS = 8;
+
+/* A capacidade mínima, em sprites, de cada região do buffer de instâncias. */
+const uint32 MIN_INSTANCE_CAPACITY = 1024;
+
+struct FrameData {
+    struct VkCommandBuffer_T *cmdBuffer;
+
+    struct VkFence_T *fence;
+
+    struct VkSemaphore_T *imageSemaphore;
+
+    struct VkSemaphore_T *renderSemaphore;
+
+    struct VkDescriptorSet_T *descriptorSet;
+
+    uint32 boundTextures;
+
+    /* O offset, dentro do buffer do frameAllocator, da transformação da câmera escrita para este quadro. */
+    uint32 transformOffset;
+
+    /* A versão do Defragmenter com a qual o descriptorSet foi escrito pela última vez. */
+    uint64 relocationVersion;
+
+    /* A versão do TextureLoader com a qual o descriptorSet foi escrito pela última vez. */
+    uint64 residencyVersion;
+
+    /* A versão das texturas do SpriteStorage com a qual o descriptorSet foi escrito pela última vez. */
+    uint64 textureVersion;
+
+    /* Os buffers substituídos enquanto este quadro ainda estava em execução, liberados após sua fence sinalizar. */
+    std::vector<std::shared_ptr<class Buffer>> retiredBuffers;
+
+    /* As texturas descartadas pelo SpriteStorage que este quadro ainda pode amostrar, liberadas da mesma forma. */
+    std::vector<std::shared_ptr<class Texture>> retiredTextures;
+};
+
+struct RecordSlot {
+    std::vector<struct VkCommandPool_T *> pools;
+
+    std::vector<struct VkCommandBuffer_T *> cmdBuffers;
+
+    uint32 firstInstance;
+
+    uint32 instanceCount;
+
+    uint32 dirtyFirst;
+
+    uint32 dirtyLast;
+};
+
+struct RenderBatch {
+    uint32 textureIndex;
+
+    uint32 firstInstance;
+
+    uint32 instanceCount;
+};
+
 class Renderer final {
 private:
 
@@ -17,11 +82,34 @@ private:
 
     std::shared_ptr<class Queue> transferQueue;
 
+    std::shared_ptr<class TransferScheduler> transferScheduler;
+
+    std::shared_ptr<class Defragmenter> defragmenter;
+
+    /* A memória dos dados que vivem por um único quadro, reaproveitada quando a fence do quadro sinaliza. */
+    std::shared_ptr<class LinearAllocator> frameAllocator;
+
+    std::shared_ptr<class TextureLoader> textureLoader;
+
+    /* O registro das texturas carregadas a partir de arquivos, que mantém as texturas sem uso até seu orçamento. */
+    std::shared_ptr<class TextureCache> textureCache;
+
+    /* A textura amostrada no lugar das texturas que ainda não são residentes. */
+    std::shared_ptr<class Texture> placeholderTexture;
+
     struct VkDescriptorPool_T *descriptorPool;
 
     struct VkDescriptorSetLayout_T *descriptorLayout;
 
-    std::vector<struct VkDescriptorSet_T *> descriptorSets;
+    std::shared_ptr<class SpriteStorage> spriteStorage;
+
+    std::vector<RenderBatch> batches;
+
+    uint64 batchVersion;
+
+    uint32 textureCapacity;
+
+    bool bDescriptorIndexing;
 
     struct VkPipelineLayout_T *pipelineLayout;
 
@@ -35,13 +123,21 @@ private:
 
     uint32 imageIndex;
 
-    std::vector<std::shared_ptr<class Buffer>> transformBuffers;
+    std::vector<FrameData> frames;
 
-    struct VkFence_T *imageFence;
+    uint32 frameIndex;
 
-    struct VkSemaphore_T *imageSemaphore;
+    std::shared_ptr<class Buffer> vertexBuffer;
+
+    std::shared_ptr<class Buffer> instanceBuffer;
 
-    std::vector<struct VkSemaphore_T *> queueSemaphores;
+    uint32 instanceCapacity;
+
+    uint8 *instanceMapping;
+
+    std::vector<RecordSlot> recordSlots;
+
+    uint32 activeRecordJobs;
 
     struct VkSampler_T *textureSampler;
 
@@ -55,14 +151,17 @@ private:
 
     uint32 height;
 
-    std::forward_list<std::shared_ptr<class SpriteComponent>> objectsToRender;
-    uint32 numOfObjectsToRender;
-
 private:
     Result<void> acquireSwapchainAndBuffers();
 
     Result<void> allocateDescriptorSets();
 
+    Result<void> createBatches();
+
+    Result<void> createCommandBuffers();
+
+    Result<void> createRecordSlots();
+
     Result<void> createDescriptorLayouts();
 
     Result<void> createDescriptorPool();
@@ -83,7 +182,30 @@ private:
 
     Result<void> createTextureSampler();
 
-    Result<void> createTransformBuffers();
+    Result<void> createTransferScheduler();
+
+    Result<void> createDefragmenter();
+
+    Result<void> createFrameAllocator();
+
+    Result<void> createTextureLoader();
+
+    Result<void> createTextureCache();
+
+    Result<void> createPlaceholderTexture();
+
+    Result<void> createInstanceBuffer();
+
+    /**
+     * Substitui o buffer de instâncias por um com capacidade para ao menos count sprites por quadro, crescendo
+     * geometricamente. O buffer anterior é mantido pelos demais quadros em execução até que suas fences sinalizem e
+     * todos os sprites são marcados como modificados, já que as regiões de todos os quadros mudam de lugar.
+     *
+     */
+    Result<void> growInstanceBuffer(uint32 count);
+
+
+    Result<void> createVertexBuffer();
 
     std::vector<struct VkAttachmentDescription> getAttachmentDescription() const noexcept;
 
@@ -91,6 +213,15 @@ private:
 
     struct VkPipelineColorBlendAttachmentState getColorBlendAttachmentState() const noexcept;
 
+    struct VkCommandBufferBeginInfo getCommandBufferBeginInfo() const noexcept;
+
+    struct VkCommandBufferInheritanceInfo getCommandBufferInheritanceInfo() const noexcept;
+
+    struct VkCommandPoolCreateInfo getCommandPoolCreateInfo() const noexcept;
+
+    struct VkCommandBufferBeginInfo getSecondaryBufferBeginInfo(
+            struct VkCommandBufferInheritanceInfo *inheritanceInfo) const noexcept;
+
     struct VkPipelineColorBlendStateCreateInfo getColorBlendStateCreateInfo(
             struct VkPipelineColorBlendAttachmentState *attachmentState) const noexcept;
 
@@ -145,7 +276,8 @@ private:
 
     struct VkSemaphoreCreateInfo getSemaphoreCreateInfo() const noexcept;
 
-    std::vector<struct VkPipelineShaderStageCreateInfo> getShaderStageCreateInfo() const noexcept;
+    std::vector<struct VkPipelineShaderStageCreateInfo> getShaderStageCreateInfo(
+            struct VkSpecializationInfo *specializationInfo) const noexcept;
 
     std::vector<struct VkSubpassDependency> getSubpassDependency() const noexcept;
 
@@ -154,8 +286,10 @@ private:
 
     Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
 
+    std::vector<struct Vertex> getVertexData() const noexcept;
+
     struct VkPipelineVertexInputStateCreateInfo getVertexInputStateCreateInfo(
-            struct VkVertexInputBindingDescription *bindings,
+            std::vector<struct VkVertexInputBindingDescription> *bindings,
             std::vector<struct VkVertexInputAttributeDescription> *attributes) const noexcept;
 
     struct VkViewport getViewport() const noexcept;
@@ -166,28 +300,69 @@ private:
 
     Result<void> loadQueues();
 
+    Result<void> loadTextureLimits();
+
+    void recordInstances(RecordSlot &slot);
+
     struct VkCommandBuffer_T *selectCommandBuffer() const noexcept;
 
-    void updateDescriptorSets();
+    void updateDescriptorSets(FrameData &frame);
+
+    /**
+     * Escreve a transformação da câmera na região do quadro atual do frameAllocator e guarda seu offset em frame,
+     * de forma que a câmera seja lida através de um uniform dinâmico sem nenhum buffer dedicado ou cópia de staging.
+     *
+     */
+    Result<void> writeTransform(FrameData &frame);
 
 public:
-    explicit Renderer();
+    explicit Renderer(std::shared_ptr<class SpriteStorage> storage, uint32 framesInFlight = DEFAULT_FRAMES_IN_FLIGHT);
 
     virtual ~Renderer();
 
-    void addObject(std::shared_ptr<class SpriteComponent> &object);
-
     Result<void> begin();
 
     Result<void> load();
 
-    void draw();
+    /**
+     * Grava os sprites no quadro atual. Caso os sprites não possam ser desenhados, como quando há mais texturas
+     * registradas do que o descriptorSet comporta, o erro é retornado e nada é gravado, mas o quadro ainda deve ser
+     * encerrado através de end.
+     *
+     */
+    Result<void> draw();
 
     Result<void> end();
 
-    Result<void> executeTransferBuffer(struct VkCommandBuffer_T *cmdBuffer) const noexcept;
+    inline const std::shared_ptr<class Defragmenter> &getDefragmenter() const noexcept {
+        return this->defragmenter;
+    }
+
+    /* Retorna o número de sprites que o buffer de instâncias comporta por quadro antes de crescer novamente. */
+    inline uint32 getInstanceCapacity() const noexcept { return this->instanceCapacity; }
+
+    /* Retorna quantos sprites foram gravados pela última invocação de draw. */
+    uint32 getRecordedInstanceCount() const noexcept;
+
+    inline const std::shared_ptr<class LinearAllocator> &getFrameAllocator() const noexcept {
+        return this->frameAllocator;
+    }
+
+    inline const std::shared_ptr<class TextureCache> &getTextureCache() const noexcept {
+        return this->textureCache;
+    }
+
+    inline const std::shared_ptr<class TextureLoader> &getTextureLoader() const noexcept {
+        return this->textureLoader;
+    }
+
+    inline const std::shared_ptr<class TransferScheduler> &getTransferScheduler() const noexcept {
+        return this->transferScheduler;
+    }
+
+    void setRecordJobs(uint32 count) noexcept;
 
-    Result<struct VkCommandBuffer_T *> requestTransferBuffer() const noexcept;
+    inline uint32 getRecordJobs() const noexcept { return this->activeRecordJobs; }
 
     Result<void> startup();
 
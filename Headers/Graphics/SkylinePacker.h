@@ -0,0 +1,64 @@
+/**
+ * SkylinePacker.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef SKYLINEPACKER_H_
+#define SKYLINEPACKER_H_
+
+#include "Result.h"
+
+struct PackedRect {
+    uint32 x;
+
+    uint32 y;
+
+    uint32 width;
+
+    uint32 height;
+};
+
+/* Um segmento horizontal do contorno superior dos retângulos já posicionados. */
+struct SkylineNode {
+    uint32 x;
+
+    uint32 y;
+
+    uint32 width;
+};
+
+/**
+ * O SkylinePacker distribui retângulos dentro de uma área de width por height através do algoritmo skyline
+ * bottom-left: o contorno superior dos retângulos já posicionados é mantido como uma lista de segmentos e cada novo
+ * retângulo é colocado na posição que resulta no menor topo, desempatando pelo segmento mais estreito.
+ *
+ */
+class SkylinePacker final {
+private:
+    std::vector<SkylineNode> nodes;
+
+    uint32 width;
+
+    uint32 height;
+
+    uint64 usedArea;
+
+private:
+    /* Retorna a altura em que um retângulo de width por height apoiado no segmento index ficaria, se couber. */
+    Result<uint32> fit(uint32 index, uint32 width, uint32 height) const noexcept;
+
+    void merge() noexcept;
+
+public:
+    explicit SkylinePacker(uint32 width, uint32 height);
+
+    inline real64 getOccupancy() const noexcept {
+        return static_cast<real64>(this->usedArea) / (static_cast<real64>(this->width) * this->height);
+    }
+
+    Result<PackedRect> insert(uint32 width, uint32 height);
+};
+
+#endif /* SKYLINEPACKER_H_ */
@@ -9,51 +9,160 @@
 #define TEXTURE_H_
 
 #include "Result.h"
+#include "TextureFile.h"
+#include "TransferScheduler.h"
+
+#include <atomic>
 
 const uint32 TILE_SIZE = 32;
 
+/* As etapas pelas quais uma textura passa até que seus pixels possam ser amostrados pela GPU. */
+enum class TextureState : uint32 {
+    Decoding,
+    Decoded,
+    Uploading,
+    Resident,
+    Failed
+};
+
 struct RawImageInfo {
     uint32 width;
     uint32 height;
-    uint8 *pixels;
+    std::vector<uint8> pixels;
 };
 
 class Texture {
 private:
 
-    std::shared_ptr<class Buffer> buffer;
-
     std::shared_ptr<class Image> image;
 
+    /* Os pixels decodificados, mantidos na CPU somente até que load os envie ao buffer circular de staging. */
+    std::vector<uint8> pixels;
+
+    /* O arquivo de textura preparado, mantido mapeado somente até que load copie seus níveis para o staging. */
+    std::shared_ptr<class MappedFile> file;
+
+    TextureFileInfo fileInfo;
+
     uint32 width;
 
     uint32 height;
 
+    uint32 format;
+
+    uint32 mipLevels;
+
+    /* O número de bytes de texels enviados à GPU por load, incluindo todos os níveis de mipmap. */
+    uint64 memorySize;
+
+    TransferTicket ticket;
+
     struct VkImageView_T *view;
 
+    /* A contagem de movimentações do Image quando view foi criada. */
+    uint32 viewRelocations;
+
+    std::atomic<TextureState> state;
+
+    /* Indica que a textura é carregada pelo TextureLoader, sendo substituída por um placeholder até ser residente. */
+    bool bStreamed;
+
 private:
     explicit Texture();
 
+    Result<void> createImage();
+
     Result<void> createImageView();
 
     struct VkBufferImageCopy getBufferImageCopy() const noexcept;
 
+    /* Retorna uma cópia por nível de mipmap do arquivo de textura preparado, ou somente a dos pixels decodificados. */
+    std::vector<struct VkBufferImageCopy> getBufferImageCopies() const noexcept;
+
     Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
 
     Result<std::shared_ptr<class Renderer>> getRenderer() const noexcept;
 
-    Result<RawImageInfo> loadImage(const utf8 *filename) const noexcept;
-
 public:
     ~Texture();
 
-    static Result<std::shared_ptr<Texture>> createTextureFromFile(const utf8 *filename);
+    /**
+     * Cria uma textura transparente de width por height pixels, cujo conteúdo é preenchido através de writePixels.
+     * Essas texturas possuem um único nível, pois os mipmaps de páginas de atlas misturariam imagens vizinhas.
+     *
+     */
+    static Result<std::shared_ptr<Texture>> createTexture(uint32 width, uint32 height);
 
-    Result<std::weak_ptr<class Buffer>> getBuffer() const noexcept;
+    /* Cria e decodifica a textura de filename, reaproveitando os bytes de mappedFile quando ele já foi mapeado. */
+    static Result<std::shared_ptr<Texture>> createTextureFromFile(const utf8 *filename,
+                                                                  std::shared_ptr<class MappedFile> mappedFile =
+                                                                          nullptr);
+
+    /**
+     * Cria uma textura cujo arquivo é decodificado por uma thread do JobManager e enviado à GPU pelo TextureLoader do
+     * Renderer, sem bloquear a thread atual. Até que a textura seja residente, os sprites que a utilizam são
+     * desenhados com a textura placeholder do Renderer.
+     *
+     */
+    static Result<std::shared_ptr<Texture>> createTextureFromFileAsync(const utf8 *filename,
+                                                                       std::shared_ptr<class MappedFile> mappedFile =
+                                                                               nullptr);
+
+    /**
+     * Decodifica filename nos pixels da textura, podendo ser invocado de qualquer thread durante Decoding. Os arquivos
+     * de textura preparados, com a extensão TEXTURE_FILE_EXTENSION, são apenas mapeados na memória, sem decodificação,
+     * e trazem seus próprios mipmaps. Para as demais imagens, a cadeia completa é gerada pela GPU durante load.
+     * Caso mappedFile não seja nulo, ele deve conter os bytes de filename, que então não é lido novamente.
+     *
+     */
+    Result<void> decode(const utf8 *filename, std::shared_ptr<class MappedFile> mappedFile = nullptr);
+
+    static Result<RawImageInfo> loadImage(const utf8 *filename) noexcept;
+
+    /* Decodifica, através de FreeImage_OpenMemory, uma imagem cujos siz bytes já se encontram em data. */
+    static Result<RawImageInfo> loadImage(const uint8 *data, uint64 siz) noexcept;
+
+    inline uint32 getHeight() const noexcept { return this->height; }
+
+    /* Retorna o número de níveis da cadeia completa de mipmaps de uma imagem de width por height, até 1x1. */
+    static uint32 getMipLevelCount(uint32 width, uint32 height) noexcept;
+
+    inline uint64 getMemorySize() const noexcept { return this->memorySize; }
+
+    inline uint32 getMipLevels() const noexcept { return this->mipLevels; }
 
     struct VkImageView_T *getImageView() const noexcept;
 
+    inline TextureState getState() const noexcept { return this->state; }
+
+    inline TransferTicket getTransferTicket() const noexcept { return this->ticket; }
+
+    inline uint32 getWidth() const noexcept { return this->width; }
+
+    /* Indica que os pixels já foram enviados à GPU e não podem mais ser escritos. */
+    inline bool isLoaded() const noexcept {
+        return this->state == TextureState::Uploading || this->state == TextureState::Resident;
+    }
+
+    inline bool isResident() const noexcept { return this->state == TextureState::Resident; }
+
+    inline bool isStreamed() const noexcept { return this->bStreamed; }
+
     Result<void> load();
+
+    /* Recria a VkImageView caso o Defragmenter tenha movido o Image desde sua criação. */
+    Result<void> refreshImageView();
+
+    /**
+     * Torna residente uma textura carregada pelo TextureLoader cujo upload já foi concluído, retornando verdadeiro na
+     * transição. Deve ser invocado pela thread que submete os quadros antes de recordAcquires, de forma que a
+     * aquisição da imagem seja gravada antes do primeiro quadro que a amostra.
+     *
+     */
+    bool updateResidency(class TransferScheduler &scheduler);
+
+    /* Copia um bloco RGBA de width por height pixels para a posição (x, y), somente antes de load. */
+    Result<void> writePixels(uint32 x, uint32 y, uint32 width, uint32 height, const uint8 *data);
 };
 
 #endif /* TEXTURE_H_ */
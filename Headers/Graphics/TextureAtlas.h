@@ -0,0 +1,100 @@
+/**
+ * TextureAtlas.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include "Result.h"
+#include "SkylinePacker.h"
+
+#include <string>
+#include <unordered_map>
+
+/* O tamanho, em pixels, do lado de cada página de um TextureAtlas, suportado por qualquer dispositivo Vulkan. */
+const uint32 DEFAULT_ATLAS_PAGE_SIZE = 2048;
+
+/* A borda, em pixels, que repete as bordas de cada imagem para que a filtragem não misture imagens vizinhas. */
+const uint32 ATLAS_PADDING = 1;
+
+/**
+ * A estrutura AtlasRegion identifica uma imagem dentro de um TextureAtlas: a página em que ela foi posicionada e o
+ * retângulo que ela ocupa, em coordenadas de textura, com o offset em xy e a escala em zw.
+ *
+ */
+struct AtlasRegion {
+    std::shared_ptr<class Texture> texture;
+
+    glm::vec4 uvRect;
+};
+
+/**
+ * O TextureAtlas agrupa várias imagens em poucas texturas grandes, as páginas, posicionando cada imagem através de um
+ * SkylinePacker. Os sprites criados a partir de uma AtlasRegion compartilham a textura da página, de forma que cenas
+ * inteiras ocupem poucos descritores e possam ser desenhadas em um único lote.
+ *
+ * As imagens são copiadas para as páginas na CPU e enviadas à GPU de uma só vez através de load. Uma página enviada
+ * não recebe mais imagens, então as imagens adicionadas após load são posicionadas em novas páginas. Imagens maiores
+ * que DEFAULT_ATLAS_PAGE_SIZE recebem uma página dedicada do seu tamanho.
+ *
+ * A classe TextureAtlas necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class TextureAtlas final {
+private:
+    std::vector<std::shared_ptr<class Texture>> pages;
+
+    std::vector<SkylinePacker> packers;
+
+    /* As regiões já posicionadas, indexadas pelo nome do arquivo de origem. */
+    std::unordered_map<std::string, AtlasRegion> regions;
+
+    uint32 pageSize;
+
+private:
+    explicit TextureAtlas();
+
+    Result<uint32> createPage(uint32 width, uint32 height);
+
+public:
+    ~TextureAtlas();
+
+    static Result<std::shared_ptr<TextureAtlas>> createTextureAtlas(uint32 pageSize = DEFAULT_ATLAS_PAGE_SIZE);
+
+    /* Posiciona a imagem do arquivo filename, retornando a região já existente caso ela tenha sido adicionada antes. */
+    Result<AtlasRegion> addImage(const utf8 *filename);
+
+    /**
+     * Posiciona as imagens de vários arquivos, decodificando-os em paralelo através do JobManager e posicionando as
+     * imagens da mais alta para a mais baixa, o que reduz o espaço desperdiçado pelo SkylinePacker. As regiões são
+     * retornadas na mesma ordem de filenames.
+     *
+     */
+    Result<std::vector<AtlasRegion>> addImages(const std::vector<std::string> &filenames);
+
+    Result<AtlasRegion> addPixels(const struct RawImageInfo &info);
+
+    inline uint32 getPageCount() const noexcept { return static_cast<uint32>(this->pages.size()); }
+
+    inline const std::vector<std::shared_ptr<class Texture>> &getPages() const noexcept { return this->pages; }
+
+    /* Envia à GPU todas as páginas que ainda não foram enviadas. */
+    Result<void> load();
+
+public:
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas(TextureAtlas &&) = delete;
+
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(TextureAtlas &&) = delete;
+};
+
+#endif /* TEXTUREATLAS_H_ */
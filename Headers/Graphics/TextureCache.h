@@ -0,0 +1,140 @@
+/**
+ * TextureCache.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TEXTURECACHE_H_
+#define TEXTURECACHE_H_
+
+#include "Result.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* O número máximo de bytes de texturas sem referências que o TextureCache mantém residentes. */
+const uint64 DEFAULT_TEXTURE_CACHE_BUDGET = 64ull * 1024 * 1024;
+
+/* Uma textura do TextureCache, identificada pelo hash de seu conteúdo e conhecida por todos os caminhos em paths. */
+struct TextureCacheEntry {
+    std::shared_ptr<class Texture> texture;
+
+    std::vector<std::string> paths;
+
+    /* O tamanho do arquivo, comparado junto do hash. Somente quando ambos coincidem os bytes do arquivo são comparados
+     * com os de paths.front(), de forma que colisões nunca troquem uma textura por outra. */
+    uint64 contentSize;
+
+    /* O número de shared_ptr distribuídos por acquire que ainda não foram destruídos. */
+    uint32 references;
+
+    /* Os bytes de vídeo ocupados pela textura e o quadro em que a última referência foi destruída. */
+    uint64 memorySize;
+
+    uint64 releasedFrame;
+
+    /* A posição da entrada em unreferenced, válida somente enquanto references for zero. */
+    std::list<uint64>::iterator lru;
+};
+
+/**
+ * O TextureCache é o registro de texturas carregadas a partir de arquivos. Cada arquivo é identificado pelo seu
+ * caminho e pelo hash de seu conteúdo, de forma que pedir novamente um caminho já conhecido não realiza nenhuma
+ * leitura do disco, e que arquivos idênticos sob caminhos diferentes compartilhem uma única textura na GPU.
+ *
+ * O método acquire distribui shared_ptr cujo destrutor devolve a referência ao TextureCache. As texturas sem
+ * referências não são destruídas imediatamente: elas entram em uma fila LRU e continuam residentes enquanto a soma de
+ * seus tamanhos couber em budget, permitindo que o recarregamento de um nível as reaproveite sem nenhum upload.
+ *
+ * Os métodos acquire e setBudget podem ser invocados a partir de qualquer thread, assim como a destruição das
+ * referências. O método update, que destrói as texturas excedentes, deve ser invocado pelo Renderer no início de
+ * cada quadro, e somente destrói texturas que nenhum quadro em execução possa estar amostrando.
+ *
+ * A classe TextureCache necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class TextureCache final {
+private:
+    std::unordered_map<std::string, uint64> paths;
+
+    std::unordered_map<uint64, TextureCacheEntry> entries;
+
+    /* Os hashes das entradas sem referências, da liberada mais recentemente à mais antiga. */
+    std::list<uint64> unreferenced;
+
+    uint64 unreferencedSize;
+
+    uint64 budget;
+
+    uint64 frame;
+
+    uint32 framesInFlight;
+
+    std::atomic<uint64> hits;
+
+    std::atomic<uint64> misses;
+
+    /* O próprio TextureCache, observado pelas referências distribuídas para que possam sobreviver a ele. */
+    std::weak_ptr<TextureCache> self;
+
+    std::mutex mutex;
+
+private:
+    explicit TextureCache();
+
+    /* Distribui uma nova referência a entry, retirando-a da fila LRU caso ela não possua nenhuma. */
+    std::shared_ptr<class Texture> createReference(uint64 hash, TextureCacheEntry &entry);
+
+    void evict(uint64 hash);
+
+    void release(uint64 hash);
+
+public:
+    ~TextureCache();
+
+    static Result<std::shared_ptr<TextureCache>> createTextureCache(uint32 framesInFlight,
+                                                                    uint64 budget = DEFAULT_TEXTURE_CACHE_BUDGET);
+
+    /**
+     * Retorna a textura de filename, criando-a somente quando nem o caminho nem o conteúdo do arquivo são conhecidos.
+     * Caso bStreamed seja verdadeiro, as texturas novas são criadas por createTextureFromFileAsync, senão, por
+     * createTextureFromFile. Como em ambas, a textura retornada deve ser carregada através de load, que não realiza
+     * nenhuma operação quando ela já foi enviada à GPU.
+     *
+     * O arquivo é lido uma única vez, e os mesmos bytes servem ao hash e à decodificação, que ocorre sem o mutex do
+     * TextureCache, de forma que outras threads continuem sendo atendidas enquanto uma textura nova é decodificada.
+     *
+     */
+    Result<std::shared_ptr<class Texture>> acquire(const std::string &filename, bool bStreamed = false);
+
+    uint32 getEntryCount();
+
+    inline uint64 getHitCount() const noexcept { return this->hits; }
+
+    inline uint64 getMissCount() const noexcept { return this->misses; }
+
+    /* Retorna a soma dos tamanhos das texturas que não possuem referências, mas continuam residentes. */
+    uint64 getUnreferencedSize();
+
+    void setBudget(uint64 bytes);
+
+    void update();
+
+public:
+    TextureCache(const TextureCache &) = delete;
+    TextureCache(TextureCache &&) = delete;
+
+    TextureCache &operator=(const TextureCache &) = delete;
+    TextureCache &operator=(TextureCache &&) = delete;
+};
+
+#endif /* TEXTURECACHE_H_ */
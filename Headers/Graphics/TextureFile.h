@@ -0,0 +1,90 @@
+/**
+ * TextureFile.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TEXTUREFILE_H_
+#define TEXTUREFILE_H_
+
+#include "Result.h"
+
+/* Os bytes "RTEX" lidos como um inteiro little-endian, presentes no início de todo arquivo de textura preparado. */
+const uint32 TEXTURE_FILE_MAGIC = 0x58455452;
+
+const uint32 TEXTURE_FILE_VERSION = 1;
+
+/* O alinhamento de cada nível dentro dos dados, suficiente para os blocos de qualquer formato BCn. */
+const uint64 TEXTURE_FILE_ALIGNMENT = 16;
+
+const utf8 *const TEXTURE_FILE_EXTENSION = ".rtex";
+
+/**
+ * A estrutura TextureFileHeader inicia os arquivos de textura preparados pelo TextureCooker. O formato é o VkFormat
+ * dos dados, por enquanto somente RGBA8, e os níveis de mipmap já estão no layout esperado por
+ * vkCmdCopyBufferToImage, de forma que os dados sejam copiados sem nenhuma conversão. Todos os campos são
+ * little-endian.
+ *
+ */
+struct TextureFileHeader {
+    uint32 magic;
+
+    uint32 version;
+
+    uint32 format;
+
+    uint32 width;
+
+    uint32 height;
+
+    uint32 mipLevels;
+
+    /* O offset, a partir do início do arquivo, dos dados do primeiro nível. */
+    uint64 dataOffset;
+
+    uint64 dataSize;
+};
+
+/* A entrada da tabela de níveis que segue o cabeçalho, com o offset relativo a dataOffset. */
+struct TextureFileLevel {
+    uint64 offset;
+
+    uint64 size;
+
+    uint32 width;
+
+    uint32 height;
+};
+
+static_assert(sizeof(TextureFileHeader) == 40, "");
+static_assert(sizeof(TextureFileLevel) == 24, "");
+
+/* Uma visão, sem cópia, de um arquivo de textura preparado já validado. */
+struct TextureFileInfo {
+    TextureFileHeader header;
+
+    const TextureFileLevel *levels;
+
+    const uint8 *data;
+};
+
+/**
+ * A função cookTexture grava image, que deve conter pixels RGBA8, em filename no formato de textura preparado,
+ * gerando a cadeia completa de mipmaps por média de blocos 2x2 caso bMipmaps seja verdadeiro.
+ *
+ */
+Result<void> cookTexture(const struct RawImageInfo &image, const utf8 *filename, bool bMipmaps = true);
+
+/* Verifica, pela extensão, se filename é um arquivo de textura preparado. */
+bool isTextureFile(const utf8 *filename) noexcept;
+
+/**
+ * Valida os size bytes de bytes e retorna uma visão do cabeçalho, da tabela de níveis e dos dados. Além dos limites do
+ * arquivo, são verificados o formato, o número de níveis e a extensão e o tamanho de cada nível, já que os dados são
+ * copiados diretamente para a Image.
+ *
+ */
+Result<TextureFileInfo> parseTextureFile(const uint8 *bytes, uint64 size) noexcept;
+
+#endif /* TEXTUREFILE_H_ */
@@ -0,0 +1,92 @@
+/**
+ * TextureLoader.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TEXTURELOADER_H_
+#define TEXTURELOADER_H_
+
+#include "JobManager.h"
+#include "Result.h"
+
+#include <mutex>
+#include <string>
+
+/* O número máximo de bytes de pixels que o TextureLoader envia ao TransferScheduler em cada quadro. */
+const uint64 DEFAULT_TEXTURE_UPLOAD_BUDGET = 16ull * 1024 * 1024;
+
+/**
+ * O TextureLoader carrega texturas sem bloquear a thread que submete os quadros. A decodificação de cada arquivo é
+ * um Job do JobManager, de forma que várias texturas sejam decodificadas em paralelo, uma por núcleo disponível. As
+ * texturas decodificadas são enviadas ao TransferScheduler pelo método update, limitado a budget bytes por quadro, e
+ * tornam-se residentes assim que seus lotes de transferência são concluídos.
+ *
+ * Somente o método request pode ser invocado a partir de qualquer thread. O método update deve ser invocado pelo
+ * Renderer no início de cada quadro, antes da submissão dos uploads pendentes e da gravação das aquisições.
+ *
+ * A classe TextureLoader necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class TextureLoader final {
+private:
+    std::shared_ptr<class TransferScheduler> transferScheduler;
+
+    /* Os Jobs de decodificação ainda não concluídos, aguardados na destruição do TextureLoader. */
+    std::vector<JobHandle> decodes;
+
+    /* As texturas decodificadas que aguardam o envio à GPU, em ordem de conclusão. */
+    std::vector<std::weak_ptr<class Texture>> decoded;
+
+    std::vector<std::weak_ptr<class Texture>> uploading;
+
+    std::mutex mutex;
+
+    uint64 budget;
+
+    /* O contador incrementado sempre que alguma textura se torna residente, para que os descritores sejam reescritos. */
+    uint64 version;
+
+private:
+    explicit TextureLoader();
+
+public:
+    ~TextureLoader();
+
+    static Result<std::shared_ptr<TextureLoader>> createTextureLoader(
+            std::shared_ptr<class TransferScheduler> scheduler,
+            uint64 budget = DEFAULT_TEXTURE_UPLOAD_BUDGET);
+
+    /* Retorna o número de texturas que ainda não são residentes, incluindo as que estão sendo decodificadas. */
+    uint32 getPendingCount();
+
+    inline uint64 getVersion() const noexcept { return this->version; }
+
+    /**
+     * Submete um Job que decodifica filename em texture, que deve estar no estado Decoding. Caso mappedFile não seja
+     * nulo, os bytes já mapeados são decodificados sem que o arquivo seja lido novamente.
+     *
+     */
+    void request(const std::shared_ptr<class Texture> &texture,
+                 const std::string &filename,
+                 std::shared_ptr<class MappedFile> mappedFile = nullptr);
+
+    void setBudget(uint64 bytes) noexcept;
+
+    void update();
+
+public:
+    TextureLoader(const TextureLoader &) = delete;
+    TextureLoader(TextureLoader &&) = delete;
+
+    TextureLoader &operator=(const TextureLoader &) = delete;
+    TextureLoader &operator=(TextureLoader &&) = delete;
+};
+
+#endif /* TEXTURELOADER_H_ */
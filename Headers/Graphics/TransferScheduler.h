@@ -0,0 +1,193 @@
+/**
+ * TransferScheduler.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef TRANSFERSCHEDULER_H_
+#define TRANSFERSCHEDULER_H_
+
+#include "Result.h"
+
+#include <deque>
+#include <mutex>
+
+/* O tamanho, em bytes, do buffer circular de staging mantido mapeado durante toda a vida do TransferScheduler. */
+const uint64 DEFAULT_STAGING_RING_SIZE = 32ull * 1024 * 1024;
+
+/* O alinhamento dos offsets distribuídos pelo buffer circular, suficiente para cópias de buffers e de imagens. */
+const uint64 STAGING_RING_ALIGNMENT = 256;
+
+typedef uint64 TransferTicket;
+
+/* O ticket que não corresponde a nenhuma transferência e, portanto, está sempre concluído. */
+const TransferTicket NULL_TRANSFER_TICKET = 0;
+
+/* Um Image cujos níveis de mipmap devem ser gerados por blits sucessivos a partir do nível base. */
+struct MipmapGeneration {
+    struct VkImage_T *image;
+
+    uint32 width;
+
+    uint32 height;
+
+    uint32 mipLevels;
+};
+
+struct TransferBatch {
+    struct VkCommandBuffer_T *cmdBuffer;
+
+    struct VkFence_T *fence;
+
+    TransferTicket ticket;
+
+    /* A posição do buffer circular até a qual a memória pertence a este lote, liberada quando a fence sinalizar. */
+    uint64 ringEnd;
+
+    /* As barreiras de aquisição que a fila gráfica deve gravar após a conclusão do lote. */
+    std::vector<struct VkBufferMemoryBarrier> bufferAcquires;
+
+    std::vector<struct VkImageMemoryBarrier> imageAcquires;
+
+    /* As gerações de mipmap que dependem de uma fila gráfica, gravadas junto das barreiras de aquisição. */
+    std::vector<MipmapGeneration> mipmaps;
+
+    /* Os Buffers de staging dedicados às transferências maiores que o buffer circular. */
+    std::vector<std::shared_ptr<class Buffer>> oversized;
+
+    uint64 oversizedSize;
+};
+
+/**
+ * O TransferScheduler agrupa as cópias de dados da CPU para Buffers e Images exclusivos da GPU em lotes submetidos à
+ * fila de transferência, sem nunca bloquear a fila inteira. Os dados são escritos em um buffer circular de staging
+ * persistente e cada lote é acompanhado por uma fence que, ao sinalizar, devolve sua região do buffer circular.
+ *
+ * Cada upload retorna um TransferTicket, que pode ser consultado através de isComplete ou aguardado através de wait.
+ * Quando a fila de transferência pertence a uma família diferente da fila gráfica, os recursos são liberados pela
+ * fila de transferência e adquiridos pela fila gráfica através de recordAcquires, que o Renderer grava no início de
+ * cada quadro.
+ *
+ * Todos os métodos são sincronizados internamente. No entanto, como um upload pode submeter o lote atual quando o
+ * buffer circular está cheio e a fila de transferência pode ser a própria fila gráfica, as submissões devem partir
+ * da thread que submete os quadros.
+ *
+ */
+class TransferScheduler final {
+private:
+    std::shared_ptr<class Queue> transferQueue;
+
+    uint32 graphicsFamily;
+
+    struct VkCommandPool_T *pool;
+
+    std::shared_ptr<class Buffer> ring;
+
+    uint8 *ringMapping;
+
+    uint64 ringSize;
+
+    /* As posições de escrita e de liberação do buffer circular, que crescem monotonicamente. */
+    uint64 ringHead;
+
+    uint64 ringTail;
+
+    /* A soma dos tamanhos dos Buffers de staging dedicados que ainda aguardam a conclusão de seus lotes. */
+    uint64 oversizedSize;
+
+    TransferBatch recording;
+
+    std::deque<TransferBatch> inFlight;
+
+    std::vector<struct VkBufferMemoryBarrier> pendingBufferAcquires;
+
+    std::vector<struct VkImageMemoryBarrier> pendingImageAcquires;
+
+    std::vector<MipmapGeneration> pendingMipmaps;
+
+    std::vector<struct VkFence_T *> spareFences;
+
+    TransferTicket completedTicket;
+
+    std::mutex mutex;
+
+private:
+    explicit TransferScheduler();
+
+    Result<void> beginBatch();
+
+    Result<struct VkDevice_T *> getGraphicsDevice() const noexcept;
+
+    bool isOwnershipTransfer() const noexcept;
+
+    /**
+     * Grava em cmdBuffer os blits que geram cada nível de mipmap a partir do anterior, com filtro linear. Todos os
+     * níveis devem estar no layout SHADER_READ_ONLY_OPTIMAL e retornam a ele, e cmdBuffer deve pertencer a uma fila
+     * com suporte a operações gráficas, já que vkCmdBlitImage não é permitido em filas somente de transferência.
+     *
+     */
+    static void recordMipmaps(struct VkCommandBuffer_T *cmdBuffer, const MipmapGeneration &mipmap);
+
+    Result<uint8 *> reserveStaging(uint64 siz, struct VkBuffer_T **src, uint64 *off);
+
+    void retireBatches();
+
+    Result<void> submitBatch();
+
+    Result<void> waitOldestBatch();
+
+public:
+    ~TransferScheduler();
+
+    static Result<std::shared_ptr<TransferScheduler>> createTransferScheduler(std::shared_ptr<class Queue> queue,
+                                                                              uint32 graphicsFamily,
+                                                                              uint64 ringSize = DEFAULT_STAGING_RING_SIZE);
+
+    Result<void> flush();
+
+    /**
+     * Retorna quantos bytes de staging estão residentes no momento, ou seja, a porção ocupada do buffer circular
+     * somada aos Buffers dedicados, após devolver a memória dos lotes cujas fences já sinalizaram.
+     *
+     */
+    uint64 getStagingSize();
+
+    bool isComplete(TransferTicket ticket);
+
+    void recordAcquires(struct VkCommandBuffer_T *cmdBuffer);
+
+    /* Copia siz bytes de data para o Buffer dst a partir de off, que deve continuar vivo até a conclusão do ticket. */
+    Result<TransferTicket> uploadBuffer(const class Buffer &dst, uint64 off, const void *data, uint64 siz);
+
+    /* Copia siz bytes de data para a região do Image dst, deixando-o no layout SHADER_READ_ONLY_OPTIMAL. */
+    Result<TransferTicket> uploadImage(class Image &dst,
+                                       const void *data,
+                                       uint64 siz,
+                                       const struct VkBufferImageCopy &region);
+
+    /**
+     * Copia siz bytes de data de uma só vez e grava uma cópia por região, como os níveis de mipmap de um arquivo.
+     * Caso bGenerateMipmaps seja verdadeiro, as regiões devem preencher somente o nível base e os demais níveis de dst
+     * são gerados por blits, no próprio lote quando a fila de transferência é gráfica ou, caso contrário, pela fila
+     * gráfica em recordAcquires, logo após a aquisição do Image.
+     *
+     */
+    Result<TransferTicket> uploadImage(class Image &dst,
+                                       const void *data,
+                                       uint64 siz,
+                                       const struct VkBufferImageCopy *regions,
+                                       uint32 regionCount,
+                                       bool bGenerateMipmaps = false);
+
+    Result<void> wait(TransferTicket ticket);
+
+public:
+    TransferScheduler(const TransferScheduler &) = delete;
+    TransferScheduler(TransferScheduler &&) = delete;
+
+    TransferScheduler &operator=(const TransferScheduler &) = delete;
+    TransferScheduler &operator=(TransferScheduler &&) = delete;
+};
+
+#endif /* TRANSFERSCHEDULER_H_ */
@@ -0,0 +1,205 @@
+/**
+ * JobManager.h
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#ifndef JOBMANAGER_H_
+#define JOBMANAGER_H_
+
+#include "Result.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * A estrutura Job representa uma unidade de trabalho que pode ser executada por qualquer thread do JobManager. Cada
+ * Job guarda o número de dependências que ainda não foram concluídas e a lista de Jobs que dependem dele, de forma que
+ * um grafo de dependências possa ser montado antes da submissão.
+ *
+ * Os Jobs são manipulados somente através do tipo JobHandle, retornado pelos métodos do JobManager.
+ *
+ */
+struct Job {
+    std::function<void()> work;
+
+    /* O número de dependências pendentes, incluindo a própria submissão. O Job é enfileirado quando chega a zero. */
+    std::atomic<uint32> pendingDependencies;
+
+    std::atomic<bool> bFinished;
+
+    /* O mutex que protege a lista de continuações contra a conclusão concorrente do Job. */
+    std::mutex continuationMutex;
+
+    std::vector<std::shared_ptr<Job>> continuations;
+};
+
+typedef std::shared_ptr<Job> JobHandle;
+
+/**
+ * A estrutura JobQueue representa a fila de trabalho de uma das threads do JobManager. A thread dona da fila insere
+ * e remove Jobs pelo final, enquanto as outras threads roubam Jobs pelo início quando suas próprias filas estiverem
+ * vazias.
+ *
+ */
+struct JobQueue {
+    std::mutex mutex;
+
+    std::deque<JobHandle> jobs;
+};
+
+/**
+ * O JobManager é a classe que gerencia o sistema de tarefas da Real Engine. Suas principais funcionalidades são as
+ * seguintes:
+ *      1. Manter um conjunto de threads, uma para cada núcleo disponível além da thread principal, que executam os
+ *  Jobs submetidos pelos outros subsistemas;
+ *      2. Distribuir o trabalho através de roubo de tarefas (work stealing), onde cada thread possui sua própria fila
+ *  e, quando esta estiver vazia, rouba Jobs das filas das outras threads;
+ *      3. Permitir a construção de grafos de dependências entre Jobs, de forma que um Job só seja executado após a
+ *  conclusão de todos aqueles dos quais depende.
+ *
+ * A thread que aguarda a conclusão de um Job através do método wait também executa Jobs enquanto espera, portanto a
+ * thread principal participa do trabalho em vez de ficar ociosa.
+ *
+ * A classe JobManager necessita aplicar a regra dos 5 em C++, efetuando a deletação dos seguintes métodos:
+ *      1. O construtor padrão que permite a criação de objetos resetados;
+ *      2. O construtor de cópia que permite copiar outros objetos do mesmo tipo;
+ *      3. O construtor de movimento que permite incorporar outros objetos através da std::move;
+ *      4. O operador de atribuição que permite copiar outros objetos do mesmo tipo;
+ *      5. O operador de atribuição que permite incorporar outros objetos através da std::move.
+ *
+ */
+class JobManager final {
+private:
+    std::vector<std::thread> workers;
+
+    /* As filas de trabalho, uma por thread do JobManager e uma adicional para a thread principal. */
+    std::vector<std::unique_ptr<JobQueue>> queues;
+
+    /* O contador utilizado para distribuir os Jobs submetidos por threads externas entre as filas. */
+    std::atomic<uint32> nextQueue;
+
+    /* O número de Jobs enfileirados e ainda não retirados das filas, utilizado para adormecer threads ociosas. */
+    std::atomic<uint32> queuedJobs;
+
+    std::mutex sleepMutex;
+
+    std::condition_variable jobAvailable;
+
+    bool bStopWorkers;
+
+private:
+    /**
+     * O construtor padrão de JobManager e que não pode ser utilizado. O seu único objetivo é resetar os valores dos
+     * atributos de tal maneira que eles possam ser setados apropriadamente no método startup.
+     *
+     */
+    explicit JobManager();
+
+    ~JobManager();
+
+    /**
+     * O método auxiliar enqueue insere um Job cujas dependências já foram todas concluídas na fila da thread atual,
+     * ou em uma das filas escolhida de forma circular caso a thread atual não pertença ao JobManager, e acorda uma
+     * thread ociosa.
+     *
+     */
+    void enqueue(JobHandle job);
+
+    /**
+     * O método auxiliar execute roda o trabalho de um Job, marca-o como concluído e enfileira as continuações cujas
+     * dependências tenham sido todas satisfeitas.
+     *
+     */
+    void execute(const JobHandle &job);
+
+    /**
+     * O método auxiliar findJob procura um Job para a thread de índice queueIndex, primeiro no final de sua própria
+     * fila e depois no início das filas das outras threads.
+     *
+     */
+    JobHandle findJob(uint32 queueIndex);
+
+    void runWorker(uint32 queueIndex);
+
+public:
+    /**
+     * O método getManager tem como objetivo retornar uma referência para a instância única do JobManager, com a
+     * finalidade de que os seus métodos possam ser invocados de qualquer posição do código, até mesmo dentro
+     * de outros Managers.
+     *
+     */
+    inline static JobManager &getManager() noexcept {
+        static JobManager inst;
+        return inst;
+    }
+
+    /**
+     * O método addDependency registra que o Job job só poderá ser executado após a conclusão do Job dependency. Deve
+     * ser invocado antes da submissão de job, caso contrário a dependência não terá efeito.
+     *
+     */
+    void addDependency(const JobHandle &job, const JobHandle &dependency);
+
+    /**
+     * O método createJob cria um Job a partir da função especificada, sem submetê-lo. Desta forma, dependências podem
+     * ser adicionadas através do método addDependency antes da submissão pelo método submit.
+     *
+     */
+    JobHandle createJob(std::function<void()> work);
+
+    inline uint32 getWorkerCount() const noexcept { return static_cast<uint32>(this->workers.size()); }
+
+    /**
+     * O método parallelFor divide o intervalo [0, count) em partes de até grain elementos e submete um Job para
+     * cada parte, que invocará work com o início e o fim de sua parte. O Job retornado é concluído quando todas as
+     * partes tiverem sido executadas e, portanto, pode ser utilizado como dependência ou aguardado pelo método wait.
+     *
+     * As partes aguardam a conclusão do Job dependency, caso este seja especificado.
+     *
+     */
+    JobHandle parallelFor(uint32 count,
+                          uint32 grain,
+                          std::function<void(uint32, uint32)> work,
+                          const JobHandle &dependency = nullptr);
+
+    /**
+     * O método submit libera um Job criado pelo método createJob para execução, que ocorrerá assim que todas as suas
+     * dependências estiverem concluídas.
+     *
+     */
+    void submit(const JobHandle &job);
+
+    /**
+     * O método wait bloqueia a thread atual até a conclusão do Job especificado, executando outros Jobs enquanto
+     * espera.
+     *
+     */
+    void wait(const JobHandle &job);
+
+    /**
+     * O método startup cria as threads do JobManager e deve ser invocado antes de qualquer outro subsistema submeter
+     * Jobs.
+     *
+     */
+    Result<void> startup();
+
+    /**
+     * O método shutdown finaliza as threads do JobManager e deve ser invocado após os outros subsistemas terem
+     * aguardado todos os Jobs que submeteram.
+     *
+     */
+    void shutdown();
+
+public:
+    JobManager(const JobManager &) = delete;
+    JobManager(JobManager &&) = delete;
+
+    JobManager &operator=(const JobManager &) = delete;
+    JobManager &operator=(JobManager &&) = delete;
+};
+
+#endif /* JOBMANAGER_H_ */
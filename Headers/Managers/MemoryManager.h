@@ -8,8 +8,133 @@
 #ifndef MEMORYMANAGER_H_
 #define MEMORYMANAGER_H_
 
+#include "Memory.h"
 #include "Result.h"
 
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* O tamanho padrão dos blocos de memória de vídeo administrados por TlsfAllocators. */
+const uint64 DEFAULT_DEVICE_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+/* O tempo padrão, em segundos, que um alocador sem regiões distribuídas permanece vivo antes de ser eliminado. */
+const real64 DEFAULT_ALLOCATOR_IDLE_TIME = 5.0;
+
+/* A fração do tamanho de cada heap do dispositivo físico que a Real Engine se permite alocar por padrão. */
+const real64 DEFAULT_HEAP_BUDGET_FRACTION = 0.8;
+
+/* O tamanho máximo, em bytes, de um recurso distribuído por um PoolAllocator em vez de um bloco TlsfAllocator. */
+const uint64 MAX_POOL_CHUNK_SIZE = 64ull * 1024;
+
+/* O índice especial que indica ao MemoryManager que a operação se aplica a todas as heaps. */
+const uint32 ALL_MEMORY_HEAPS = ~0u;
+
+/**
+ * A estrutura PoolKey identifica um PoolAllocator pelas propriedades de seus pedaços, de forma que cada combinação de
+ * alinhamento, tamanho, propriedades e tipo de memória seja atendida por um único PoolAllocator.
+ *
+ */
+struct PoolKey {
+    uint64 alignment;
+
+    uint64 chunkSize;
+
+    uint32 flags;
+
+    /* O tipo de memória escolhido entre os aceitos pelo recurso, antes que qualquer bloco seja alocado. */
+    uint32 memoryType;
+
+    inline bool operator==(const PoolKey &other) const noexcept {
+        return alignment == other.alignment && chunkSize == other.chunkSize && flags == other.flags &&
+               memoryType == other.memoryType;
+    }
+};
+
+struct PoolKeyHash {
+    inline size_t operator()(const PoolKey &key) const noexcept {
+        size_t hash = std::hash<uint64>()(key.alignment);
+
+        hash ^= std::hash<uint64>()(key.chunkSize) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32>()(key.flags) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32>()(key.memoryType) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+/* As estatísticas de um único alocador, seja ele um bloco de um TlsfAllocator ou um PoolAllocator inteiro. */
+struct AllocatorStats {
+    /* "tlsf", "pool" ou "linear". */
+    const utf8 *kind;
+
+    uint32 memoryType;
+
+    uint32 blockCount;
+
+    uint64 reservedSize;
+
+    uint64 usedSize;
+
+    uint64 peakUsedSize;
+
+    uint64 allocationCount;
+
+    uint64 totalAllocationCount;
+
+    /* O tamanho e a ocupação dos pedaços, preenchidos somente para PoolAllocators. */
+    uint64 chunkSize;
+
+    uint64 chunkCount;
+
+    uint64 usedChunks;
+};
+
+/* As estatísticas somadas de todos os alocadores de um mesmo tipo de memória. */
+struct MemoryTypeStats {
+    uint32 heapIndex;
+
+    uint32 propertyFlags;
+
+    uint32 blockCount;
+
+    uint64 reservedSize;
+
+    uint64 usedSize;
+
+    uint64 allocationCount;
+};
+
+/* As estatísticas de uma heap do dispositivo físico, incluindo o maior volume de blocos que ela já sustentou. */
+struct HeapStats {
+    uint64 heapSize;
+
+    uint64 budget;
+
+    uint32 blockCount;
+
+    uint64 reservedSize;
+
+    uint64 peakReservedSize;
+
+    uint64 usedSize;
+
+    uint64 allocationCount;
+};
+
+/**
+ * A estrutura MemoryStats é uma fotografia do subsistema de memória, indexada por heap, por tipo de memória e por
+ * alocador. O espaço desperdiçado de cada nível é a diferença entre reservedSize e usedSize.
+ *
+ */
+struct MemoryStats {
+    std::vector<HeapStats> heaps;
+
+    std::vector<MemoryTypeStats> memoryTypes;
+
+    std::vector<AllocatorStats> allocators;
+};
+
 /**
  * O MemoryManager é a classe que gerencia o subsistema de memória. Suas principais funcionalidades são as seguintes:
  *      1. Gerenciar os diversos alocadores e seus tipos, sendo capaz de providenciar os alocadores adequados quando
@@ -29,11 +154,44 @@
  */
 class MemoryManager final {
 private:
-    std::forward_list<std::shared_ptr<class PoolAllocator>> allocatorList;
+    /* O tempo, em segundos, que um alocador sem regiões distribuídas permanece vivo antes de ser eliminado. */
+    real64 allocatorIdleTime;
+
+    /* Os PoolAllocators, um para cada combinação de propriedades de pedaços, que crescem conforme necessário. */
+    std::unordered_map<PoolKey, std::shared_ptr<class PoolAllocator>, PoolKeyHash> poolAllocators;
+
+    /* Os blocos de memória de vídeo compartilhados por recursos de tamanhos variados, um ou mais por tipo de memória. */
+    std::forward_list<std::shared_ptr<class TlsfAllocator>> blockAllocatorList;
+
+    /* O atributo que guarda a granularidade exigida entre Buffers e Images otimizados que compartilham um mesmo
+     * bloco de memória. */
+    uint64 bufferImageGranularity;
+
+    /* Os LinearAllocators criados através de requestLinearAllocator, referenciados apenas para as estatísticas, já
+     * que pertencem a quem os requisitou. */
+    std::vector<std::weak_ptr<class LinearAllocator>> linearAllocators;
+
+    /* O bloco que o Defragmenter está esvaziando e que, portanto, não deve receber novas regiões. */
+    const class TlsfAllocator *evacuatedAllocator;
+
+    /* Os orçamentos, em bytes, de cada heap do dispositivo físico, que os blocos de memória não podem ultrapassar. */
+    std::vector<uint64> heapBudgets;
+
+    /* A soma dos tamanhos dos blocos de memória alocados atualmente em cada heap do dispositivo físico. */
+    std::vector<uint64> heapUsages;
+
+    /* O maior valor que heapUsages já atingiu em cada heap do dispositivo físico. */
+    std::vector<uint64> heapPeaks;
 
     /* O atributo que guarda as propriedades da memória do dispositivo físico escolhido para rodar a aplicação. */
     std::unique_ptr<struct VkPhysicalDeviceMemoryProperties> memoryProperties;
 
+    /* O atributo que guarda o tamanho mínimo, em bytes, das regiões que podem ser sincronizadas entre host e
+     * dispositivo em memórias que não sejam coerentes. */
+    uint64 nonCoherentAtomSize;
+
+    std::mutex mutex;
+
 private:
     /**
      * O construtor padrão de MemoryManager e que não pode ser utilizado. O seu único objetivo é resetar os valores dos
@@ -44,6 +202,20 @@ private:
 
     ~MemoryManager();
 
+    /* Soma siz bytes ao uso da heap heapIndex, atualizando o pico registrado. */
+    void addHeapUsage(uint32 heapIndex, uint64 siz) noexcept;
+
+    /**
+     * O método auxiliar checkHeapBudget verifica se um novo bloco de siz bytes no tipo de memória memoryType cabe no
+     * orçamento de sua heap. Caso não caiba, os alocadores vazios daquela heap são eliminados imediatamente,
+     * independente do tempo ocioso, e, se ainda assim não houver espaço, o erro DeviceMemoryBudgetExceeded é
+     * retornado.
+     *
+     */
+    Result<void> checkHeapBudget(uint32 memoryType, uint64 siz) noexcept;
+
+    uint32 getHeapIndex(uint32 memoryType) const noexcept;
+
     /**
      * O método auxiliar getPhysicalDevice tem como objetivo adquirir o dispositivo físico da aplicação através da
      * API Vulkan.
@@ -65,6 +237,14 @@ private:
      */
     Result<void> getPhysicalDeviceMemoryProperties() noexcept;
 
+    /**
+     * O método auxiliar releaseAllocators elimina os alocadores da heap heapIndex, ou de todas as heaps caso seja
+     * ALL_MEMORY_HEAPS, que não possuam nenhuma região distribuída, não estejam referenciados por nenhum outro
+     * objeto e cujo último uso tenha ocorrido antes de idleSince, devolvendo seus blocos ao dispositivo.
+     *
+     */
+    void releaseAllocators(std::chrono::steady_clock::time_point idleSince, uint32 heapIndex) noexcept;
+
 public:
     /**
      * O método getManager tem como objetivo retornar uma referência para a instância única do MemoryManager, com a
@@ -81,6 +261,59 @@ public:
         return inst;
     }
 
+    /**
+     * O método collectIdleAllocators elimina os alocadores que estejam vazios há mais tempo do que o tempo ocioso
+     * configurado, liberando a memória de vídeo que haviam alocado. Ele é invocado uma vez por quadro pelo
+     * WorldManager.
+     *
+     */
+    void collectIdleAllocators() noexcept;
+
+    /**
+     * O método dumpStats escreve em filename a fotografia retornada por getStats, serializada em JSON através de
+     * getStatsJson, para que o tamanho dos blocos e dos pools possa ser ajustado a partir de sessões reais.
+     *
+     */
+    Result<void> dumpStats(const utf8 *filename);
+
+    /**
+     * O método findSparseAllocator retorna o bloco de memória exclusiva do dispositivo com a menor fração de uso,
+     * desde que inferior a threshold e diferente de exclude, cujas regiões caibam no espaço livre dos demais blocos do
+     * mesmo tipo de memória, ou nullptr caso nenhum bloco valha a pena ser esvaziado.
+     *
+     * Os blocos dos PoolAllocators nunca são retornados: um pool esparso permanece com todos os seus blocos até que
+     * nenhuma de suas regiões esteja em uso, quando então é liberado por collectIdleAllocators.
+     *
+     */
+    std::shared_ptr<class TlsfAllocator> findSparseAllocator(real64 threshold,
+                                                             const class TlsfAllocator *exclude) noexcept;
+
+    /**
+     * O método getStats percorre todos os alocadores e retorna, de forma consistente, quantos blocos e bytes estão
+     * reservados e em uso em cada heap, em cada tipo de memória e em cada alocador, junto com as contagens de
+     * alocações e os picos de uso.
+     *
+     * Os PoolAllocators reservam espaço nas heaps enquanto seguram seu próprio mutex, portanto são consultados
+     * somente após o mutex do MemoryManager ser liberado, e seus números podem estar um pouco à frente dos demais.
+     *
+     */
+    MemoryStats getStats() noexcept;
+
+    std::string getStatsJson() noexcept;
+
+    /* Retorna o orçamento, em bytes, da heap heapIndex do dispositivo físico. */
+    uint64 getHeapBudget(uint32 heapIndex) const noexcept;
+
+    /* Retorna quantos bytes de blocos de memória estão alocados atualmente na heap heapIndex. */
+    uint64 getHeapUsage(uint32 heapIndex) const noexcept;
+
+    /**
+     * O método releaseHeapSpace devolve ao orçamento da heap de memoryType os siz bytes previamente reservados
+     * através de reserveHeapSpace, quando a alocação do bloco falha.
+     *
+     */
+    void releaseHeapSpace(uint32 memoryType, uint64 siz) noexcept;
+
     /**
      * O método getMemoryProperties tem como função retornar a estrutura VkPhysicalDeviceMemoryProperties que descreve
      * os tipos de memória e as heaps que existem no dispositivo físico escolhido pelo GraphicsManager
@@ -89,10 +322,105 @@ public:
      */
     Result<struct VkPhysicalDeviceMemoryProperties> getMemoryProperties() const noexcept;
 
+    /**
+     * O método getNonCoherentAtomSize retorna o alinhamento que as regiões passadas para vkFlushMappedMemoryRanges e
+     * vkInvalidateMappedMemoryRanges devem respeitar quando a memória não possui a propriedade HOST_COHERENT.
+     *
+     */
+    inline uint64 getNonCoherentAtomSize() const noexcept { return this->nonCoherentAtomSize; }
+
+    /**
+     * O método allocateMemory é a porta de entrada para Buffers e Images obterem memória de vídeo. Regiões de até
+     * MAX_POOL_CHUNK_SIZE bytes são distribuídas pelo PoolAllocator da menor classe de tamanho de potência de dois que
+     * as comporta, nunca menor que a granularidade entre Buffers e Images, de forma que recursos pequenos e numerosos,
+     * como os tiles, não fragmentem os blocos compartilhados. As demais regiões, ou as que o PoolAllocator não puder
+     * atender, são distribuídas através de allocateFromBlocks. O alocador de origem é guardado em allocator.
+     *
+     */
+    Result<Memory> allocateMemory(uint64 siz,
+                                  uint64 alignment,
+                                  uint32 memoryTypeBits,
+                                  uint32 flags,
+                                  std::shared_ptr<class Allocator> *allocator) noexcept;
+
+    /**
+     * O método allocateFromBlocks distribui uma região de siz bytes com alinhamento alignment em um tipo de memória
+     * permitido por memoryTypeBits e que possua as propriedades flags, guardando em allocator o TlsfAllocator de onde
+     * ela foi distribuída. Os blocos existentes são tentados em ordem e, caso nenhum deles tenha espaço, um novo bloco
+     * de DEFAULT_DEVICE_BLOCK_SIZE bytes, ou maior se a região exigir, é criado. A escolha do bloco e a distribuição
+     * ocorrem sob a mesma trava, de forma que outra thread nunca consuma o espaço entre as duas.
+     *
+     */
+    Result<Memory> allocateFromBlocks(uint64 siz,
+                                      uint64 alignment,
+                                      uint32 memoryTypeBits,
+                                      uint32 flags,
+                                      std::shared_ptr<class TlsfAllocator> *allocator) noexcept;
+
+    /**
+     * O método requestPoolAllocator retorna, em tempo constante, o único PoolAllocator cujos pedaços possuem as
+     * propriedades requisitadas, criando-o na primeira requisição. Os PoolAllocators crescem internamente, portanto
+     * o mesmo alocador é retornado mesmo quando todos os seus pedaços estão ocupados.
+     *
+     * O tipo de memória é escolhido entre os permitidos por memoryTypeBits antes que qualquer bloco seja alocado, de
+     * forma que nunca seja criado um PoolAllocator que o recurso requisitante não possa utilizar.
+     *
+     */
     Result<std::shared_ptr<class PoolAllocator>> requestPoolAllocator(uint64 alignment,
                                                                       uint64 chunkSize,
+                                                                      uint32 memoryTypeBits,
                                                                       uint32 flags) noexcept;
 
+    /**
+     * O método requestLinearAllocator cria um LinearAllocator com frameCount regiões de frameSize bytes, ligado a um
+     * VkBuffer com o uso usage, em um tipo de memória com as propriedades flags. Diferente dos demais alocadores, ele
+     * pertence exclusivamente a quem o requisitou e seu bloco é devolvido ao dispositivo quando ele é destruído.
+     *
+     */
+    Result<std::shared_ptr<class LinearAllocator>> requestLinearAllocator(uint64 frameSize,
+                                                                          uint32 frameCount,
+                                                                          uint32 usage,
+                                                                          uint32 flags) noexcept;
+
+    /**
+     * O método releaseEvacuatedAllocator devolve ao dispositivo o bloco marcado através de setEvacuatedAllocator assim
+     * que ele estiver vazio e não for mais referenciado, sem aguardar o tempo ocioso, e retorna se o bloco foi
+     * liberado.
+     *
+     */
+    bool releaseEvacuatedAllocator() noexcept;
+
+    /**
+     * O método requestRelocationTarget retorna um bloco já existente, do mesmo tipo de memória de source e ao menos
+     * tão ocupado quanto ele, capaz de receber uma região de siz bytes com alinhamento alignment. Nenhum bloco novo
+     * é criado, pois mover recursos para um bloco recém alocado não reduziria o uso de memória de vídeo.
+     *
+     */
+    Result<std::shared_ptr<class TlsfAllocator>> requestRelocationTarget(uint64 siz,
+                                                                         uint64 alignment,
+                                                                         const class TlsfAllocator &source) noexcept;
+
+    /**
+     * O método reserveHeapSpace é utilizado pelos alocadores que crescem após sua criação para reservar siz bytes no
+     * orçamento da heap de memoryType antes de alocarem um novo bloco, falhando com DeviceMemoryBudgetExceeded caso
+     * não haja espaço.
+     *
+     */
+    Result<void> reserveHeapSpace(uint32 memoryType, uint64 siz) noexcept;
+
+    void setAllocatorIdleTime(real64 seconds) noexcept;
+
+    /* Impede que allocateFromBlocks distribua novas regiões de alloc enquanto ele é esvaziado, ou libera o bloco
+     * anterior caso alloc seja nullptr. */
+    void setEvacuatedAllocator(const class TlsfAllocator *alloc) noexcept;
+
+    /**
+     * O método setHeapBudget substitui o orçamento padrão da heap heapIndex, calculado durante o startup como
+     * DEFAULT_HEAP_BUDGET_FRACTION do tamanho informado pelo dispositivo físico.
+     *
+     */
+    void setHeapBudget(uint32 heapIndex, uint64 budget) noexcept;
+
     /**
      * O método startup é fundamental e deve ser utilizado para inicializar o objeto do tipo MemoryManager antes de
      * qualquer tentativa de utilizar alocadores da Real Engine.
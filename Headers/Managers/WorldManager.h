@@ -10,10 +10,18 @@
 
 #include "Result.h"
 
+/* O número de quadros cuja média forma cada medida de getAverageFrameTime. */
+const uint32 FRAME_TIME_SAMPLES = 500;
+
 class WorldManager final {
 private:
     std::shared_ptr<class Renderer> renderer;
-    std::forward_list<std::shared_ptr<struct SpriteComponent>> components;
+    std::shared_ptr<class SpriteStorage> spriteStorage;
+    std::vector<std::shared_ptr<struct SpriteComponent>> components;
+
+    /* A média, em milissegundos, dos últimos FRAME_TIME_SAMPLES quadros de play, medida somente quando o projeto é
+     * configurado com REALENGINE_MEASURE_FRAME_TIME. */
+    real64 averageFrameTime;
 
 private:
     explicit WorldManager();
@@ -30,8 +38,13 @@ public:
         return inst;
     }
 
+    /* Retorna a média do tempo de quadro em milissegundos, ou zero caso a medida não tenha sido habilitada. */
+    inline real64 getAverageFrameTime() const noexcept { return this->averageFrameTime; }
+
     Result<std::shared_ptr<class Renderer>> getRenderer() const noexcept;
 
+    Result<std::shared_ptr<class SpriteStorage>> getSpriteStorage() const noexcept;
+
     Result<void> play(class Game *game);
 
     Result<void> startup();
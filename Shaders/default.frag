@@ -7,13 +7,23 @@
 
 #version 450 core
 
-layout (set = 0, binding = 1) uniform sampler2D textureSampler;
+#ifdef NONUNIFORM_INDEXING
+#extension GL_EXT_nonuniform_qualifier : require
+#define TEXTURE_INDEX(index) nonuniformEXT(index)
+#else
+#define TEXTURE_INDEX(index) (index)
+#endif
+
+layout (constant_id = 0) const uint TEXTURE_CAPACITY = 16;
+
+layout (set = 0, binding = 1) uniform sampler2D textureSamplers[TEXTURE_CAPACITY];
 
 layout (location = 0) in vec3 fragColor;
 layout (location = 1) in vec2 fragTexCoords;
+layout (location = 2) flat in uint fragTextureIndex;
 
 layout (location = 0) out vec4 outColor;
 
 void main() {
-    outColor = texture(textureSampler, fragTexCoords);
+    outColor = texture(textureSamplers[TEXTURE_INDEX(fragTextureIndex)], fragTexCoords);
 }
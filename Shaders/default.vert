@@ -8,7 +8,6 @@
 #version 450 core
 
 layout(set = 0, binding = 0) uniform transforms {
-    mat4 model;
     mat4 view;
     mat4 proj;
 } transform;
@@ -16,19 +15,31 @@ layout(set = 0, binding = 0) uniform transforms {
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 color;
 layout (location = 2) in vec2 texCoords;
+layout (location = 3) in vec4 basis;
+layout (location = 4) in vec2 translation;
+layout (location = 5) in uint textureIndex;
+layout (location = 6) in vec4 uvRect;
 
 layout (location = 0) out vec3 fragColor;
 layout (location = 1) out vec2 fragTexCoords;
+layout (location = 2) flat out uint fragTextureIndex;
 
 out gl_PerVertex {
     vec4 gl_Position;
 };
 
 void main() {
+    // Expand Packed 2D Affine Transform
+    mat4 model = mat4(vec4(basis.xy, 0.0, 0.0),
+                      vec4(basis.zw, 0.0, 0.0),
+                      vec4(0.0, 0.0, 1.0, 0.0),
+                      vec4(translation, 0.0, 1.0));
+
     // Set Vertex Position
-    gl_Position = transform.proj * transform.view * transform.model * vec4(position, 1.0);
+    gl_Position = transform.proj * transform.view * model * vec4(position, 1.0);
 
-    // Pass To Fragment Shader
+    // Pass To Fragment Shader, Mapping Coordinates Into Sprite Region
     fragColor = color;
-    fragTexCoords = texCoords;
+    fragTexCoords = uvRect.xy + texCoords * uvRect.zw;
+    fragTextureIndex = textureIndex;
 }
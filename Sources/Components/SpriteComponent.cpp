@@ -5,10 +5,11 @@
  *
  */
 
-#include "Buffer.h"
-#include "Material.h"
 #include "SpriteComponent.h"
+#include "SpriteStorage.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
+#include "WorldManager.h"
 
 #include <vulkan/vulkan.h>
 
@@ -46,99 +47,70 @@ std::vector<VkVertexInputAttributeDescription> Vertex::getAttributeDescription()
     return vertexInputAttributeDescription;
 }
 
-SpriteComponent::SpriteComponent() {
-    this->position = glm::vec2(0.0f, 0.0f);
-    this->rotation = glm::angleAxis(glm::radians(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    this->scale = glm::vec2(1.0f, 1.0f);
-    this->texture = nullptr;
-    this->vertexBuffer = nullptr;
-}
+VkVertexInputBindingDescription InstanceData::getBindingDescription() noexcept {
+    VkVertexInputBindingDescription instanceInputBindingDescription = {};
 
-std::vector<Vertex> SpriteComponent::getVertexData() const noexcept {
-    std::vector<Vertex> vertexData (6);
+    instanceInputBindingDescription.binding = 1;
+    instanceInputBindingDescription.stride = sizeof(InstanceData);
+    instanceInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-    // Configure 1st Vertex
-    vertexData[0].position = glm::vec3(-16.0f, 16.0f, 0.0f);
-    vertexData[0].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[0].texCoords = glm::vec2(0.0f, 0.0f);
+    return instanceInputBindingDescription;
+}
 
-    // Configure 2nd Vertex
-    vertexData[1].position = glm::vec3(16.0f, 16.0f, 0.0f);
-    vertexData[1].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[1].texCoords = glm::vec2(1.0f, 0.0f);
+std::vector<VkVertexInputAttributeDescription> InstanceData::getAttributeDescription() noexcept {
+    std::vector<VkVertexInputAttributeDescription> instanceInputAttributeDescription (4);
 
-    // Configure 3rd Vertex
-    vertexData[2].position = glm::vec3(16.0f, -16.0f, 0.0f);
-    vertexData[2].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[2].texCoords = glm::vec2(1.0f, 1.0f);
+    // Configure Affine Basis
+    instanceInputAttributeDescription[0].binding = 1;
+    instanceInputAttributeDescription[0].location = 3;
+    instanceInputAttributeDescription[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    instanceInputAttributeDescription[0].offset = static_cast<uint32>(offsetof(InstanceData, basis));
 
-    // Configure 4th Vertex
-    vertexData[3].position = glm::vec3(-16.0f, 16.0f, 0.0f);
-    vertexData[3].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[3].texCoords = glm::vec2(0.0f, 0.0f);
+    // Configure Translation
+    instanceInputAttributeDescription[1].binding = 1;
+    instanceInputAttributeDescription[1].location = 4;
+    instanceInputAttributeDescription[1].format = VK_FORMAT_R32G32_SFLOAT;
+    instanceInputAttributeDescription[1].offset = static_cast<uint32>(offsetof(InstanceData, translation));
 
-    // Configure 5th Vertex
-    vertexData[4].position = glm::vec3(16.0f, -16.0f, 0.0f);
-    vertexData[4].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[4].texCoords = glm::vec2(1.0f, 1.0f);
+    // Configure Texture Index
+    instanceInputAttributeDescription[2].binding = 1;
+    instanceInputAttributeDescription[2].location = 5;
+    instanceInputAttributeDescription[2].format = VK_FORMAT_R32_UINT;
+    instanceInputAttributeDescription[2].offset = static_cast<uint32>(offsetof(InstanceData, textureIndex));
 
-    // Configure 6th Vertex
-    vertexData[5].position = glm::vec3(-16.0f, -16.0f, 0.0f);
-    vertexData[5].color = glm::vec3(1.0f, 1.0f, 1.0f);
-    vertexData[5].texCoords = glm::vec2(0.0f, 1.0f);
+    // Configure Texture Region
+    instanceInputAttributeDescription[3].binding = 1;
+    instanceInputAttributeDescription[3].location = 6;
+    instanceInputAttributeDescription[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    instanceInputAttributeDescription[3].offset = static_cast<uint32>(offsetof(InstanceData, uvRect));
 
-    return vertexData;
+    return instanceInputAttributeDescription;
 }
 
-Result<void> SpriteComponent::setupVertexBuffer() {
-    Result<std::shared_ptr<Buffer>> result = Buffer::createBuffer(6 * sizeof(Vertex),
-                                                                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-
-    if (!result.hasError()) {
-        this->vertexBuffer = static_cast<std::shared_ptr<Buffer>>(result);
-        std::vector<Vertex> vertexData = this->getVertexData();
-
-        Result<void> rslt = this->vertexBuffer->fillBuffer(static_cast<uint64>(vertexData.size()) * sizeof(Vertex),
-                                                           vertexData.data());
-        if (!rslt.hasError()) {
-            return Result<void>::createError(Error::None);
-        }
-        else {
-            return Result<void>::createError(rslt.getError());
-        }
-    }
-
-    return Result<void>::createError(result.getError());
+SpriteComponent::SpriteComponent() {
+    this->storage = nullptr;
+    this->handle = SpriteHandle {};
 }
 
 SpriteComponent::~SpriteComponent() {
-    this->texture.reset();
-    this->vertexBuffer.reset();
+    if (this->storage != nullptr) {
+        this->storage->destroySprite(this->handle);
+    }
+
+    this->storage.reset();
 }
 
 glm::mat4 SpriteComponent::getModelTransform() const noexcept {
-    glm::mat4 translate = glm::translate(glm::mat4(1.0f), glm::vec3(this->position.x, this->position.y, 0.0f));
-    glm::mat4 rotate = glm::mat4_cast(this->rotation);
-    glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(this->scale.x, this->scale.y, 1.0f));
-
-    return translate * rotate * scale;
+    return this->storage->getModelTransform(this->storage->getIndex(this->handle));
 }
 
 std::shared_ptr<Texture> SpriteComponent::getTexture() const noexcept {
-    return this->texture;
-}
-
-std::shared_ptr<Buffer> SpriteComponent::getVertexBuffer() const noexcept {
-    return this->vertexBuffer;
+    uint32 index = this->storage->getIndex(this->handle);
+    return this->storage->getTextures()[this->storage->getTextureIds()[index]];
 }
 
-Result<void> SpriteComponent::load() {
-    Result<void> vertexResult = this->setupVertexBuffer();
-    if (vertexResult.hasError()) {
-        return Result<void>::createError(vertexResult.getError());
-    }
-
-    return Result<void>::createError(Error::None);
+glm::vec4 SpriteComponent::getUvRect() const noexcept {
+    return this->storage->getUvRects()[this->storage->getIndex(this->handle)];
 }
 
 void SpriteComponent::begin() {
@@ -150,38 +122,80 @@ void SpriteComponent::update() {
 }
 
 void SpriteComponent::move(float dx, float dy) {
-    this->position.x += dx;
-    this->position.y += dy;
+    uint32 index = this->storage->getIndex(this->handle);
+    glm::vec2 &position = this->storage->getPositions()[index];
+
+    position.x += dx;
+    position.y += dy;
+    this->storage->markDirty(index);
 }
 
 void SpriteComponent::rotate(float angle) {
-    this->rotation += glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
+    uint32 index = this->storage->getIndex(this->handle);
+
+    this->storage->getRotations()[index] += glm::radians(angle);
+    this->storage->markDirty(index);
 }
 
 void SpriteComponent::resize(float dx, float dy) {
-    this->scale.x *= dx;
-    this->scale.y *= dy;
+    uint32 index = this->storage->getIndex(this->handle);
+    glm::vec2 &scale = this->storage->getScales()[index];
+
+    scale.x *= dx;
+    scale.y *= dy;
+    this->storage->markDirty(index);
 }
 
 void SpriteComponent::setPosition(float x, float y) {
-    this->position.x = x;
-    this->position.y = y;
+    uint32 index = this->storage->getIndex(this->handle);
+    glm::vec2 &position = this->storage->getPositions()[index];
+
+    position.x = x;
+    position.y = y;
+    this->storage->markDirty(index);
 }
 
 void SpriteComponent::setRotation(float angle) {
-    this->rotation = glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
+    uint32 index = this->storage->getIndex(this->handle);
+
+    this->storage->getRotations()[index] = glm::radians(angle);
+    this->storage->markDirty(index);
 }
 
 Result<std::shared_ptr<SpriteComponent>> SpriteComponent::createSpriteComponent(glm::vec2 pos,
                                                                                 glm::quat rot,
                                                                                 glm::vec2 sc,
                                                                                 std::shared_ptr<Texture> txt) {
-    std::shared_ptr<SpriteComponent> spriteComponent(new SpriteComponent);
+    AtlasRegion region = {};
 
-    spriteComponent->position = pos;
-    spriteComponent->rotation = rot;
-    spriteComponent->scale = sc;
-    spriteComponent->texture = std::move(txt);
+    // Whole Texture Is Single Region
+    region.texture = std::move(txt);
+    region.uvRect = FULL_UV_RECT;
+
+    return SpriteComponent::createSpriteComponent(pos, rot, sc, region);
+}
+
+Result<std::shared_ptr<SpriteComponent>> SpriteComponent::createSpriteComponent(glm::vec2 pos,
+                                                                                glm::quat rot,
+                                                                                glm::vec2 sc,
+                                                                                const AtlasRegion &region) {
+    WorldManager &worldManager = WorldManager::getManager();
+    Result<std::shared_ptr<SpriteStorage>> result = worldManager.getSpriteStorage();
+
+    if (!result.hasError()) {
+        std::shared_ptr<SpriteComponent> spriteComponent(new SpriteComponent);
+        spriteComponent->storage = static_cast<std::shared_ptr<SpriteStorage>>(result);
+
+        Result<SpriteHandle> rslt = spriteComponent->storage->createSprite(pos, rot, sc, region.texture, region.uvRect);
+        if (!rslt.hasError()) {
+            spriteComponent->handle = static_cast<SpriteHandle>(rslt);
+            return Result<std::shared_ptr<SpriteComponent>>(spriteComponent);
+        }
+        else {
+            spriteComponent->storage.reset();
+            return Result<std::shared_ptr<SpriteComponent>>::createError(rslt.getError());
+        }
+    }
 
-    return Result<std::shared_ptr<SpriteComponent>>(spriteComponent);
+    return Result<std::shared_ptr<SpriteComponent>>::createError(result.getError());
 }
@@ -0,0 +1,219 @@
+/**
+ * SpriteStorage.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "SpriteStorage.h"
+#include "Texture.h"
+
+#include <algorithm>
+
+SpriteStorage::SpriteStorage() {
+    this->sparse = std::vector<uint32>();
+    this->generations = std::vector<uint32>();
+    this->freeSlots = std::vector<uint32>();
+    this->owners = std::vector<uint32>();
+    this->layoutVersion = 0;
+    this->textureVersion = 0;
+}
+
+uint32 SpriteStorage::registerTexture(std::shared_ptr<Texture> texture) {
+    auto it = this->textureLookup.find(texture.get());
+
+    if (it == this->textureLookup.end()) {
+        auto id = static_cast<uint32>(this->textures.size());
+
+        it = this->textureLookup.emplace(texture.get(), id).first;
+        this->textures.push_back(std::move(texture));
+        this->textureReferences.push_back(0);
+    }
+
+    this->textureReferences[it->second]++;
+    return it->second;
+}
+
+void SpriteStorage::releaseTexture(uint32 id) {
+    if (--this->textureReferences[id] > 0) {
+        return;
+    }
+
+    auto last = static_cast<uint32>(this->textures.size()) - 1;
+
+    this->textureLookup.erase(this->textures[id].get());
+    this->retiredTextures.push_back(std::move(this->textures[id]));
+
+    // Last Texture Takes Freed Id, So Ids Stay Contiguous
+    if (id != last) {
+        this->textures[id] = std::move(this->textures[last]);
+        this->textureReferences[id] = this->textureReferences[last];
+        this->textureLookup[this->textures[id].get()] = id;
+
+        for (uint32 i = 0; i < static_cast<uint32>(this->textureIds.size()); i++) {
+            if (this->textureIds[i] == last) {
+                this->textureIds[i] = id;
+                this->markDirty(i);
+            }
+        }
+    }
+
+    this->textures.pop_back();
+    this->textureReferences.pop_back();
+    this->textureVersion++;
+}
+
+SpriteStorage::~SpriteStorage() {
+    this->textureLookup.clear();
+    this->textureReferences.clear();
+    this->textures.clear();
+    this->retiredTextures.clear();
+}
+
+Result<std::shared_ptr<SpriteStorage>> SpriteStorage::createSpriteStorage() {
+    std::shared_ptr<SpriteStorage> storage(new SpriteStorage);
+
+    return Result<std::shared_ptr<SpriteStorage>>(storage);
+}
+
+Result<SpriteHandle> SpriteStorage::createSprite(glm::vec2 pos,
+                                                 glm::quat rot,
+                                                 glm::vec2 sc,
+                                                 std::shared_ptr<Texture> txt,
+                                                 glm::vec4 uvRect) {
+    SpriteHandle handle = {};
+
+    // Reuse Free Slot Or Grow Sparse Array
+    if (!this->freeSlots.empty()) {
+        handle.index = this->freeSlots.back();
+        this->freeSlots.pop_back();
+    }
+    else {
+        handle.index = static_cast<uint32>(this->sparse.size());
+        this->sparse.push_back(0);
+        this->generations.push_back(0);
+    }
+
+    handle.generation = this->generations[handle.index];
+    this->sparse[handle.index] = static_cast<uint32>(this->owners.size());
+
+    // Append Dense Data
+    this->owners.push_back(handle.index);
+    this->positions.push_back(pos);
+    this->rotations.push_back(glm::roll(rot));
+    this->scales.push_back(sc);
+    this->textureIds.push_back(this->registerTexture(std::move(txt)));
+    this->uvRects.push_back(uvRect);
+    this->dirtyMasks.push_back(SPRITE_DIRTY_ALL_FRAMES);
+    this->layoutVersion++;
+
+    return Result<SpriteHandle>(handle);
+}
+
+void SpriteStorage::destroySprite(SpriteHandle handle) {
+    if (!this->isValid(handle)) {
+        return;
+    }
+
+    uint32 index = this->sparse[handle.index];
+    uint32 last = static_cast<uint32>(this->owners.size()) - 1;
+    uint32 textureId = this->textureIds[index];
+
+    // Move Last Sprite Into Removed Position
+    this->owners[index] = this->owners[last];
+    this->positions[index] = this->positions[last];
+    this->rotations[index] = this->rotations[last];
+    this->scales[index] = this->scales[last];
+    this->textureIds[index] = this->textureIds[last];
+    this->uvRects[index] = this->uvRects[last];
+    this->dirtyMasks[index] = SPRITE_DIRTY_ALL_FRAMES;
+    this->sparse[this->owners[index]] = index;
+
+    this->owners.pop_back();
+    this->positions.pop_back();
+    this->rotations.pop_back();
+    this->scales.pop_back();
+    this->textureIds.pop_back();
+    this->uvRects.pop_back();
+    this->dirtyMasks.pop_back();
+
+    // Invalidate Outstanding Handles
+    this->generations[handle.index]++;
+    this->freeSlots.push_back(handle.index);
+    this->layoutVersion++;
+
+    this->releaseTexture(textureId);
+}
+
+std::vector<std::shared_ptr<Texture>> SpriteStorage::takeRetiredTextures() noexcept {
+    std::vector<std::shared_ptr<Texture>> retired;
+
+    retired.swap(this->retiredTextures);
+    return retired;
+}
+
+void SpriteStorage::markAllDirty() noexcept {
+    std::fill(this->dirtyMasks.begin(), this->dirtyMasks.end(), SPRITE_DIRTY_ALL_FRAMES);
+}
+
+bool SpriteStorage::isValid(SpriteHandle handle) const noexcept {
+    return handle.index < this->generations.size() && this->generations[handle.index] == handle.generation;
+}
+
+glm::mat4 SpriteStorage::getModelTransform(uint32 index) const noexcept {
+    glm::mat4 translate = glm::translate(glm::mat4(1.0f),
+                                         glm::vec3(this->positions[index].x, this->positions[index].y, 0.0f));
+    glm::mat4 rotate = glm::rotate(glm::mat4(1.0f), this->rotations[index], glm::vec3(0.0f, 0.0f, 1.0f));
+    glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(this->scales[index].x, this->scales[index].y, 1.0f));
+
+    return translate * rotate * scale;
+}
+
+void SpriteStorage::sortByTexture() {
+    auto count = static_cast<uint32>(this->owners.size());
+    std::vector<uint32> offsets(this->textures.size() + 1, 0);
+    std::vector<uint32> order(count);
+
+    // Count Sprites Per Texture
+    for (uint32 i = 0; i < count; i++) {
+        offsets[this->textureIds[i] + 1]++;
+    }
+
+    for (uint32 i = 1; i < offsets.size(); i++) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Compute Stable Destination Of Each Sprite
+    for (uint32 i = 0; i < count; i++) {
+        order[offsets[this->textureIds[i]]++] = i;
+    }
+
+    std::vector<uint32> owners(count);
+    std::vector<glm::vec2> positions(count);
+    std::vector<float> rotations(count);
+    std::vector<glm::vec2> scales(count);
+    std::vector<uint32> textureIds(count);
+    std::vector<glm::vec4> uvRects(count);
+    std::vector<uint8> dirtyMasks(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        uint32 source = order[i];
+
+        owners[i] = this->owners[source];
+        positions[i] = this->positions[source];
+        rotations[i] = this->rotations[source];
+        scales[i] = this->scales[source];
+        textureIds[i] = this->textureIds[source];
+        uvRects[i] = this->uvRects[source];
+        dirtyMasks[i] = source != i ? SPRITE_DIRTY_ALL_FRAMES : this->dirtyMasks[source];
+        this->sparse[owners[i]] = i;
+    }
+
+    this->owners.swap(owners);
+    this->positions.swap(positions);
+    this->rotations.swap(rotations);
+    this->scales.swap(scales);
+    this->textureIds.swap(textureIds);
+    this->uvRects.swap(uvRects);
+    this->dirtyMasks.swap(dirtyMasks);
+}
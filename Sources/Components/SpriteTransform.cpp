@@ -0,0 +1,264 @@
+/**
+ * SpriteTransform.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "SpriteComponent.h"
+#include "SpriteTransform.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SPRITE_TRANSFORM_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPRITE_TRANSFORM_SSE2
+#endif
+
+/* As constantes do seno e do cosseno de precisão simples da Cephes, que se mantêm precisos para ângulos de até alguns
+ * milhares de radianos. */
+const float SINCOS_FOUR_OVER_PI = 1.27323954473516f;
+const float SINCOS_DP1 = -0.78515625f;
+const float SINCOS_DP2 = -2.4187564849853515625e-4f;
+const float SINCOS_DP3 = -3.77489497744594108e-8f;
+const float SINCOS_COS0 = 2.443315711809948e-5f;
+const float SINCOS_COS1 = -1.388731625493765e-3f;
+const float SINCOS_COS2 = 4.166664568298827e-2f;
+const float SINCOS_SIN0 = -1.9515295891e-4f;
+const float SINCOS_SIN1 = 8.3321608736e-3f;
+const float SINCOS_SIN2 = -1.6666654611e-1f;
+
+static inline void writeTransform(InstanceData &instance,
+                                  const glm::vec2 &position,
+                                  float sine,
+                                  float cosine,
+                                  const glm::vec2 &scale) noexcept {
+    instance.basis = glm::vec4(cosine * scale.x, sine * scale.x, -sine * scale.y, cosine * scale.y);
+    instance.translation = position;
+}
+
+void buildSpriteTransformsScalar(const glm::vec2 *positions,
+                                 const float *rotations,
+                                 const glm::vec2 *scales,
+                                 uint32 count,
+                                 InstanceData *instances) noexcept {
+    for (uint32 i = 0; i < count; i++) {
+        writeTransform(instances[i], positions[i], std::sin(rotations[i]), std::cos(rotations[i]), scales[i]);
+    }
+}
+
+#if defined(SPRITE_TRANSFORM_SSE2)
+
+static inline void sincos4(__m128 x, __m128 *sine, __m128 *cosine) noexcept {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32>(0x80000000)));
+    __m128 signSin = _mm_and_ps(x, signMask);
+
+    // Reduce To Octant Of [-Pi/4, Pi/4]
+    x = _mm_andnot_ps(signMask, x);
+    __m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(SINCOS_FOUR_OVER_PI)));
+    octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(octant);
+
+    __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+    __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+            _mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)),
+                                                       _mm_setzero_si128()));
+    signSin = _mm_xor_ps(signSin, swapSin);
+
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(SINCOS_DP1)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(SINCOS_DP2)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(SINCOS_DP3)));
+    __m128 z = _mm_mul_ps(x, x);
+
+    // Evaluate Both Polynomials
+    __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SINCOS_COS0), z), _mm_set1_ps(SINCOS_COS1));
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(SINCOS_COS2));
+    cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+    cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+    __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SINCOS_SIN0), z), _mm_set1_ps(SINCOS_SIN1));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SINCOS_SIN2));
+    sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+    // Select Polynomial By Octant And Restore Signs
+    __m128 s = _mm_or_ps(_mm_and_ps(polyMask, sinPoly), _mm_andnot_ps(polyMask, cosPoly));
+    __m128 c = _mm_or_ps(_mm_and_ps(polyMask, cosPoly), _mm_andnot_ps(polyMask, sinPoly));
+
+    *sine = _mm_xor_ps(s, signSin);
+    *cosine = _mm_xor_ps(c, signCos);
+}
+
+void buildSpriteTransforms(const glm::vec2 *positions,
+                           const float *rotations,
+                           const glm::vec2 *scales,
+                           uint32 count,
+                           InstanceData *instances) noexcept {
+    const auto *position = reinterpret_cast<const float *>(positions);
+    const auto *scale = reinterpret_cast<const float *>(scales);
+    uint32 i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 sine, cosine;
+
+        // Deinterleave Positions And Scales
+        __m128 p0 = _mm_loadu_ps(position + 2 * i);
+        __m128 p1 = _mm_loadu_ps(position + 2 * i + 4);
+        __m128 s0 = _mm_loadu_ps(scale + 2 * i);
+        __m128 s1 = _mm_loadu_ps(scale + 2 * i + 4);
+        __m128 sx = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 sy = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        sincos4(_mm_loadu_ps(rotations + i), &sine, &cosine);
+
+        // Compute Basis Columns
+        __m128 a = _mm_mul_ps(cosine, sx);
+        __m128 b = _mm_mul_ps(sine, sx);
+        __m128 c = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sine, sy));
+        __m128 d = _mm_mul_ps(cosine, sy);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+
+        // Store Per Sprite
+        _mm_storeu_ps(&instances[i + 0].basis.x, a);
+        _mm_storeu_ps(&instances[i + 1].basis.x, b);
+        _mm_storeu_ps(&instances[i + 2].basis.x, c);
+        _mm_storeu_ps(&instances[i + 3].basis.x, d);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&instances[i + 0].translation.x), p0);
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(&instances[i + 1].translation.x), p0);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&instances[i + 2].translation.x), p1);
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(&instances[i + 3].translation.x), p1);
+    }
+
+    buildSpriteTransformsScalar(positions + i, rotations + i, scales + i, count - i, instances + i);
+}
+
+const char *getSpriteTransformPath() noexcept {
+    return "SSE2";
+}
+
+#elif defined(SPRITE_TRANSFORM_AVX2)
+
+static inline void sincos8(__m256 x, __m256 *sine, __m256 *cosine) noexcept {
+    const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32>(0x80000000)));
+    __m256 signSin = _mm256_and_ps(x, signMask);
+
+    // Reduce To Octant Of [-Pi/4, Pi/4]
+    x = _mm256_andnot_ps(signMask, x);
+    __m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(SINCOS_FOUR_OVER_PI)));
+    octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    __m256 y = _mm256_cvtepi32_ps(octant);
+
+    __m256 swapSin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29));
+    __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+    __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(2)),
+                                                             _mm256_setzero_si256()));
+    signSin = _mm256_xor_ps(signSin, swapSin);
+
+    x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(SINCOS_DP1)));
+    x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(SINCOS_DP2)));
+    x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(SINCOS_DP3)));
+    __m256 z = _mm256_mul_ps(x, x);
+
+    // Evaluate Both Polynomials
+    __m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SINCOS_COS0), z), _mm256_set1_ps(SINCOS_COS1));
+    cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(SINCOS_COS2));
+    cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+    cosPoly = _mm256_add_ps(_mm256_sub_ps(cosPoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+    __m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SINCOS_SIN0), z), _mm256_set1_ps(SINCOS_SIN1));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(SINCOS_SIN2));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x), x);
+
+    // Select Polynomial By Octant And Restore Signs
+    __m256 s = _mm256_blendv_ps(cosPoly, sinPoly, polyMask);
+    __m256 c = _mm256_blendv_ps(sinPoly, cosPoly, polyMask);
+
+    *sine = _mm256_xor_ps(s, signSin);
+    *cosine = _mm256_xor_ps(c, signCos);
+}
+
+static inline __m256 deinterleave(__m256 v0, __m256 v1, int32 component) noexcept {
+    __m256 mixed = component == 0 ? _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)) :
+                                    _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+
+    // Restore Sprite Order Across 128-Bit Lanes
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(mixed), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+void buildSpriteTransforms(const glm::vec2 *positions,
+                           const float *rotations,
+                           const glm::vec2 *scales,
+                           uint32 count,
+                           InstanceData *instances) noexcept {
+    const auto *position = reinterpret_cast<const float *>(positions);
+    const auto *scale = reinterpret_cast<const float *>(scales);
+    uint32 i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 sine, cosine;
+
+        // Deinterleave Scales
+        __m256 s0 = _mm256_loadu_ps(scale + 2 * i);
+        __m256 s1 = _mm256_loadu_ps(scale + 2 * i + 8);
+        __m256 sx = deinterleave(s0, s1, 0);
+        __m256 sy = deinterleave(s0, s1, 1);
+
+        sincos8(_mm256_loadu_ps(rotations + i), &sine, &cosine);
+
+        // Compute Basis Columns
+        __m256 a = _mm256_mul_ps(cosine, sx);
+        __m256 b = _mm256_mul_ps(sine, sx);
+        __m256 c = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(sine, sy));
+        __m256 d = _mm256_mul_ps(cosine, sy);
+
+        // Transpose Within Lanes, Low Lane Holds Sprites 0-3 And High Lane Sprites 4-7
+        __m256 t0 = _mm256_unpacklo_ps(a, b);
+        __m256 t1 = _mm256_unpackhi_ps(a, b);
+        __m256 t2 = _mm256_unpacklo_ps(c, d);
+        __m256 t3 = _mm256_unpackhi_ps(c, d);
+        __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+        // Store Per Sprite
+        __m256 rows[] = { r0, r1, r2, r3 };
+        for (uint32 j = 0; j < 4; j++) {
+            _mm_storeu_ps(&instances[i + j].basis.x, _mm256_castps256_ps128(rows[j]));
+            _mm_storeu_ps(&instances[i + j + 4].basis.x, _mm256_extractf128_ps(rows[j], 1));
+        }
+
+        for (uint32 j = 0; j < 4; j++) {
+            __m128 pair = _mm_loadu_ps(position + 2 * (i + 2 * j));
+
+            _mm_storel_pi(reinterpret_cast<__m64 *>(&instances[i + 2 * j].translation.x), pair);
+            _mm_storeh_pi(reinterpret_cast<__m64 *>(&instances[i + 2 * j + 1].translation.x), pair);
+        }
+    }
+
+    buildSpriteTransformsScalar(positions + i, rotations + i, scales + i, count - i, instances + i);
+}
+
+const char *getSpriteTransformPath() noexcept {
+    return "AVX2";
+}
+
+#else
+
+void buildSpriteTransforms(const glm::vec2 *positions,
+                           const float *rotations,
+                           const glm::vec2 *scales,
+                           uint32 count,
+                           InstanceData *instances) noexcept {
+    buildSpriteTransformsScalar(positions, rotations, scales, count, instances);
+}
+
+const char *getSpriteTransformPath() noexcept {
+    return "Scalar";
+}
+
+#endif
@@ -7,16 +7,23 @@
 
 #include "Game.h"
 #include "GraphicsManager.h"
+#include "JobManager.h"
 #include "MemoryManager.h"
 #include "WindowManager.h"
 #include "WorldManager.h"
 
 Result<void> Game::startup() {
     GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    JobManager &jobManager = JobManager::getManager();
     MemoryManager &memoryManager = MemoryManager::getManager();
     WindowManager &windowManager = WindowManager::getManager();
     WorldManager &worldManager = WorldManager::getManager();
 
+    Result<void> jobStartupResult = jobManager.startup();
+    if (jobStartupResult.hasError()) {
+        return Result<void>::createError(jobStartupResult.getError());
+    }
+
     Result<void> graphicsStartupResult = graphicsManager.startup();
     if (graphicsStartupResult.hasError()) {
         return Result<void>::createError(graphicsStartupResult.getError());
@@ -53,6 +60,7 @@ Result<void> Game::play() {
 
 void Game::shutdown() {
     GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    JobManager &jobManager = JobManager::getManager();
     MemoryManager &memoryManager = MemoryManager::getManager();
     WindowManager &windowManager = WindowManager::getManager();
     WorldManager &worldManager = WorldManager::getManager();
@@ -61,4 +69,5 @@ void Game::shutdown() {
     windowManager.shutdown();
     memoryManager.shutdown();
     graphicsManager.shutdown();
+    jobManager.shutdown();
 }
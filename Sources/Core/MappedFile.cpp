@@ -0,0 +1,112 @@
+/**
+ * MappedFile.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+    this->data = nullptr;
+    this->size = 0;
+    this->fileHandle = nullptr;
+    this->mappingHandle = nullptr;
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (this->data != nullptr) {
+        UnmapViewOfFile(this->data);
+    }
+
+    if (this->mappingHandle != nullptr) {
+        CloseHandle(this->mappingHandle);
+    }
+
+    if (this->fileHandle != nullptr) {
+        CloseHandle(this->fileHandle);
+    }
+#else
+    if (this->data != nullptr) {
+        munmap(this->data, this->size);
+    }
+#endif
+
+    this->data = nullptr;
+    this->size = 0;
+    this->fileHandle = nullptr;
+    this->mappingHandle = nullptr;
+}
+
+Result<std::shared_ptr<MappedFile>> MappedFile::createMappedFile(const utf8 *filename) {
+    std::shared_ptr<MappedFile> file(new MappedFile);
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(filename,
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    file->fileHandle = handle;
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    file->size = static_cast<uint64>(fileSize.QuadPart);
+    file->mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file->mappingHandle == nullptr) {
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    file->data = MapViewOfFile(file->mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (file->data == nullptr) {
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+#else
+    int descriptor = open(filename, O_RDONLY);
+    if (descriptor < 0) {
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    struct stat status = {};
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        close(descriptor);
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    // Mapping Stays Valid After Descriptor Is Closed
+    file->size = static_cast<uint64>(status.st_size);
+    void *mapping = mmap(nullptr, file->size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        file->size = 0;
+        return Result<std::shared_ptr<MappedFile>>::createError(Error::FailedToMapFile);
+    }
+
+    // Contents Are Read Front To Back Exactly Once
+    file->data = mapping;
+    madvise(file->data, file->size, MADV_SEQUENTIAL);
+    madvise(file->data, file->size, MADV_WILLNEED);
+#endif
+
+    return Result<std::shared_ptr<MappedFile>>(std::move(file));
+}
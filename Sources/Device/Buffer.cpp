@@ -6,12 +6,16 @@
  */
 
 #include "Buffer.h"
+#include "Defragmenter.h"
 #include "Device.h"
 #include "GraphicsManager.h"
 #include "Memory.h"
 #include "MemoryManager.h"
-#include "PoolAllocator.h"
 #include "Queue.h"
+#include "Renderer.h"
+#include "TlsfAllocator.h"
+#include "TransferScheduler.h"
+#include "WorldManager.h"
 
 #include <cstring>
 #include <iostream>
@@ -20,9 +24,13 @@
 Buffer::Buffer() {
     this->allocator = nullptr;
     this->buffer = VK_NULL_HANDLE;
-    this->memory = nullptr;
+    this->mapping = nullptr;
+    this->memory = Memory();
+    this->memoryFlags = 0;
     this->queueList = {};
     this->sharingMode = VK_SHARING_MODE_MAX_ENUM;
+    this->requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    this->preferredFlags = 0;
     this->size = 0;
     this->usage = 0;
 }
@@ -38,39 +46,48 @@ Result<void> Buffer::allocateMemory() {
         VkMemoryRequirements memoryRequirements = {};
         vkGetBufferMemoryRequirements(device, this->buffer, &memoryRequirements);
 
-        // TODO: Select Proper Chunk Size for Allocator
-        Result<std::shared_ptr<PoolAllocator>> rslt =
-                memoryManager.requestPoolAllocator(memoryRequirements.alignment,
-                                                   memoryRequirements.size,
-                                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        std::shared_ptr<Allocator> allocator = nullptr;
+        Result<Memory> res = memoryManager.allocateMemory(memoryRequirements.size,
+                                                          memoryRequirements.alignment,
+                                                          memoryRequirements.memoryTypeBits,
+                                                          this->requiredFlags | this->preferredFlags,
+                                                          &allocator);
+
+        // Fall Back To Required Properties When No Preferred Memory Type Has Room
+        if (res.hasError() && this->preferredFlags != 0) {
+            res = memoryManager.allocateMemory(memoryRequirements.size,
+                                               memoryRequirements.alignment,
+                                               memoryRequirements.memoryTypeBits,
+                                               this->requiredFlags,
+                                               &allocator);
+        }
 
-        if (!rslt.hasError()) {
-            this->allocator = static_cast<std::shared_ptr<PoolAllocator>>(rslt);
-            Result<std::unique_ptr<Memory>> res = this->allocator->allocate(memoryRequirements.size);
+        if (!res.hasError()) {
+            this->allocator = allocator;
+            this->memory = static_cast<Memory>(res);
 
-            if (!res.hasError()) {
-                this->memory = static_cast<std::unique_ptr<Memory>>(res);
+            // Store Memory Type Properties
+            Result<VkPhysicalDeviceMemoryProperties> props = memoryManager.getMemoryProperties();
+            if (!props.hasError()) {
+                auto memoryProperties = static_cast<VkPhysicalDeviceMemoryProperties>(props);
+                this->memoryFlags = memoryProperties.memoryTypes[this->memory.getMemoryHeap()].propertyFlags;
+            }
 
-                // Bind Memory to Buffer
-                VkResult success = vkBindBufferMemory(device,
-                                                      this->buffer,
-                                                      this->memory->getMemory(),
-                                                      this->memory->getMemoryOffset());
+            // Bind Memory to Buffer
+            VkResult success = vkBindBufferMemory(device,
+                                                  this->buffer,
+                                                  this->memory.getMemory(),
+                                                  this->memory.getMemoryOffset());
 
-                if (success == VK_SUCCESS) {
-                    return Result<void>::createError(Error::None);
-                }
-                else {
-                    return Result<void>::createError(Error::FailedToBindBufferMemory);
-                }
+            if (success == VK_SUCCESS) {
+                return Result<void>::createError(Error::None);
             }
             else {
-                return Result<void>::createError(res.getError());
+                return Result<void>::createError(Error::FailedToBindBufferMemory);
             }
         }
         else {
-            return Result<void>::createError(rslt.getError());
+            return Result<void>::createError(res.getError());
         }
     }
 
@@ -99,6 +116,30 @@ VkBufferCreateInfo Buffer::getBufferCreateInfo() const noexcept {
     return bufferCreateInfo;
 }
 
+VkMappedMemoryRange Buffer::getMappedMemoryRange(uint64 off, uint64 siz) const noexcept {
+    MemoryManager &memoryManager = MemoryManager::getManager();
+    VkDeviceSize atomSize = memoryManager.getNonCoherentAtomSize();
+    VkDeviceSize begin = this->memory.getMemoryOffset() + off;
+    VkDeviceSize end = begin + siz;
+    VkMappedMemoryRange mappedMemoryRange = {};
+
+    // Align Range To Atom Size
+    begin = (begin / atomSize) * atomSize;
+    end = ((end + atomSize - 1) / atomSize) * atomSize;
+    uint64 blockSize = this->allocator->getBlockSize(this->memory);
+    if (end > blockSize) {
+        end = blockSize;
+    }
+
+    mappedMemoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    mappedMemoryRange.pNext = nullptr;
+    mappedMemoryRange.memory = this->memory.getMemory();
+    mappedMemoryRange.offset = begin;
+    mappedMemoryRange.size = end - begin;
+
+    return mappedMemoryRange;
+}
+
 Result<VkDevice> Buffer::getGraphicsDevice() const noexcept {
     GraphicsManager &graphicsManager = GraphicsManager::getManager();
     Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
@@ -115,8 +156,33 @@ Result<VkDevice> Buffer::getGraphicsDevice() const noexcept {
     return Result<VkDevice>::createError(result.getError());
 }
 
+Result<std::shared_ptr<Renderer>> Buffer::getRenderer() const noexcept {
+    WorldManager &worldManager = WorldManager::getManager();
+    return worldManager.getRenderer();
+}
+
+Result<void> Buffer::stageBuffer(uint64 siz, const void *data) {
+    Result<std::shared_ptr<Renderer>> result = this->getRenderer();
+
+    if (!result.hasError()) {
+        auto renderer = static_cast<std::shared_ptr<Renderer>>(result);
+        Result<TransferTicket> rslt = renderer->getTransferScheduler()->uploadBuffer(*this, 0, data, siz);
+
+        if (!rslt.hasError()) {
+            // Callers Expect Filled Contents, Await Only This Upload
+            return renderer->getTransferScheduler()->wait(static_cast<TransferTicket>(rslt));
+        }
+        else {
+            return Result<void>::createError(rslt.getError());
+        }
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
 Buffer::~Buffer() {
     this->queueList.clear();
+    this->mapping = nullptr;
 
     if (this->buffer != VK_NULL_HANDLE) {
         Result<VkDevice> result = this->getGraphicsDevice();
@@ -130,11 +196,45 @@ Buffer::~Buffer() {
             this->buffer = VK_NULL_HANDLE;
         }
     }
+
+    // Return Memory to Allocator
+    if (this->allocator != nullptr && this->memory.isValid()) {
+        this->allocator->free(this->memory);
+    }
 }
 
 Result<std::shared_ptr<Buffer>> Buffer::createBuffer(VkDeviceSize siz, VkBufferUsageFlags usg) {
+    return Buffer::createBuffer(siz, usg, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
+Result<std::shared_ptr<Buffer>> Buffer::createBuffer(VkDeviceSize siz,
+                                                     VkBufferUsageFlags usg,
+                                                     VkMemoryPropertyFlags flags) {
+    return Buffer::createExclusiveBuffer(siz, usg, flags, 0);
+}
+
+Result<std::shared_ptr<Buffer>> Buffer::createBuffer(VkDeviceSize siz,
+                                                     VkBufferUsageFlags usg,
+                                                     MemoryUsage memoryUsage) {
+    // GPU Only Buffers Are Filled Through Staging And May Be Moved By The Defragmenter
+    if (memoryUsage == MemoryUsage::GpuOnly) {
+        usg |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    return Buffer::createExclusiveBuffer(siz,
+                                         usg,
+                                         Memory::getRequiredFlags(memoryUsage),
+                                         Memory::getPreferredFlags(memoryUsage));
+}
+
+Result<std::shared_ptr<Buffer>> Buffer::createExclusiveBuffer(VkDeviceSize siz,
+                                                              VkBufferUsageFlags usg,
+                                                              VkMemoryPropertyFlags requiredFlags,
+                                                              VkMemoryPropertyFlags preferredFlags) {
     std::shared_ptr<Buffer> buffer(new Buffer);
 
+    buffer->preferredFlags = preferredFlags;
+    buffer->requiredFlags = requiredFlags;
     buffer->size = siz;
     buffer->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     buffer->usage = usg;
@@ -151,6 +251,17 @@ Result<std::shared_ptr<Buffer>> Buffer::createBuffer(VkDeviceSize siz, VkBufferU
 
             std::cout << "Creating Buffer Resource: " << buffer->buffer << std::endl;
             if (!res.hasError()) {
+                // Only Device Local Buffers That Can Be Copied Are Worth Compacting
+                Result<std::shared_ptr<Renderer>> rndr = buffer->getRenderer();
+                if (!rndr.hasError() && (buffer->memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0 &&
+                    (buffer->usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) != 0) {
+                    auto renderer = static_cast<std::shared_ptr<Renderer>>(rndr);
+
+                    if (renderer->getDefragmenter() != nullptr) {
+                        renderer->getDefragmenter()->registerBuffer(buffer);
+                    }
+                }
+
                 return Result<std::shared_ptr<Buffer>>(std::move(buffer));
             }
             else {
@@ -199,30 +310,168 @@ Result<std::shared_ptr<Buffer>> Buffer::createSharedBuffer(VkDeviceSize siz,
     return Result<std::shared_ptr<Buffer>>::createError(result.getError());
 }
 
-Result<void> Buffer::fillBuffer(uint64 size, void *data) {
+Result<void> Buffer::fillBuffer(uint64 size, const void *data) {
+    if ((this->memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
+        return this->stageBuffer(size, data);
+    }
+
+    Result<void *> result = this->map();
+
+    if (!result.hasError()) {
+        // Copy Data
+        memcpy(static_cast<void *>(result), data, size);
+        return this->flushRange(0, size);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Buffer::flushRange(uint64 off, uint64 siz) {
+    if (this->isCoherent()) {
+        return Result<void>::createError(Error::None);
+    }
+
     Result<VkDevice> result = this->getGraphicsDevice();
     if (!result.hasError()) {
         auto device = static_cast<VkDevice>(result);
-        VkDeviceMemory memory = this->memory->getMemory();
-        VkDeviceSize offset = this->memory->getMemoryOffset();
+        VkMappedMemoryRange mappedMemoryRange = this->getMappedMemoryRange(off, siz);
 
-        // Copy Data
-        void *mem;
-        VkResult res = vkMapMemory(device, memory, offset, size, 0, &mem);
-        if (res == VK_SUCCESS) {
-            memcpy(mem, data, size);
-            vkUnmapMemory(device, memory);
+        if (vkFlushMappedMemoryRanges(device, 1, &mappedMemoryRange) == VK_SUCCESS) {
+            return Result<void>::createError(Error::None);
+        }
+        else {
+            return Result<void>::createError(Error::FailedToFlushMemory);
+        }
+    }
+
+    return Result<void>::createError(result.getError());
+}
 
+Result<void> Buffer::invalidateRange(uint64 off, uint64 siz) {
+    if (this->isCoherent()) {
+        return Result<void>::createError(Error::None);
+    }
+
+    Result<VkDevice> result = this->getGraphicsDevice();
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkMappedMemoryRange mappedMemoryRange = this->getMappedMemoryRange(off, siz);
+
+        if (vkInvalidateMappedMemoryRanges(device, 1, &mappedMemoryRange) == VK_SUCCESS) {
             return Result<void>::createError(Error::None);
         }
         else {
-            return Result<void>::createError(Error::FailedToMapMemory);
+            return Result<void>::createError(Error::FailedToInvalidateMemory);
         }
     }
 
     return Result<void>::createError(result.getError());
 }
 
+bool Buffer::isCoherent() const noexcept {
+    return (this->memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+}
+
+Result<void *> Buffer::map() {
+    if ((this->memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
+        return Result<void *>::createError(Error::FailedToMapMemory);
+    }
+
+    if (this->mapping == nullptr) {
+        Result<void *> result = this->allocator->map(this->memory);
+
+        if (!result.hasError()) {
+            this->mapping = static_cast<uint8 *>(static_cast<void *>(result)) + this->memory.getMemoryOffset();
+        }
+        else {
+            return Result<void *>::createError(result.getError());
+        }
+    }
+
+    return Result<void *>(this->mapping);
+}
+
+Result<uint64> Buffer::relocate(VkCommandBuffer cmdBuffer, const TlsfAllocator &source, RetiredResource &retired) {
+    Result<VkDevice> result = this->getGraphicsDevice();
+    MemoryManager &memoryManager = MemoryManager::getManager();
+
+    if (result.hasError()) {
+        return Result<uint64>::createError(result.getError());
+    }
+
+    auto device = static_cast<VkDevice>(result);
+    VkBufferCreateInfo bufferCreateInfo = this->getBufferCreateInfo();
+    VkBuffer relocated = VK_NULL_HANDLE;
+
+    if (vkCreateBuffer(device, &bufferCreateInfo, nullptr, &relocated) != VK_SUCCESS) {
+        return Result<uint64>::createError(Error::FailedToCreateBuffer);
+    }
+
+    // Get Memory Requirements
+    VkMemoryRequirements memoryRequirements = {};
+    vkGetBufferMemoryRequirements(device, relocated, &memoryRequirements);
+
+    Result<std::shared_ptr<TlsfAllocator>> rslt =
+            memoryManager.requestRelocationTarget(memoryRequirements.size, memoryRequirements.alignment, source);
+    if (rslt.hasError()) {
+        vkDestroyBuffer(device, relocated, nullptr);
+        return Result<uint64>::createError(rslt.getError());
+    }
+
+    auto allocator = static_cast<std::shared_ptr<TlsfAllocator>>(rslt);
+    Result<Memory> res = allocator->allocate(memoryRequirements.size, memoryRequirements.alignment);
+    if (res.hasError()) {
+        vkDestroyBuffer(device, relocated, nullptr);
+        return Result<uint64>::createError(res.getError());
+    }
+
+    auto memory = static_cast<Memory>(res);
+    if (vkBindBufferMemory(device, relocated, memory.getMemory(), memory.getMemoryOffset()) != VK_SUCCESS) {
+        allocator->free(memory);
+        vkDestroyBuffer(device, relocated, nullptr);
+        return Result<uint64>::createError(Error::FailedToBindBufferMemory);
+    }
+
+    // Copy Contents To New Region
+    VkBufferCopy bufferCopy = {};
+    bufferCopy.srcOffset = 0;
+    bufferCopy.dstOffset = 0;
+    bufferCopy.size = this->size;
+
+    vkCmdCopyBuffer(cmdBuffer, this->buffer, relocated, 1, &bufferCopy);
+
+    // Make Copy Visible To Every Read In The Frame
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                  VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(cmdBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         1,
+                         &memoryBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    // Hand Old Handle And Region Over For Deferred Destruction
+    retired.buffer = this->buffer;
+    retired.allocator = std::move(this->allocator);
+    retired.memory = this->memory;
+
+    this->buffer = relocated;
+    this->allocator = allocator;
+    this->memory = memory;
+
+    return Result<uint64>(memoryRequirements.size);
+}
+
 Result<VkBuffer> Buffer::getVulkanBuffer() const noexcept {
     if (this->buffer != VK_NULL_HANDLE)
         return Result<VkBuffer>(this->buffer);
@@ -231,8 +480,8 @@ Result<VkBuffer> Buffer::getVulkanBuffer() const noexcept {
 }
 
 Result<VkDeviceMemory> Buffer::getVulkanMemory() const noexcept {
-    if (this->memory != nullptr)
-        return Result<VkDeviceMemory>(this->memory->getMemory());
+    if (this->memory.isValid())
+        return Result<VkDeviceMemory>(this->memory.getMemory());
     else
         return Result<VkDeviceMemory>::createError(Error::FailedToRetrieveBuffer);
 }
@@ -0,0 +1,233 @@
+/**
+ * Defragmenter.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Buffer.h"
+#include "Defragmenter.h"
+#include "Device.h"
+#include "GraphicsManager.h"
+#include "Image.h"
+#include "MemoryManager.h"
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vulkan/vulkan.h>
+
+Defragmenter::Defragmenter() {
+    this->buffers = std::vector<std::weak_ptr<Buffer>>();
+    this->images = std::vector<std::weak_ptr<Image>>();
+    this->source = nullptr;
+    this->skipped = nullptr;
+    this->retired = std::deque<RetiredResource>();
+    this->draining = false;
+    this->budget = DEFAULT_DEFRAGMENTATION_BUDGET;
+    this->budgetBytes = DEFAULT_DEFRAGMENTATION_BYTES;
+    this->threshold = DEFAULT_DEFRAGMENTATION_THRESHOLD;
+    this->frame = 0;
+    this->framesInFlight = 0;
+    this->version = 0;
+}
+
+Result<VkDevice> Defragmenter::getGraphicsDevice() const noexcept {
+    GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<std::weak_ptr<const Device>>(result);
+
+        if (std::shared_ptr<const Device> dev = device.lock())
+            return dev->getVulkanDevice();
+        else
+            return Result<VkDevice>::createError(Error::GraphicsManagerNotStartedUp);
+    }
+
+    return Result<VkDevice>::createError(result.getError());
+}
+
+void Defragmenter::releaseRetired(bool bAll) {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        // Retired In Submission Order, So Front Is Always Oldest
+        while (!this->retired.empty() && (bAll || this->retired.front().frame + this->framesInFlight <= this->frame)) {
+            RetiredResource &resource = this->retired.front();
+
+            if (resource.view != VK_NULL_HANDLE) {
+                vkDestroyImageView(device, resource.view, nullptr);
+            }
+
+            if (resource.buffer != VK_NULL_HANDLE) {
+                vkDestroyBuffer(device, resource.buffer, nullptr);
+            }
+
+            if (resource.image != VK_NULL_HANDLE) {
+                vkDestroyImage(device, resource.image, nullptr);
+            }
+
+            if (resource.allocator != nullptr && resource.memory.isValid()) {
+                resource.allocator->free(resource.memory);
+            }
+
+            this->retired.pop_front();
+        }
+    }
+}
+
+void Defragmenter::stopEvacuation() {
+    MemoryManager &memoryManager = MemoryManager::getManager();
+
+    this->source.reset();
+    this->draining = false;
+    memoryManager.setEvacuatedAllocator(nullptr);
+}
+
+Defragmenter::~Defragmenter() {
+    this->releaseRetired(true);
+
+    if (this->source != nullptr || this->draining) {
+        this->stopEvacuation();
+    }
+
+    this->buffers.clear();
+    this->images.clear();
+    this->skipped = nullptr;
+}
+
+Result<std::shared_ptr<Defragmenter>> Defragmenter::createDefragmenter(uint32 framesInFlight) {
+    std::shared_ptr<Defragmenter> defragmenter(new Defragmenter);
+
+    defragmenter->framesInFlight = framesInFlight;
+
+    return Result<std::shared_ptr<Defragmenter>>(std::move(defragmenter));
+}
+
+void Defragmenter::registerBuffer(const std::shared_ptr<Buffer> &buffer) {
+    this->buffers.push_back(buffer);
+}
+
+void Defragmenter::registerImage(const std::shared_ptr<Image> &image) {
+    this->images.push_back(image);
+}
+
+void Defragmenter::retireImageView(VkImageView view) {
+    RetiredResource resource = {};
+
+    resource.view = view;
+    resource.frame = this->frame;
+
+    this->retired.push_back(std::move(resource));
+}
+
+void Defragmenter::setBudget(real64 milliseconds, uint64 bytes) noexcept {
+    this->budget = milliseconds;
+    this->budgetBytes = bytes;
+}
+
+void Defragmenter::setThreshold(real64 fraction) noexcept {
+    this->threshold = fraction;
+}
+
+void Defragmenter::step(VkCommandBuffer cmdBuffer, bool bRelocate) {
+    MemoryManager &memoryManager = MemoryManager::getManager();
+    auto start = std::chrono::steady_clock::now();
+
+    this->frame++;
+    this->releaseRetired(false);
+
+    // Forget Destroyed Resources
+    this->buffers.erase(std::remove_if(this->buffers.begin(), this->buffers.end(),
+                                       [](const std::weak_ptr<Buffer> &buffer) { return buffer.expired(); }),
+                        this->buffers.end());
+    this->images.erase(std::remove_if(this->images.begin(), this->images.end(),
+                                      [](const std::weak_ptr<Image> &image) { return image.expired(); }),
+                       this->images.end());
+
+    // Emptied Block Is Freed Once Frames Stop Referencing Its Regions
+    if (this->draining) {
+        if (memoryManager.releaseEvacuatedAllocator()) {
+            this->draining = false;
+            this->skipped = nullptr;
+        }
+        else if (this->retired.empty()) {
+            // Unknown Resources Still Live In Block
+            this->stopEvacuation();
+        }
+
+        return;
+    }
+
+    if (!bRelocate) {
+        return;
+    }
+
+    // Pick Sparsest TLSF Block, Pool Blocks Are Never Compacted
+    if (this->source == nullptr) {
+        this->source = memoryManager.findSparseAllocator(this->threshold, this->skipped);
+
+        if (this->source == nullptr) {
+            return;
+        }
+
+        memoryManager.setEvacuatedAllocator(this->source.get());
+    }
+
+    uint64 copied = 0;
+    bool bFailed = false;
+    bool bRemaining = false;
+    bool bMoved = false;
+
+    auto evacuate = [&](auto &resources) {
+        for (auto &weak : resources) {
+            auto resource = weak.lock();
+
+            if (resource == nullptr || resource->getAllocator().get() != this->source.get()) {
+                continue;
+            }
+
+            // Leave Rest For Next Frames Once Budget Is Spent
+            std::chrono::duration<real64, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (bFailed || copied >= this->budgetBytes || elapsed.count() >= this->budget) {
+                bRemaining = true;
+                continue;
+            }
+
+            RetiredResource old = {};
+            old.frame = this->frame;
+
+            Result<uint64> result = resource->relocate(cmdBuffer, *this->source, old);
+            if (!result.hasError()) {
+                copied += static_cast<uint64>(result);
+                this->retired.push_back(std::move(old));
+                bMoved = true;
+            }
+            else {
+                bFailed = true;
+                bRemaining = true;
+            }
+        }
+    };
+
+    evacuate(this->buffers);
+    evacuate(this->images);
+
+    if (bMoved) {
+        this->version++;
+    }
+
+    if (bFailed) {
+        // Denser Blocks Are Full Or Resource Is Busy, Try Another Block Next Time
+        this->skipped = this->source.get();
+        this->stopEvacuation();
+    }
+    else if (!bRemaining) {
+        this->skipped = this->source.get();
+        this->source.reset();
+        this->draining = true;
+    }
+}
@@ -10,6 +10,7 @@
 #include "Instance.h"
 #include "Queue.h"
 
+#include <cstring>
 #include <iostream>
 #include <vulkan/vulkan.h>
 
@@ -84,6 +85,47 @@ bool Device::checkPhysicalDeviceLimits(VkPhysicalDevice pd) const noexcept {
     return true;
 }
 
+bool Device::checkPhysicalDeviceDescriptorIndexing(VkPhysicalDevice pd) const noexcept {
+    VkPhysicalDeviceProperties properties = {};
+    std::vector<VkExtensionProperties> extensions;
+    uint32 extensionCount = 0;
+    bool bHasExtension = false;
+
+    // Features2 Query Requires Vulkan 1.1
+    vkGetPhysicalDeviceProperties(pd, &properties);
+    if (properties.apiVersion < VK_API_VERSION_1_1) {
+        return false;
+    }
+
+    // Check Extension Availability
+    vkEnumerateDeviceExtensionProperties(pd, nullptr, &extensionCount, nullptr);
+    extensions.resize(extensionCount);
+    vkEnumerateDeviceExtensionProperties(pd, nullptr, &extensionCount, extensions.data());
+
+    for (auto &ext : extensions) {
+        if (strcmp(ext.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0) {
+            bHasExtension = true;
+            break;
+        }
+    }
+
+    if (!bHasExtension) {
+        return false;
+    }
+
+    // Check Non Uniform Indexing Feature
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    indexingFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexingFeatures;
+
+    vkGetPhysicalDeviceFeatures2(pd, &features);
+    return indexingFeatures.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
+}
+
 Result<void> Device::createQueues(std::vector<struct VkDeviceQueueCreateInfo> *deviceQueueCreateInfo) {
     for (auto& queueCreateInfo : *deviceQueueCreateInfo) {
         for (uint32 i = 0; i < queueCreateInfo.queueCount; i++) {
@@ -104,9 +146,24 @@ Result<void> Device::createQueues(std::vector<struct VkDeviceQueueCreateInfo> *d
 }
 
 Result<void> Device::createVulkanDevice() {
-    std::vector<float> queuePriorities;
+    std::vector<std::vector<float>> queuePriorities;
     std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfo = this->getDeviceQueueCreateInfo(&queuePriorities);
     VkDeviceCreateInfo deviceCreateInfo = this->getDeviceCreateInfo(&deviceQueueCreateInfo);
+    std::vector<const utf8 *> extensions = this->requiredExtensions;
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+
+    // Enable Optional Descriptor Indexing
+    if (this->bDescriptorIndexing) {
+        extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        indexingFeatures.pNext = nullptr;
+        indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+
+        deviceCreateInfo.pNext = &indexingFeatures;
+        deviceCreateInfo.ppEnabledExtensionNames = extensions.data();
+        deviceCreateInfo.enabledExtensionCount = static_cast<uint32>(extensions.size());
+    }
 
     if (this->physicalDevice != VK_NULL_HANDLE) {
         VkResult result = vkCreateDevice(this->physicalDevice, &deviceCreateInfo, nullptr, &this->device);
@@ -146,26 +203,50 @@ VkDeviceCreateInfo Device::getDeviceCreateInfo(
 }
 
 std::vector<VkDeviceQueueCreateInfo> Device::getDeviceQueueCreateInfo(
-        std::vector<float> *queuePriorities) const noexcept {
+        std::vector<std::vector<float>> *queuePriorities) const noexcept {
     std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfo = {};
     std::vector<VkQueueFamilyProperties> queueFamilyProperties = this->getPhysicalDeviceQueueFamilyProperties();
+    uint32 transferFamily = static_cast<uint32>(queueFamilyProperties.size());
+
+    // Each Family Keeps Its Own Priorities, Pointers Must Stay Valid Until Device Creation
+    queuePriorities->reserve(queueFamilyProperties.size());
 
     for (uint32 i = 0; i < static_cast<uint32>(queueFamilyProperties.size()); i++) {
         if (queueFamilyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
             VkDeviceQueueCreateInfo createInfo = {};
 
-            queuePriorities->resize(queueFamilyProperties[i].queueCount);
-            queuePriorities->assign(queueFamilyProperties[i].queueCount, 0.0f);
+            queuePriorities->emplace_back(queueFamilyProperties[i].queueCount, 1.0f);
 
             createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             createInfo.pNext = nullptr;
             createInfo.queueFamilyIndex = i;
             createInfo.queueCount = queueFamilyProperties[i].queueCount;
-            createInfo.pQueuePriorities = queuePriorities->data();
+            createInfo.pQueuePriorities = queuePriorities->back().data();
             createInfo.flags = 0;
 
             deviceQueueCreateInfo.push_back(createInfo);
         }
+        else if ((queueFamilyProperties[i].queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+                 !(queueFamilyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT) &&
+                 transferFamily == queueFamilyProperties.size()) {
+            transferFamily = i;
+        }
+    }
+
+    // Dedicated Transfer Family Goes Last, Renderer Uses Last Queue For Uploads
+    if (transferFamily < queueFamilyProperties.size()) {
+        VkDeviceQueueCreateInfo createInfo = {};
+
+        queuePriorities->emplace_back(1, 1.0f);
+
+        createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.queueFamilyIndex = transferFamily;
+        createInfo.queueCount = 1;
+        createInfo.pQueuePriorities = queuePriorities->back().data();
+        createInfo.flags = 0;
+
+        deviceQueueCreateInfo.push_back(createInfo);
     }
 
     return deviceQueueCreateInfo;
@@ -221,6 +302,7 @@ Result<void> Device::selectVulkanPhysicalDevice() {
                 this->checkPhysicalDeviceLimits(pd)) {
 
                 this->physicalDevice = pd;
+                this->bDescriptorIndexing = this->checkPhysicalDeviceDescriptorIndexing(pd);
                 return Result<void>::createError(Error::None);
             }
         }
@@ -273,6 +355,10 @@ Result<VkPhysicalDevice> Device::getVulkanPhysicalDevice() const noexcept {
         return Result<VkPhysicalDevice>::createError(Error::DeviceNotStartedUp);
 }
 
+bool Device::supportsDescriptorIndexing() const noexcept {
+    return this->bDescriptorIndexing;
+}
+
 Result<void> Device::startup() {
     if (this->selectVulkanPhysicalDevice().hasError())
         return Result<void>::createError(Error::NoPhysicalDeviceAvailable);
@@ -290,6 +376,7 @@ void Device::shutdown() {
 
     this->device = VK_NULL_HANDLE;
     this->physicalDevice = VK_NULL_HANDLE;
+    this->bDescriptorIndexing = false;
 
     std::cout << "Destroyed Logical Device..." << std::endl;
 }
@@ -6,15 +6,17 @@
  */
 
 #include "Image.h"
+#include "Defragmenter.h"
 #include "Device.h"
 #include "GraphicsManager.h"
 #include "Memory.h"
 #include "MemoryManager.h"
-#include "PoolAllocator.h"
 #include "Renderer.h"
 #include "Queue.h"
+#include "TlsfAllocator.h"
 #include "WorldManager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vulkan/vulkan.h>
 
@@ -30,8 +32,10 @@ Image::Image() {
     this->layout = VK_IMAGE_LAYOUT_MAX_ENUM;
     this->mipLevels = 0;
     this->arrayLayers = 0;
-    this->memory = nullptr;
+    this->allocator = nullptr;
+    this->memory = Memory();
     this->queueList = {};
+    this->relocations = 0;
 }
 
 Result<void> Image::allocateMemory() {
@@ -45,38 +49,32 @@ Result<void> Image::allocateMemory() {
         VkMemoryRequirements memoryRequirements = {};
         vkGetImageMemoryRequirements(device, this->image, &memoryRequirements);
 
-        // TODO: Select Proper Chunk Size for Allocator
-        Result<std::shared_ptr<PoolAllocator>> rslt =
-                memoryManager.requestPoolAllocator(memoryRequirements.alignment,
-                                                   memoryRequirements.size,
-                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-        if (!rslt.hasError()) {
-            auto allocator = static_cast<std::shared_ptr<PoolAllocator>>(rslt);
-            Result<std::unique_ptr<Memory>> res = allocator->allocate(memoryRequirements.size);
-
-            if (!res.hasError()) {
-                this->memory = static_cast<std::unique_ptr<Memory>>(res);
-
-                // Bind Memory to Image
-                VkResult success = vkBindImageMemory(device,
-                                                     this->image,
-                                                     this->memory->getMemory(),
-                                                     this->memory->getMemoryOffset());
-
-                if (success == VK_SUCCESS) {
-                    return Result<void>::createError(Error::None);
-                }
-                else {
-                    return Result<void>::createError(Error::FailedToBindImageMemory);
-                }
+        std::shared_ptr<Allocator> allocator = nullptr;
+        Result<Memory> res = memoryManager.allocateMemory(memoryRequirements.size,
+                                                          memoryRequirements.alignment,
+                                                          memoryRequirements.memoryTypeBits,
+                                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                          &allocator);
+
+        if (!res.hasError()) {
+            this->allocator = allocator;
+            this->memory = static_cast<Memory>(res);
+
+            // Bind Memory to Image
+            VkResult success = vkBindImageMemory(device,
+                                                 this->image,
+                                                 this->memory.getMemory(),
+                                                 this->memory.getMemoryOffset());
+
+            if (success == VK_SUCCESS) {
+                return Result<void>::createError(Error::None);
             }
             else {
-                return Result<void>::createError(res.getError());
+                return Result<void>::createError(Error::FailedToBindImageMemory);
             }
         }
         else {
-            return Result<void>::createError(rslt.getError());
+            return Result<void>::createError(res.getError());
         }
     }
 
@@ -186,6 +184,11 @@ Image::~Image() {
             image = VK_NULL_HANDLE;
         }
     }
+
+    // Return Memory to Allocator
+    if (this->allocator != nullptr && this->memory.isValid()) {
+        this->allocator->free(this->memory);
+    }
 }
 
 Result<std::shared_ptr<Image>> Image::createImage(VkExtent3D ext,
@@ -220,6 +223,16 @@ Result<std::shared_ptr<Image>> Image::createImage(VkExtent3D ext,
 
             std::cout << "Creating Image Resource: " << image->image << std::endl;
             if (!res.hasError()) {
+                // Only Images That Can Be Copied Are Worth Compacting
+                Result<std::shared_ptr<Renderer>> rndr = image->getRenderer();
+                if (!rndr.hasError() && (image->usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0) {
+                    auto renderer = static_cast<std::shared_ptr<Renderer>>(rndr);
+
+                    if (renderer->getDefragmenter() != nullptr) {
+                        renderer->getDefragmenter()->registerImage(image);
+                    }
+                }
+
                 return Result<std::shared_ptr<Image>>(std::move(image));
             }
             else {
@@ -313,6 +326,127 @@ Result<VkImage> Image::getVulkanImage() const noexcept {
         return Result<VkImage>::createError(Error::FailedToRetrieveImage);
 }
 
+Result<uint64> Image::relocate(VkCommandBuffer cmdBuffer, const TlsfAllocator &source, RetiredResource &retired) {
+    Result<VkDevice> result = this->getGraphicsDevice();
+    MemoryManager &memoryManager = MemoryManager::getManager();
+
+    if (result.hasError()) {
+        return Result<uint64>::createError(result.getError());
+    }
+
+    if (this->layout != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ||
+        (this->usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) == 0) {
+        return Result<uint64>::createError(Error::FailedToRetrieveImage);
+    }
+
+    auto device = static_cast<VkDevice>(result);
+    VkImageCreateInfo imageCreateInfo = this->getImageCreateInfo();
+    VkImage relocated = VK_NULL_HANDLE;
+
+    // Contents Are Copied, So New Image Starts Undefined
+    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(device, &imageCreateInfo, nullptr, &relocated) != VK_SUCCESS) {
+        return Result<uint64>::createError(Error::FailedToCreateImage);
+    }
+
+    // Get Memory Requirements
+    VkMemoryRequirements memoryRequirements = {};
+    vkGetImageMemoryRequirements(device, relocated, &memoryRequirements);
+
+    Result<std::shared_ptr<TlsfAllocator>> rslt =
+            memoryManager.requestRelocationTarget(memoryRequirements.size, memoryRequirements.alignment, source);
+    if (rslt.hasError()) {
+        vkDestroyImage(device, relocated, nullptr);
+        return Result<uint64>::createError(rslt.getError());
+    }
+
+    auto allocator = static_cast<std::shared_ptr<TlsfAllocator>>(rslt);
+    Result<Memory> res = allocator->allocate(memoryRequirements.size, memoryRequirements.alignment);
+    if (res.hasError()) {
+        vkDestroyImage(device, relocated, nullptr);
+        return Result<uint64>::createError(res.getError());
+    }
+
+    auto memory = static_cast<Memory>(res);
+    if (vkBindImageMemory(device, relocated, memory.getMemory(), memory.getMemoryOffset()) != VK_SUCCESS) {
+        allocator->free(memory);
+        vkDestroyImage(device, relocated, nullptr);
+        return Result<uint64>::createError(Error::FailedToBindImageMemory);
+    }
+
+    // Prepare Both Images For Copy
+    VkImageMemoryBarrier barriers[2] = { this->getImageMemoryBarrier(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL),
+                                         this->getImageMemoryBarrier(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) };
+    barriers[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barriers[1].image = relocated;
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(cmdBuffer,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         2,
+                         barriers);
+
+    // Copy Every Mip Level
+    std::vector<VkImageCopy> regions(this->mipLevels);
+    for (uint32 i = 0; i < this->mipLevels; i++) {
+        regions[i].srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        regions[i].srcSubresource.mipLevel = i;
+        regions[i].srcSubresource.baseArrayLayer = 0;
+        regions[i].srcSubresource.layerCount = this->arrayLayers;
+        regions[i].srcOffset = { 0, 0, 0 };
+        regions[i].dstSubresource = regions[i].srcSubresource;
+        regions[i].dstOffset = { 0, 0, 0 };
+        regions[i].extent.width = std::max(this->extent->width >> i, 1u);
+        regions[i].extent.height = std::max(this->extent->height >> i, 1u);
+        regions[i].extent.depth = std::max(this->extent->depth >> i, 1u);
+    }
+
+    vkCmdCopyImage(cmdBuffer,
+                   this->image,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   relocated,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   static_cast<uint32>(regions.size()),
+                   regions.data());
+
+    // Return New Image To Shader Reads
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barriers[1].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(cmdBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barriers[1]);
+
+    // Hand Old Handle And Region Over For Deferred Destruction
+    retired.image = this->image;
+    retired.allocator = std::move(this->allocator);
+    retired.memory = this->memory;
+
+    this->image = relocated;
+    this->allocator = allocator;
+    this->memory = memory;
+    this->relocations++;
+
+    return Result<uint64>(memoryRequirements.size);
+}
+
 void Image::transitionLayout(VkCommandBuffer cmdBuffer,
                              uint32 newLayout,
                              VkPipelineStageFlags sourceStage,
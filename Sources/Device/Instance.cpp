@@ -67,7 +67,7 @@ VkApplicationInfo Instance::getApplicationInfo() const noexcept {
     applicationInfo.applicationVersion = this->applicationVersion;
     applicationInfo.pEngineName = "Real Engine";
     applicationInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    applicationInfo.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+    applicationInfo.apiVersion = VK_API_VERSION_1_1;
 
     return applicationInfo;
 }
@@ -0,0 +1,266 @@
+/**
+ * LinearAllocator.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "LinearAllocator.h"
+#include "Device.h"
+#include "GraphicsManager.h"
+#include "Memory.h"
+#include "MemoryManager.h"
+
+#include <algorithm>
+#include <vulkan/vulkan.h>
+
+static inline uint64 alignUp(uint64 value, uint64 align) noexcept {
+    return (value + align - 1) & ~(align - 1);
+}
+
+LinearAllocator::LinearAllocator() {
+    this->alignment = LINEAR_MIN_ALIGNMENT;
+    this->buffer = VK_NULL_HANDLE;
+    this->flags = 0;
+    this->heap = 0;
+    this->memoryFlags = 0;
+    this->mapping = nullptr;
+    this->memory = VK_NULL_HANDLE;
+    this->frameSize = 0;
+    this->frameCount = 0;
+    this->frameIndex = 0;
+    this->head = 0;
+    this->frameAllocations = 0;
+    this->frameHeads = std::vector<uint64>();
+    this->frameAllocationCounts = std::vector<uint64>();
+    this->retainedSize = 0;
+}
+
+Result<VkDevice> LinearAllocator::getGraphicsDevice() const noexcept {
+    GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<std::weak_ptr<const Device>>(result);
+
+        if (std::shared_ptr<const Device> dev = device.lock())
+            return dev->getVulkanDevice();
+        else
+            return Result<VkDevice>::createError(Error::GraphicsManagerNotStartedUp);
+    }
+
+    return Result<VkDevice>::createError(result.getError());
+}
+
+VkMemoryAllocateInfo LinearAllocator::getMemoryAllocateInfo(VkDeviceSize siz) const noexcept {
+    VkMemoryAllocateInfo memoryAllocateInfo = {};
+
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = nullptr;
+    memoryAllocateInfo.allocationSize = siz;
+    memoryAllocateInfo.memoryTypeIndex = this->heap;
+
+    return memoryAllocateInfo;
+}
+
+LinearAllocator::~LinearAllocator() {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        if (this->buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, this->buffer, nullptr);
+            this->buffer = VK_NULL_HANDLE;
+        }
+
+        if (this->memory != VK_NULL_HANDLE) {
+            if (this->mapping != nullptr) {
+                vkUnmapMemory(device, this->memory);
+                this->mapping = nullptr;
+            }
+
+            vkFreeMemory(device, this->memory, nullptr);
+            this->memory = VK_NULL_HANDLE;
+
+            // Return Block To Heap Budget
+            MemoryManager::getManager().releaseHeapSpace(this->heap, this->getAllocatorSize());
+        }
+    }
+
+    this->frameHeads.clear();
+    this->frameAllocationCounts.clear();
+}
+
+Result<Memory> LinearAllocator::allocate(uint64 siz) {
+    return this->allocate(siz, this->alignment);
+}
+
+Result<Memory> LinearAllocator::allocate(uint64 siz, uint64 align) {
+    align = std::max(align, this->alignment);
+
+    // Bump Offset Without Locking
+    uint64 current = this->head.load(std::memory_order_relaxed);
+    uint64 offset;
+    do {
+        offset = alignUp(current, align);
+
+        if (offset + siz > this->frameSize) {
+            return Result<Memory>::createError(Error::NoMemoryAvailableInAllocator);
+        }
+    } while (!this->head.compare_exchange_weak(current, offset + siz, std::memory_order_relaxed));
+
+    this->frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    this->markAllocated();
+
+    return Result<Memory>(Memory(this->memory, this->frameIndex * this->frameSize + offset, this->heap));
+}
+
+void LinearAllocator::beginFrame(uint32 index) noexcept {
+    index %= this->frameCount;
+
+    // Keep Current Region Alive Until Its Own Fence Signals
+    this->frameHeads[this->frameIndex] = this->head;
+    this->frameAllocationCounts[this->frameIndex] = this->frameAllocations;
+
+    // Discard Everything The Reused Region Held
+    uint64 released = this->frameAllocationCounts[index];
+    this->frameHeads[index] = 0;
+    this->frameAllocationCounts[index] = 0;
+
+    uint64 retained = 0;
+    for (uint32 i = 0; i < this->frameCount; i++) {
+        if (i != index) {
+            retained += this->frameHeads[i];
+        }
+    }
+
+    this->frameIndex = index;
+    this->retainedSize = retained;
+    this->head = 0;
+    this->frameAllocations = 0;
+    this->markFreed(released);
+}
+
+Result<void> LinearAllocator::flush() {
+    if ((this->memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0 || this->head == 0) {
+        return Result<void>::createError(Error::None);
+    }
+
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkMappedMemoryRange mappedMemoryRange = {};
+
+        // Regions Are Aligned To Atom Size, So Only The End Is Rounded
+        uint64 atomSize = MemoryManager::getManager().getNonCoherentAtomSize();
+        uint64 end = std::min(alignUp(this->head, atomSize), this->frameSize);
+
+        mappedMemoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        mappedMemoryRange.pNext = nullptr;
+        mappedMemoryRange.memory = this->memory;
+        mappedMemoryRange.offset = this->frameIndex * this->frameSize;
+        mappedMemoryRange.size = end;
+
+        if (vkFlushMappedMemoryRanges(device, 1, &mappedMemoryRange) == VK_SUCCESS) {
+            return Result<void>::createError(Error::None);
+        }
+        else {
+            return Result<void>::createError(Error::FailedToFlushMemory);
+        }
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+void LinearAllocator::free(Memory &mem) {
+    mem = Memory();
+}
+
+Result<void *> LinearAllocator::map(const Memory &mem) {
+    // Only Regions Of This Block Share Its Mapping
+    if (this->mapping != nullptr && mem.getMemory() == this->memory)
+        return Result<void *>(this->mapping);
+    else
+        return Result<void *>::createError(Error::FailedToMapMemory);
+}
+
+Result<std::shared_ptr<LinearAllocator>> LinearAllocator::createAllocator(uint64 frameSize,
+                                                                          uint32 frameCount,
+                                                                          VkBufferUsageFlags usage,
+                                                                          VkMemoryPropertyFlags flags) {
+    std::shared_ptr<LinearAllocator> allocator(new LinearAllocator);
+    MemoryManager &memoryManager = MemoryManager::getManager();
+
+    // Frame Regions Must Start On Atom Boundaries For Flushes
+    allocator->alignment = std::max(LINEAR_MIN_ALIGNMENT, memoryManager.getNonCoherentAtomSize());
+    allocator->flags = flags;
+    allocator->frameCount = std::max(frameCount, 1u);
+    allocator->frameSize = alignUp(std::max<uint64>(frameSize, 1), allocator->alignment);
+    allocator->frameHeads.assign(allocator->frameCount, 0);
+    allocator->frameAllocationCounts.assign(allocator->frameCount, 0);
+
+    Result<VkDevice> result = allocator->getGraphicsDevice();
+    if (result.hasError()) {
+        return Result<std::shared_ptr<LinearAllocator>>::createError(result.getError());
+    }
+
+    auto device = static_cast<VkDevice>(result);
+    VkBufferCreateInfo bufferCreateInfo = {};
+
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.pNext = nullptr;
+    bufferCreateInfo.flags = 0;
+    bufferCreateInfo.size = allocator->getAllocatorSize();
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    bufferCreateInfo.queueFamilyIndexCount = 0;
+    bufferCreateInfo.pQueueFamilyIndices = nullptr;
+
+    if (vkCreateBuffer(device, &bufferCreateInfo, nullptr, &allocator->buffer) != VK_SUCCESS) {
+        allocator->buffer = VK_NULL_HANDLE;
+        return Result<std::shared_ptr<LinearAllocator>>::createError(Error::FailedToCreateBuffer);
+    }
+
+    VkMemoryRequirements memoryRequirements = {};
+    vkGetBufferMemoryRequirements(device, allocator->buffer, &memoryRequirements);
+
+    Result<uint32> type = Memory::chooseHeapFromFlags(memoryRequirements, flags);
+    if (type.hasError()) {
+        return Result<std::shared_ptr<LinearAllocator>>::createError(type.getError());
+    }
+
+    allocator->heap = static_cast<uint32>(type);
+
+    Result<VkPhysicalDeviceMemoryProperties> props = memoryManager.getMemoryProperties();
+    if (!props.hasError()) {
+        auto memoryProperties = static_cast<VkPhysicalDeviceMemoryProperties>(props);
+        allocator->memoryFlags = memoryProperties.memoryTypes[allocator->heap].propertyFlags;
+    }
+
+    // Block Counts Against Heap Budget Like Any Other
+    Result<void> budget = memoryManager.reserveHeapSpace(allocator->heap, allocator->getAllocatorSize());
+    if (budget.hasError()) {
+        return Result<std::shared_ptr<LinearAllocator>>::createError(budget.getError());
+    }
+
+    VkMemoryAllocateInfo memoryAllocateInfo = allocator->getMemoryAllocateInfo(memoryRequirements.size);
+    if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &allocator->memory) != VK_SUCCESS) {
+        allocator->memory = VK_NULL_HANDLE;
+        memoryManager.releaseHeapSpace(allocator->heap, allocator->getAllocatorSize());
+        return Result<std::shared_ptr<LinearAllocator>>::createError(Error::FailedToAllocateDeviceMemory);
+    }
+
+    if (vkBindBufferMemory(device, allocator->buffer, allocator->memory, 0) != VK_SUCCESS) {
+        return Result<std::shared_ptr<LinearAllocator>>::createError(Error::FailedToBindBufferMemory);
+    }
+
+    // Map Whole Block Once
+    if (vkMapMemory(device, allocator->memory, 0, VK_WHOLE_SIZE, 0, &allocator->mapping) != VK_SUCCESS) {
+        allocator->mapping = nullptr;
+        return Result<std::shared_ptr<LinearAllocator>>::createError(Error::FailedToMapMemory);
+    }
+
+    return Result<std::shared_ptr<LinearAllocator>>(std::move(allocator));
+}
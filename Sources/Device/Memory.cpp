@@ -10,16 +10,16 @@
 
 #include <vulkan/vulkan.hpp>
 
-Memory::Memory() {
+Memory::Memory() noexcept {
     this->heap = 0;
-    this->memory = nullptr;
+    this->memory = VK_NULL_HANDLE;
     this->offset = 0;
 }
 
-Memory::~Memory() {
-    this->heap = 0;
-    this->memory = VK_NULL_HANDLE;
-    this->offset = 0;
+Memory::Memory(VkDeviceMemory mem, VkDeviceSize off, uint32 hp) noexcept {
+    this->heap = hp;
+    this->memory = mem;
+    this->offset = off;
 }
 
 Result<uint32> Memory::chooseHeapFromFlags(const VkMemoryRequirements &memoryRequirements,
@@ -30,30 +30,43 @@ Result<uint32> Memory::chooseHeapFromFlags(const VkMemoryRequirements &memoryReq
     if (!result.hasError()) {
         auto memoryProperties = static_cast<VkPhysicalDeviceMemoryProperties>(result);
 
-        uint32 selectedType = 0;
-        for (uint32 memoryType = 0; memoryType < 32; memoryType++) {
-            if (memoryRequirements.memoryTypeBits & (1 << memoryType)) {
+        for (uint32 memoryType = 0; memoryType < memoryProperties.memoryTypeCount; memoryType++) {
+            if (memoryRequirements.memoryTypeBits & (1u << memoryType)) {
                 const VkMemoryType &type = memoryProperties.memoryTypes[memoryType];
 
                 if ((type.propertyFlags & requiredFlags) == requiredFlags) {
-                    selectedType = memoryType;
-                    break;
+                    return Result<uint32>(memoryType);
                 }
             }
         }
 
-        return Result<uint32>(selectedType);
+        return Result<uint32>::createError(Error::NoSuitableMemoryType);
     }
 
     return Result<uint32>::createError(result.getError());
 }
 
-std::unique_ptr<Memory> Memory::createMemory(VkDeviceMemory mem, VkDeviceSize off, uint32 hp) noexcept {
-    std::unique_ptr<Memory> newMemory(new Memory);
+uint32 Memory::getRequiredFlags(MemoryUsage usage) noexcept {
+    switch (usage) {
+        case MemoryUsage::GpuOnly:
+            return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        case MemoryUsage::Upload:
+            return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        case MemoryUsage::Readback:
+        case MemoryUsage::Dynamic:
+            return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    }
 
-    newMemory->heap = hp;
-    newMemory->memory = mem;
-    newMemory->offset = off;
+    return 0;
+}
 
-    return std::move(newMemory);
+uint32 Memory::getPreferredFlags(MemoryUsage usage) noexcept {
+    switch (usage) {
+        case MemoryUsage::Readback:
+            return VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        case MemoryUsage::Dynamic:
+            return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        default:
+            return 0;
+    }
 }
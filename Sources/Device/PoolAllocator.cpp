@@ -9,25 +9,66 @@
 #include "Device.h"
 #include "GraphicsManager.h"
 #include "Memory.h"
+#include "MemoryManager.h"
 
+#include <algorithm>
 #include <vulkan/vulkan.hpp>
 
 PoolAllocator::PoolAllocator() {
     this->alignment = 0;
+    this->blocks = std::vector<PoolBlock>();
     this->chunkSize = 0;
     this->flags = 0;
-    this->freeList = std::forward_list<std::unique_ptr<Memory>>();
+    this->freeChunks = std::vector<uint32>();
     this->heap = 0;
-    this->memory = VK_NULL_HANDLE;
     this->size = 0;
+    this->usedChunks = 0;
 }
 
-void PoolAllocator::chunkMemory() {
-    this->freeList.clear();
+Result<void> PoolAllocator::addBlock(uint64 siz) {
+    Result<VkDevice> result = this->getGraphicsDevice();
 
-    for (VkDeviceSize i = this->size / this->chunkSize - 1; i * this->chunkSize > 0; i--)
-        this->freeList.emplace_front(Memory::createMemory(this->memory, i * this->chunkSize, heap));
-    this->freeList.emplace_front(Memory::createMemory(this->memory, 0, heap));
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkMemoryAllocateInfo memoryAllocateInfo = this->getMemoryAllocateInfo(siz);
+
+        PoolBlock block = {};
+        block.firstChunk = this->blocks.empty() ? 0 : this->blocks.back().firstChunk + this->blocks.back().chunkCount;
+        block.chunkCount = static_cast<uint32>(siz / this->chunkSize);
+        block.size = siz;
+
+        if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &block.memory) != VK_SUCCESS) {
+            return Result<void>::createError(Error::FailedToAllocateDeviceMemory);
+        }
+
+        // Push Chunks In Reverse So The Lowest Offsets Are Handed Out First
+        this->freeChunks.reserve(block.firstChunk + block.chunkCount);
+        for (uint32 i = block.chunkCount; i > 0; i--)
+            this->freeChunks.push_back(block.firstChunk + i - 1);
+
+        this->blocks.push_back(block);
+        this->size += siz;
+
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+const PoolBlock *PoolAllocator::findBlock(uint32 chunk) const noexcept {
+    auto it = std::upper_bound(this->blocks.begin(), this->blocks.end(), chunk,
+                               [](uint32 value, const PoolBlock &block) { return value < block.firstChunk; });
+
+    return &*(it - 1);
+}
+
+PoolBlock *PoolAllocator::findBlock(VkDeviceMemory mem) noexcept {
+    for (auto &block : this->blocks) {
+        if (block.memory == mem)
+            return &block;
+    }
+
+    return nullptr;
 }
 
 Result<VkDevice> PoolAllocator::getGraphicsDevice() const noexcept {
@@ -46,21 +87,21 @@ Result<VkDevice> PoolAllocator::getGraphicsDevice() const noexcept {
     return Result<VkDevice>::createError(result.getError());
 }
 
-VkMemoryAllocateInfo PoolAllocator::getMemoryAllocateInfo() const noexcept {
+VkMemoryAllocateInfo PoolAllocator::getMemoryAllocateInfo(VkDeviceSize siz) const noexcept {
     VkMemoryAllocateInfo memoryAllocateInfo = {};
 
     memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     memoryAllocateInfo.pNext = nullptr;
-    memoryAllocateInfo.allocationSize = this->size;
+    memoryAllocateInfo.allocationSize = siz;
     memoryAllocateInfo.memoryTypeIndex = this->heap;
 
     return memoryAllocateInfo;
 }
 
-VkMemoryRequirements PoolAllocator::getMemoryRequirements() const noexcept {
+VkMemoryRequirements PoolAllocator::getMemoryRequirements(VkDeviceSize siz) const noexcept {
     VkMemoryRequirements memoryRequirements = {};
 
-    memoryRequirements.size = this->size;
+    memoryRequirements.size = siz;
     memoryRequirements.alignment = this->alignment;
     memoryRequirements.memoryTypeBits = 0;
     memoryRequirements.memoryTypeBits ^= ~memoryRequirements.memoryTypeBits;
@@ -69,69 +110,149 @@ VkMemoryRequirements PoolAllocator::getMemoryRequirements() const noexcept {
 }
 
 PoolAllocator::~PoolAllocator() {
-    this->freeList.clear();
+    this->freeChunks.clear();
 
-    if (this->memory != VK_NULL_HANDLE) {
+    if (!this->blocks.empty()) {
         Result<VkDevice> result = this->getGraphicsDevice();
 
         if (!result.hasError()) {
             auto device = static_cast<VkDevice>(result);
 
-            vkFreeMemory(device, this->memory, nullptr);
-            this->memory = VK_NULL_HANDLE;
+            for (auto &block : this->blocks) {
+                if (block.mapping != nullptr) {
+                    vkUnmapMemory(device, block.memory);
+                    block.mapping = nullptr;
+                }
+
+                vkFreeMemory(device, block.memory, nullptr);
+                block.memory = VK_NULL_HANDLE;
+            }
+        }
+
+        this->blocks.clear();
+    }
+}
+
+Result<Memory> PoolAllocator::allocate(VkDeviceSize siz) {
+    // Every Chunk Has The Same Size, A Larger Region Would Overlap The Next One
+    if (siz > this->chunkSize) {
+        return Result<Memory>::createError(Error::NoMemoryAvailableInAllocator);
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (this->freeChunks.empty()) {
+        // Grow Geometrically, Each Block Holds As Many Chunks As All Previous Ones
+        uint64 maxChunks = std::max<uint64>(MAX_POOL_BLOCK_SIZE / this->chunkSize, 1);
+        uint64 chunkCount = std::min<uint64>(this->size / this->chunkSize, maxChunks);
+        uint64 blockSize = std::max<uint64>(chunkCount, 1) * this->chunkSize;
+
+        Result<void> budget = MemoryManager::getManager().reserveHeapSpace(this->heap, blockSize);
+        if (budget.hasError()) {
+            return Result<Memory>::createError(budget.getError());
+        }
+
+        Result<void> result = this->addBlock(blockSize);
+        if (result.hasError()) {
+            MemoryManager::getManager().releaseHeapSpace(this->heap, blockSize);
+            return Result<Memory>::createError(result.getError());
         }
     }
+
+    uint32 chunk = this->freeChunks.back();
+    const PoolBlock *block = this->findBlock(chunk);
+
+    this->freeChunks.pop_back();
+    this->usedChunks++;
+    this->markAllocated();
+
+    return Result<Memory>(Memory(block->memory, (chunk - block->firstChunk) * this->chunkSize, this->heap));
 }
 
-Result<std::unique_ptr<Memory>> PoolAllocator::allocate(VkDeviceSize siz) {
-    if (!this->freeList.empty()) {
-        std::unique_ptr<Memory> mem = std::move(this->freeList.front());
+void PoolAllocator::free(Memory &mem) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    PoolBlock *block = mem.isValid() ? this->findBlock(mem.getMemory()) : nullptr;
 
-        this->freeList.pop_front();
-        return Result<std::unique_ptr<Memory>>(std::move(mem));
+    if (block != nullptr) {
+        this->freeChunks.push_back(block->firstChunk + static_cast<uint32>(mem.getMemoryOffset() / this->chunkSize));
+        this->usedChunks--;
+        this->markFreed();
     }
 
-    return Result<std::unique_ptr<Memory>>::createError(Error::NoMemoryAvailableInAllocator);
+    mem = Memory();
+}
+
+uint32 PoolAllocator::getBlockCount() noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return static_cast<uint32>(this->blocks.size());
+}
+
+uint64 PoolAllocator::getChunkCount() noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->freeChunks.size() + this->usedChunks;
+}
+
+uint64 PoolAllocator::getBlockSize(const Memory &mem) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    PoolBlock *block = this->findBlock(mem.getMemory());
+
+    return block != nullptr ? block->size : 0;
 }
 
-void PoolAllocator::free(std::unique_ptr<Memory> &mem) {
-    this->freeList.emplace_front(std::move(mem));
+Result<void *> PoolAllocator::map(const Memory &mem) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    PoolBlock *block = this->findBlock(mem.getMemory());
+
+    if (block == nullptr) {
+        return Result<void *>::createError(Error::FailedToMapMemory);
+    }
+
+    if (block->mapping == nullptr) {
+        Result<VkDevice> result = this->getGraphicsDevice();
+
+        if (!result.hasError()) {
+            auto device = static_cast<VkDevice>(result);
+
+            // Map Whole Block Once
+            if (vkMapMemory(device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapping) != VK_SUCCESS) {
+                block->mapping = nullptr;
+                return Result<void *>::createError(Error::FailedToMapMemory);
+            }
+        }
+        else {
+            return Result<void *>::createError(result.getError());
+        }
+    }
+
+    return Result<void *>(block->mapping);
 }
 
 Result<std::shared_ptr<PoolAllocator>> PoolAllocator::createAllocator(VkDeviceSize initialSize,
                                                                       VkDeviceSize partitionSize,
                                                                       VkDeviceSize alignment,
+                                                                      uint32 memoryTypeBits,
                                                                       VkMemoryPropertyFlags flags) {
     std::shared_ptr<PoolAllocator> allocator(new PoolAllocator);
 
     allocator->alignment = alignment;
     allocator->chunkSize = partitionSize;
     allocator->flags = flags;
-    allocator->size = initialSize;
 
-    Result<uint32> res = Memory::chooseHeapFromFlags(allocator->getMemoryRequirements(), flags);
+    VkMemoryRequirements memoryRequirements = allocator->getMemoryRequirements(initialSize);
+    memoryRequirements.memoryTypeBits = memoryTypeBits;
 
-    if (!res.hasError()) {
-        auto hp = static_cast<uint32>(res);
-        allocator->heap = hp;
+    Result<uint32> res = Memory::chooseHeapFromFlags(memoryRequirements, flags);
 
-        // Allocate Memory with Vulkan
-        Result<VkDevice> rslt = allocator->getGraphicsDevice();
-        VkMemoryAllocateInfo memoryAllocateInfo = allocator->getMemoryAllocateInfo();
+    if (!res.hasError()) {
+        allocator->heap = static_cast<uint32>(res);
 
-        if (!rslt.hasError()) {
-            auto device = static_cast<VkDevice>(rslt);
-            VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &allocator->memory);
+        // Allocate First Block with Vulkan
+        Result<void> result = allocator->addBlock(std::max(initialSize, partitionSize));
 
-            if (result == VK_SUCCESS) {
-                allocator->chunkMemory();
-                return Result<std::shared_ptr<PoolAllocator>>(std::move(allocator));
-            }
-            else
-                return Result<std::shared_ptr<PoolAllocator>>::createError(Error::FailedToAllocateDeviceMemory);
-        }
+        if (!result.hasError())
+            return Result<std::shared_ptr<PoolAllocator>>(std::move(allocator));
         else
-            return Result<std::shared_ptr<PoolAllocator>>::createError(rslt.getError());
+            return Result<std::shared_ptr<PoolAllocator>>::createError(result.getError());
     }
 
     return Result<std::shared_ptr<PoolAllocator>>::createError(res.getError());
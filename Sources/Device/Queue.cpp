@@ -12,36 +12,24 @@
 #include <vulkan/vulkan.h>
 
 Queue::Queue() {
-    this->buffer = VK_NULL_HANDLE;
     this->pool = VK_NULL_HANDLE;
     this->queue = VK_NULL_HANDLE;
     this->familyIndex = 0;
     this->queueIndex = 0;
 }
 
-VkCommandBufferAllocateInfo Queue::getCommandBufferAllocateInfo() const noexcept {
+VkCommandBufferAllocateInfo Queue::getCommandBufferAllocateInfo(uint32 level) const noexcept {
     VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
 
     commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     commandBufferAllocateInfo.pNext = nullptr;
     commandBufferAllocateInfo.commandBufferCount = 1;
     commandBufferAllocateInfo.commandPool = this->pool;
-    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.level = static_cast<VkCommandBufferLevel>(level);
 
     return commandBufferAllocateInfo;
 }
 
-VkCommandBufferBeginInfo Queue::getCommandBufferBeginInfo() const noexcept {
-    VkCommandBufferBeginInfo commandBufferBeginInfo = {};
-    
-    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    commandBufferBeginInfo.pNext = nullptr;
-    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    commandBufferBeginInfo.pInheritanceInfo = nullptr;
-    
-    return commandBufferBeginInfo;
-}
-
 VkCommandPoolCreateInfo Queue::getCommandPoolCreateInfo() const noexcept {
     VkCommandPoolCreateInfo commandPoolCreateInfo = {};
 
@@ -69,7 +57,8 @@ Result<VkDevice> Queue::getGraphicsDevice() const noexcept {
     return Result<VkDevice>::createError(result.getError());
 }
 
-VkSubmitInfo Queue::getSubmitInfo(VkSemaphore const *signals,
+VkSubmitInfo Queue::getSubmitInfo(VkCommandBuffer const *cmdBuffer,
+                                  VkSemaphore const *signals,
                                   uint32 signalCount,
                                   VkSemaphore const *waits,
                                   uint32 waitCount,
@@ -79,7 +68,7 @@ VkSubmitInfo Queue::getSubmitInfo(VkSemaphore const *signals,
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.pNext = nullptr;
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &this->buffer;
+    submitInfo.pCommandBuffers = cmdBuffer;
     submitInfo.waitSemaphoreCount = waitCount;
     submitInfo.pWaitSemaphores = waits;
     submitInfo.signalSemaphoreCount = signalCount;
@@ -94,11 +83,6 @@ Queue::~Queue() {
     if (!result.hasError()) {
         auto device = static_cast<VkDevice>(result);
 
-        if (this->buffer != VK_NULL_HANDLE) {
-            vkFreeCommandBuffers(device, this->pool, 1, &this->buffer);
-            this->buffer = VK_NULL_HANDLE;
-        }
-
         if (this->pool != VK_NULL_HANDLE) {
             vkDestroyCommandPool(device, this->pool, nullptr);
             this->pool = VK_NULL_HANDLE;
@@ -106,8 +90,23 @@ Queue::~Queue() {
     }
 }
 
-void Queue::bindPipeline(VkPipeline pipeline) {
-    vkCmdBindPipeline(this->buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+Result<VkCommandBuffer> Queue::allocateBuffer(uint32 level) const noexcept {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkCommandBufferAllocateInfo commandBufferAllocateInfo = this->getCommandBufferAllocateInfo(level);
+        VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+
+        if (vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &cmdBuffer) == VK_SUCCESS) {
+            return Result<VkCommandBuffer>(cmdBuffer);
+        }
+        else {
+            return Result<VkCommandBuffer>::createError(Error::FailedToAllocateCommandBuffer);
+        }
+    }
+
+    return Result<VkCommandBuffer>::createError(result.getError());
 }
 
 Result<std::shared_ptr<Queue>> Queue::createQueue(VkDevice device,
@@ -125,35 +124,12 @@ Result<std::shared_ptr<Queue>> Queue::createQueue(VkDevice device,
     VkResult result = vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &queue->pool);
 
     if (result == VK_SUCCESS) {
-        VkCommandBufferAllocateInfo commandBufferAllocateInfo = queue->getCommandBufferAllocateInfo();
-        VkResult rslt = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &queue->buffer);
-        
-        if (rslt == VK_SUCCESS) {
-            VkCommandBufferBeginInfo commandBufferBeginInfo = queue->getCommandBufferBeginInfo();
-            
-            VkResult res = vkBeginCommandBuffer(queue->buffer, &commandBufferBeginInfo);
-            if (res == VK_SUCCESS) {
-                return Result<std::shared_ptr<Queue>>(std::move(queue));
-            }
-            else {
-                return Result<std::shared_ptr<Queue>>::createError(Error::FailedToAllocateCommandBuffer);
-            }
-        }
-        else {
-            return Result<std::shared_ptr<Queue>>::createError(Error::FailedToAllocateCommandBuffer);
-        }
+        return Result<std::shared_ptr<Queue>>(std::move(queue));
     }
 
     return Result<std::shared_ptr<Queue>>::createError(Error::FailedToCreateCommandPool);
 }
 
-Result<VkCommandBuffer> Queue::getVulkanBuffer() const noexcept {
-    if (this->buffer != VK_NULL_HANDLE)
-        return Result<VkCommandBuffer>(this->buffer);
-    else
-        return Result<VkCommandBuffer>::createError(Error::FailedToRetrieveQueue);
-}
-
 Result<VkCommandPool> Queue::getVulkanPool() const noexcept {
     if (this->pool != VK_NULL_HANDLE)
         return Result<VkCommandPool>(this->pool);
@@ -168,22 +144,24 @@ Result<VkQueue> Queue::getVulkanQueue() const noexcept {
         return Result<VkQueue>::createError(Error::FailedToRetrieveQueue);
 }
 
-void Queue::resetBuffers() {
-    VkCommandBufferBeginInfo commandBufferBeginInfo = this->getCommandBufferBeginInfo();
+void Queue::freeBuffer(VkCommandBuffer cmdBuffer) const noexcept {
+    Result<VkDevice> result = this->getGraphicsDevice();
 
-    vkResetCommandBuffer(this->buffer, 0);
-    vkBeginCommandBuffer(this->buffer, &commandBufferBeginInfo);
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        vkFreeCommandBuffers(device, this->pool, 1, &cmdBuffer);
+    }
 }
 
-Result<void> Queue::submit(VkSemaphore const *signals,
+Result<void> Queue::submit(VkCommandBuffer cmdBuffer,
+                           VkSemaphore const *signals,
                            uint32 signalCount,
                            VkSemaphore const *waits,
                            uint32 waitCount,
                            uint32 *stages,
                            VkFence fence) const noexcept {
-    VkSubmitInfo submitInfo = this->getSubmitInfo(signals, signalCount, waits, waitCount, stages);
-    
-    vkEndCommandBuffer(this->buffer);
+    VkSubmitInfo submitInfo = this->getSubmitInfo(&cmdBuffer, signals, signalCount, waits, waitCount, stages);
+
     VkResult result = vkQueueSubmit(this->queue, 1, &submitInfo, fence);
     if (result == VK_SUCCESS) {
         return Result<void>::createError(Error::None);
@@ -0,0 +1,401 @@
+/**
+ * TlsfAllocator.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "TlsfAllocator.h"
+#include "Device.h"
+#include "GraphicsManager.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <vulkan/vulkan.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static inline uint32 findFirstSet(uint32 value) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<uint32>(index);
+#else
+    return static_cast<uint32>(__builtin_ctz(value));
+#endif
+}
+
+static inline uint32 findLastSet(uint64 value) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32>(index);
+#else
+    return static_cast<uint32>(63 - __builtin_clzll(value));
+#endif
+}
+
+static inline uint64 alignUp(uint64 value, uint64 align) noexcept {
+    return (value + align - 1) & ~(align - 1);
+}
+
+TlsfAllocator::TlsfAllocator() {
+    this->alignment = TLSF_MIN_ALIGNMENT;
+    this->flags = 0;
+    this->heap = 0;
+    this->mapping = nullptr;
+    this->memory = VK_NULL_HANDLE;
+    this->size = 0;
+    this->usedSize = 0;
+    this->flBitmap = 0;
+    this->slBitmaps.fill(0);
+
+    for (auto &heads : this->freeHeads) {
+        heads.fill(nullptr);
+    }
+}
+
+TlsfBlock *TlsfAllocator::acquireBlock() {
+    if (!this->spareBlocks.empty()) {
+        TlsfBlock *block = this->spareBlocks.back();
+
+        this->spareBlocks.pop_back();
+        return block;
+    }
+
+    this->blockStorage.emplace_back();
+    return &this->blockStorage.back();
+}
+
+TlsfBlock *TlsfAllocator::findSuitableBlock(uint32 &fl, uint32 &sl) const noexcept {
+    uint32 slMap = this->slBitmaps[fl] & (~0u << sl);
+
+    // Fall Back To The Next Non-Empty First Level Class
+    if (slMap == 0) {
+        uint32 flMap = fl + 1 < 32 ? this->flBitmap & (~0u << (fl + 1)) : 0;
+
+        if (flMap == 0) {
+            return nullptr;
+        }
+
+        fl = findFirstSet(flMap);
+        slMap = this->slBitmaps[fl];
+    }
+
+    sl = findFirstSet(slMap);
+    return this->freeHeads[fl][sl];
+}
+
+Result<VkDevice> TlsfAllocator::getGraphicsDevice() const noexcept {
+    GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<std::weak_ptr<const Device>>(result);
+
+        if (std::shared_ptr<const Device> dev = device.lock())
+            return dev->getVulkanDevice();
+        else
+            return Result<VkDevice>::createError(Error::GraphicsManagerNotStartedUp);
+    }
+
+    return Result<VkDevice>::createError(result.getError());
+}
+
+VkMemoryAllocateInfo TlsfAllocator::getMemoryAllocateInfo() const noexcept {
+    VkMemoryAllocateInfo memoryAllocateInfo = {};
+
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = nullptr;
+    memoryAllocateInfo.allocationSize = this->size;
+    memoryAllocateInfo.memoryTypeIndex = this->heap;
+
+    return memoryAllocateInfo;
+}
+
+void TlsfAllocator::insertFreeBlock(TlsfBlock *block) noexcept {
+    uint32 fl, sl;
+    mappingInsert(block->size, fl, sl);
+
+    block->bFree = true;
+    block->prevFree = nullptr;
+    block->nextFree = this->freeHeads[fl][sl];
+
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block;
+    }
+
+    this->freeHeads[fl][sl] = block;
+    this->flBitmap |= 1u << fl;
+    this->slBitmaps[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::mappingInsert(uint64 siz, uint32 &fl, uint32 &sl) noexcept {
+    if (siz < TLSF_SMALL_BLOCK_SIZE) {
+        fl = 0;
+        sl = static_cast<uint32>(siz / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+    }
+    else {
+        uint32 bit = findLastSet(siz);
+
+        fl = bit - (TLSF_FL_INDEX_SHIFT - 1);
+        sl = static_cast<uint32>(siz >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+    }
+}
+
+void TlsfAllocator::mappingSearch(uint64 siz, uint32 &fl, uint32 &sl) noexcept {
+    // Round Up So Every Block In The Resulting Class Fits
+    if (siz >= TLSF_SMALL_BLOCK_SIZE) {
+        siz += (1ull << (findLastSet(siz) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    mappingInsert(siz, fl, sl);
+}
+
+void TlsfAllocator::releaseBlock(TlsfBlock *block) {
+    this->spareBlocks.push_back(block);
+}
+
+void TlsfAllocator::removeFreeBlock(TlsfBlock *block) noexcept {
+    uint32 fl, sl;
+    mappingInsert(block->size, fl, sl);
+
+    if (block->prevFree != nullptr) {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else {
+        this->freeHeads[fl][sl] = block->nextFree;
+    }
+
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+
+    // Clear Bitmaps Once The List Empties
+    if (this->freeHeads[fl][sl] == nullptr) {
+        this->slBitmaps[fl] &= ~(1u << sl);
+
+        if (this->slBitmaps[fl] == 0) {
+            this->flBitmap &= ~(1u << fl);
+        }
+    }
+
+    block->bFree = false;
+    block->prevFree = nullptr;
+    block->nextFree = nullptr;
+}
+
+TlsfBlock *TlsfAllocator::splitBlock(TlsfBlock *block, uint64 siz) {
+    TlsfBlock *remainder = this->acquireBlock();
+
+    remainder->offset = block->offset + siz;
+    remainder->size = block->size - siz;
+    remainder->prevPhysical = block;
+    remainder->nextPhysical = block->nextPhysical;
+    remainder->prevFree = nullptr;
+    remainder->nextFree = nullptr;
+    remainder->bFree = false;
+
+    if (remainder->nextPhysical != nullptr) {
+        remainder->nextPhysical->prevPhysical = remainder;
+    }
+
+    block->nextPhysical = remainder;
+    block->size = siz;
+
+    return remainder;
+}
+
+TlsfAllocator::~TlsfAllocator() {
+    this->usedBlocks.clear();
+    this->spareBlocks.clear();
+    this->blockStorage.clear();
+
+    if (this->memory != VK_NULL_HANDLE) {
+        Result<VkDevice> result = this->getGraphicsDevice();
+
+        if (!result.hasError()) {
+            auto device = static_cast<VkDevice>(result);
+
+            if (this->mapping != nullptr) {
+                vkUnmapMemory(device, this->memory);
+                this->mapping = nullptr;
+            }
+
+            vkFreeMemory(device, this->memory, nullptr);
+            this->memory = VK_NULL_HANDLE;
+        }
+    }
+}
+
+Result<Memory> TlsfAllocator::allocate(uint64 siz) {
+    return this->allocate(siz, this->alignment);
+}
+
+Result<Memory> TlsfAllocator::allocate(uint64 siz, uint64 align) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    align = std::max(align, this->alignment);
+    siz = alignUp(std::max<uint64>(siz, 1), TLSF_MIN_ALIGNMENT);
+
+    // Reserve Room For Worst Case Alignment Padding
+    uint64 searchSize = siz + (align - TLSF_MIN_ALIGNMENT);
+    if (searchSize > this->size) {
+        return Result<Memory>::createError(Error::NoMemoryAvailableInAllocator);
+    }
+
+    uint32 fl, sl;
+    mappingSearch(searchSize, fl, sl);
+
+    TlsfBlock *block = fl < TLSF_FL_INDEX_COUNT ? this->findSuitableBlock(fl, sl) : nullptr;
+    if (block == nullptr) {
+        return Result<Memory>::createError(Error::NoMemoryAvailableInAllocator);
+    }
+
+    this->removeFreeBlock(block);
+
+    // Return Leading Padding To The Free Lists
+    uint64 padding = alignUp(block->offset, align) - block->offset;
+    if (padding > 0) {
+        TlsfBlock *aligned = this->splitBlock(block, padding);
+
+        this->insertFreeBlock(block);
+        block = aligned;
+    }
+
+    // Return Trailing Space To The Free Lists
+    if (block->size - siz >= TLSF_MIN_ALIGNMENT) {
+        this->insertFreeBlock(this->splitBlock(block, siz));
+    }
+
+    this->usedBlocks.emplace(block->offset, block);
+    this->usedSize += block->size;
+    this->markAllocated();
+
+    return Result<Memory>(Memory(this->memory, block->offset, this->heap));
+}
+
+bool TlsfAllocator::canAllocate(uint64 siz, uint64 align) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    align = std::max(align, this->alignment);
+    uint64 searchSize = alignUp(std::max<uint64>(siz, 1), TLSF_MIN_ALIGNMENT) + (align - TLSF_MIN_ALIGNMENT);
+
+    if (searchSize > this->size) {
+        return false;
+    }
+
+    uint32 fl, sl;
+    mappingSearch(searchSize, fl, sl);
+
+    return fl < TLSF_FL_INDEX_COUNT && this->findSuitableBlock(fl, sl) != nullptr;
+}
+
+void TlsfAllocator::free(Memory &mem) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto it = mem.isValid() ? this->usedBlocks.find(mem.getMemoryOffset()) : this->usedBlocks.end();
+    mem = Memory();
+
+    if (it == this->usedBlocks.end()) {
+        return;
+    }
+
+    TlsfBlock *block = it->second;
+    this->usedBlocks.erase(it);
+    this->usedSize -= block->size;
+    this->markFreed();
+
+    // Merge With Free Physical Neighbours
+    TlsfBlock *prev = block->prevPhysical;
+    if (prev != nullptr && prev->bFree) {
+        this->removeFreeBlock(prev);
+
+        prev->size += block->size;
+        prev->nextPhysical = block->nextPhysical;
+        if (prev->nextPhysical != nullptr) {
+            prev->nextPhysical->prevPhysical = prev;
+        }
+
+        this->releaseBlock(block);
+        block = prev;
+    }
+
+    TlsfBlock *next = block->nextPhysical;
+    if (next != nullptr && next->bFree) {
+        this->removeFreeBlock(next);
+
+        block->size += next->size;
+        block->nextPhysical = next->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = block;
+        }
+
+        this->releaseBlock(next);
+    }
+
+    this->insertFreeBlock(block);
+}
+
+Result<void *> TlsfAllocator::map(const Memory &mem) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (this->mapping == nullptr) {
+        Result<VkDevice> result = this->getGraphicsDevice();
+
+        if (!result.hasError()) {
+            auto device = static_cast<VkDevice>(result);
+
+            // Map Whole Block Once
+            if (vkMapMemory(device, this->memory, 0, VK_WHOLE_SIZE, 0, &this->mapping) != VK_SUCCESS) {
+                this->mapping = nullptr;
+                return Result<void *>::createError(Error::FailedToMapMemory);
+            }
+        }
+        else {
+            return Result<void *>::createError(result.getError());
+        }
+    }
+
+    return Result<void *>(this->mapping);
+}
+
+Result<std::shared_ptr<TlsfAllocator>> TlsfAllocator::createAllocator(uint64 initialSize,
+                                                                      uint64 alignment,
+                                                                      uint32 heap,
+                                                                      uint32 flags) {
+    std::shared_ptr<TlsfAllocator> allocator(new TlsfAllocator);
+
+    allocator->alignment = std::max(alignment, TLSF_MIN_ALIGNMENT);
+    allocator->flags = flags;
+    allocator->heap = heap;
+    allocator->size = std::min(alignUp(initialSize, TLSF_MIN_ALIGNMENT), (static_cast<uint64>(1) << TLSF_FL_INDEX_MAX) - TLSF_MIN_ALIGNMENT);
+
+    // Allocate Memory with Vulkan
+    Result<VkDevice> rslt = allocator->getGraphicsDevice();
+    VkMemoryAllocateInfo memoryAllocateInfo = allocator->getMemoryAllocateInfo();
+
+    if (!rslt.hasError()) {
+        auto device = static_cast<VkDevice>(rslt);
+        VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &allocator->memory);
+
+        if (result == VK_SUCCESS) {
+            TlsfBlock *block = allocator->acquireBlock();
+
+            // Whole Block Starts As A Single Free Region
+            block->offset = 0;
+            block->size = allocator->size;
+            block->prevPhysical = nullptr;
+            block->nextPhysical = nullptr;
+            allocator->insertFreeBlock(block);
+
+            return Result<std::shared_ptr<TlsfAllocator>>(std::move(allocator));
+        }
+        else
+            return Result<std::shared_ptr<TlsfAllocator>>::createError(Error::FailedToAllocateDeviceMemory);
+    }
+
+    return Result<std::shared_ptr<TlsfAllocator>>::createError(rslt.getError());
+}
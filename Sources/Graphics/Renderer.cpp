@@ -6,18 +6,29 @@
  */
 
 #include "Buffer.h"
+#include "Defragmenter.h"
 #include "Device.h"
 #include "GraphicsManager.h"
 #include "Image.h"
+#include "JobManager.h"
+#include "LinearAllocator.h"
 #include "Material.h"
+#include "MemoryManager.h"
 #include "Renderer.h"
 #include "SpriteComponent.h"
+#include "SpriteStorage.h"
+#include "SpriteTransform.h"
 #include "Queue.h"
 #include "Texture.h"
+#include "TextureCache.h"
+#include "TextureLoader.h"
+#include "TransferScheduler.h"
 #include "Window.h"
 #include "WindowManager.h"
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 #include <vulkan/vulkan.h>
 
 Result<void> Renderer::acquireSwapchainAndBuffers() {
@@ -95,15 +106,102 @@ Result<void> Renderer::allocateDescriptorSets() {
     if (!result.hasError()) {
         auto device = static_cast<VkDevice>(result);
 
-        this->descriptorSets.resize(this->numOfObjectsToRender);
-        for (uint32 i = 0; i < this->numOfObjectsToRender; i++) {
-            VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = this->getDescriptorSetAllocateInfo();
+        VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = this->getDescriptorSetAllocateInfo();
 
+        // Allocate One Set Per Frame, Updated Only While That Frame Is Idle
+        for (auto &frame : this->frames) {
             if (vkAllocateDescriptorSets(device,
                                          &descriptorSetAllocateInfo,
-                                         &this->descriptorSets[i]) != VK_SUCCESS) {
+                                         &frame.descriptorSet) != VK_SUCCESS) {
                 return Result<void>::createError(Error::FailedToAllocateDescriptorSets);
             }
+
+            frame.boundTextures = 0;
+        }
+
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createBatches() {
+    auto textureCount = static_cast<uint32>(this->spriteStorage->getTextures().size());
+    uint32 count = this->spriteStorage->getSize();
+
+    if (textureCount > this->textureCapacity) {
+        return Result<void>::createError(Error::TooManyTextures);
+    }
+
+    // Keep Each Texture Contiguous When Draws Cannot Index Textures Per Instance
+    if (!this->bDescriptorIndexing) {
+        this->spriteStorage->sortByTexture();
+    }
+
+    // Count Sprites Per Texture
+    const uint32 *textureIds = this->spriteStorage->getTextureIds();
+    this->batches.assign(textureCount, RenderBatch {});
+    for (uint32 i = 0; i < count; i++) {
+        this->batches[textureIds[i]].instanceCount++;
+    }
+
+    // Assign Instance Ranges
+    uint32 firstInstance = 0;
+    for (uint32 i = 0; i < textureCount; i++) {
+        this->batches[i].textureIndex = i;
+        this->batches[i].firstInstance = firstInstance;
+        firstInstance += this->batches[i].instanceCount;
+    }
+
+    this->batchVersion = this->spriteStorage->getLayoutVersion();
+    return Result<void>::createError(Error::None);
+}
+
+Result<void> Renderer::createCommandBuffers() {
+    for (auto &frame : this->frames) {
+        Result<VkCommandBuffer> result = this->deviceQueues[0]->allocateBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        if (result.hasError()) {
+            return Result<void>::createError(result.getError());
+        }
+
+        frame.cmdBuffer = static_cast<VkCommandBuffer>(result);
+    }
+
+    return Result<void>::createError(Error::None);
+}
+
+Result<void> Renderer::createRecordSlots() {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkCommandPoolCreateInfo commandPoolCreateInfo = this->getCommandPoolCreateInfo();
+
+        this->recordSlots.resize(MAX_RECORD_JOBS);
+        for (auto &slot : this->recordSlots) {
+            slot.pools.resize(this->frames.size(), VK_NULL_HANDLE);
+            slot.cmdBuffers.resize(this->frames.size(), VK_NULL_HANDLE);
+            slot.firstInstance = 0;
+            slot.instanceCount = 0;
+
+            // Create One Pool Per Frame, Recorded By One Job At A Time
+            for (uint32 i = 0; i < static_cast<uint32>(this->frames.size()); i++) {
+                if (vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &slot.pools[i]) != VK_SUCCESS) {
+                    return Result<void>::createError(Error::FailedToCreateCommandPool);
+                }
+
+                VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+                commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                commandBufferAllocateInfo.pNext = nullptr;
+                commandBufferAllocateInfo.commandBufferCount = 1;
+                commandBufferAllocateInfo.commandPool = slot.pools[i];
+                commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+                if (vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &slot.cmdBuffers[i]) != VK_SUCCESS) {
+                    return Result<void>::createError(Error::FailedToAllocateCommandBuffer);
+                }
+            }
         }
 
         return Result<void>::createError(Error::None);
@@ -165,15 +263,16 @@ Result<void> Renderer::createFences() {
         auto device = static_cast<VkDevice>(result);
         VkFenceCreateInfo fenceCreateInfo = this->getFenceCreateInfo();
 
-        if (vkCreateFence(device,
-                          &fenceCreateInfo,
-                          nullptr,
-                          &this->imageFence) == VK_SUCCESS) {
-            return Result<void>::createError(Error::None);
-        }
-        else {
-            return Result<void>::createError(Error::FailedToCreateFence);
+        for (auto &frame : this->frames) {
+            if (vkCreateFence(device,
+                              &fenceCreateInfo,
+                              nullptr,
+                              &frame.fence) != VK_SUCCESS) {
+                return Result<void>::createError(Error::FailedToCreateFence);
+            }
         }
+
+        return Result<void>::createError(Error::None);
     }
 
     return Result<void>::createError(result.getError());
@@ -204,8 +303,9 @@ Result<void> Renderer::createFramebuffers() {
 }
 
 Result<void> Renderer::createMaterial() {
+    const utf8 *fragmentFilename = this->bDescriptorIndexing ? "Shaders/frag_nonuniform.spv" : "Shaders/frag.spv";
     Result<std::shared_ptr<Material>> result = Material::createMaterial("Shaders/vert.spv",
-                                                                        "Shaders/frag.spv");
+                                                                        fragmentFilename);
 
     if (!result.hasError()) {
         this->material = static_cast<std::shared_ptr<Material>>(result);
@@ -244,9 +344,14 @@ Result<void> Renderer::createPipeline() {
         VkPipelineColorBlendAttachmentState attachmentState = this->getColorBlendAttachmentState();
         VkViewport viewport = this->getViewport();
         VkRect2D rect = this->getRect2D();
-        VkVertexInputBindingDescription bindings = Vertex::getBindingDescription();
+        std::vector<VkVertexInputBindingDescription> bindings = { Vertex::getBindingDescription(),
+                                                                  InstanceData::getBindingDescription() };
         std::vector<VkVertexInputAttributeDescription> attributes = Vertex::getAttributeDescription();
-        std::vector<VkPipelineShaderStageCreateInfo> shaderStages = this->getShaderStageCreateInfo();
+        std::vector<VkVertexInputAttributeDescription> instanceAttributes = InstanceData::getAttributeDescription();
+        VkSpecializationMapEntry specializationEntry = { 0, 0, sizeof(uint32) };
+        VkSpecializationInfo specializationInfo = { 1, &specializationEntry, sizeof(uint32), &this->textureCapacity };
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages = this->getShaderStageCreateInfo(&specializationInfo);
+        attributes.insert(attributes.end(), instanceAttributes.begin(), instanceAttributes.end());
         VkPipelineVertexInputStateCreateInfo vertexInputState = this->getVertexInputStateCreateInfo(&bindings,
                                                                                                     &attributes);
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = this->getInputAssemblyStateCreateInfo();
@@ -314,21 +419,20 @@ Result<void> Renderer::createSemaphores() {
         auto device = static_cast<VkDevice>(result);
         VkSemaphoreCreateInfo semaphoreCreateInfo = this->getSemaphoreCreateInfo();
 
-        // Create Image Buffer Semaphore
-        if (vkCreateSemaphore(device,
-                              &semaphoreCreateInfo,
-                              nullptr,
-                              &this->imageSemaphore) != VK_SUCCESS) {
-            return Result<void>::createError(Error::FailedToCreateSemaphore);
-        }
+        for (auto &frame : this->frames) {
+            // Create Image Acquire Semaphore
+            if (vkCreateSemaphore(device,
+                                  &semaphoreCreateInfo,
+                                  nullptr,
+                                  &frame.imageSemaphore) != VK_SUCCESS) {
+                return Result<void>::createError(Error::FailedToCreateSemaphore);
+            }
 
-        // Create Queue Semaphores
-        this->queueSemaphores.resize(this->deviceQueues.size() - 1);
-        for (uint32 i = 0; i < static_cast<uint32>(this->deviceQueues.size() - 1); i++) {
+            // Create Render Complete Semaphore
             if (vkCreateSemaphore(device,
                                   &semaphoreCreateInfo,
                                   nullptr,
-                                  &this->queueSemaphores[i]) != VK_SUCCESS) {
+                                  &frame.renderSemaphore) != VK_SUCCESS) {
                 return Result<void>::createError(Error::FailedToCreateSemaphore);
             }
         }
@@ -360,21 +464,157 @@ Result<void> Renderer::createTextureSampler() {
     return Result<void>::createError(result.getError());
 }
 
-Result<void> Renderer::createTransformBuffers() {
-    this->transformBuffers.resize(this->numOfObjectsToRender);
-    for (auto &buffer : this->transformBuffers) {
-        Result<std::shared_ptr<Buffer>> bufferResult = Buffer::createBuffer(sizeof(Transform),
-                                                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
-        if (bufferResult.hasError()) {
-            return Result<void>::createError(bufferResult.getError());
+Result<void> Renderer::createDefragmenter() {
+    Result<std::shared_ptr<Defragmenter>> result =
+            Defragmenter::createDefragmenter(static_cast<uint32>(this->frames.size()));
+
+    if (!result.hasError()) {
+        this->defragmenter = static_cast<std::shared_ptr<Defragmenter>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createFrameAllocator() {
+    MemoryManager &memoryManager = MemoryManager::getManager();
+    Result<std::shared_ptr<LinearAllocator>> result =
+            memoryManager.requestLinearAllocator(DEFAULT_FRAME_ARENA_SIZE,
+                                                 static_cast<uint32>(this->frames.size()),
+                                                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                 Memory::getRequiredFlags(MemoryUsage::Upload));
+
+    if (!result.hasError()) {
+        this->frameAllocator = static_cast<std::shared_ptr<LinearAllocator>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createTextureLoader() {
+    Result<std::shared_ptr<TextureLoader>> result = TextureLoader::createTextureLoader(this->transferScheduler);
+
+    if (!result.hasError()) {
+        this->textureLoader = static_cast<std::shared_ptr<TextureLoader>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createTextureCache() {
+    Result<std::shared_ptr<TextureCache>> result =
+            TextureCache::createTextureCache(static_cast<uint32>(this->frames.size()));
+
+    if (!result.hasError()) {
+        this->textureCache = static_cast<std::shared_ptr<TextureCache>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createPlaceholderTexture() {
+    Result<std::shared_ptr<Texture>> result = Texture::createTexture(1, 1);
+
+    if (!result.hasError()) {
+        this->placeholderTexture = static_cast<std::shared_ptr<Texture>>(result);
+
+        // Transparent Texel Until Streamed Textures Become Resident
+        Result<void> rslt = this->placeholderTexture->load();
+        if (!rslt.hasError()) {
+            return this->transferScheduler->wait(this->placeholderTexture->getTransferTicket());
         }
 
-        buffer = std::move(static_cast<std::shared_ptr<Buffer>>(bufferResult));
+        return rslt;
     }
 
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createTransferScheduler() {
+    Result<std::shared_ptr<TransferScheduler>> result =
+            TransferScheduler::createTransferScheduler(this->transferQueue, this->deviceQueues[0]->getFamily());
+
+    if (!result.hasError()) {
+        this->transferScheduler = static_cast<std::shared_ptr<TransferScheduler>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::createInstanceBuffer() {
+    Result<std::shared_ptr<Buffer>> result =
+            Buffer::createBuffer(this->frames.size() * this->instanceCapacity * sizeof(InstanceData),
+                                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                 MemoryUsage::Dynamic);
+
+    if (!result.hasError()) {
+        this->instanceBuffer = static_cast<std::shared_ptr<Buffer>>(result);
+
+        // Acquire Persistent Mapping
+        Result<void *> rslt = this->instanceBuffer->map();
+        if (!rslt.hasError()) {
+            this->instanceMapping = static_cast<uint8 *>(static_cast<void *>(rslt));
+
+            return Result<void>::createError(Error::None);
+        }
+        else {
+            return Result<void>::createError(rslt.getError());
+        }
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<void> Renderer::growInstanceBuffer(uint32 count) {
+    std::shared_ptr<Buffer> previous = this->instanceBuffer;
+    uint8 *previousMapping = this->instanceMapping;
+    uint32 previousCapacity = this->instanceCapacity;
+
+    this->instanceCapacity = std::max({ count, 2 * previousCapacity, MIN_INSTANCE_CAPACITY });
+
+    Result<void> result = this->createInstanceBuffer();
+    if (result.hasError()) {
+        this->instanceBuffer = std::move(previous);
+        this->instanceMapping = previousMapping;
+        this->instanceCapacity = previousCapacity;
+        return result;
+    }
+
+    // Other Frames In Flight May Still Read Previous Buffer
+    for (uint32 i = 0; i < static_cast<uint32>(this->frames.size()); i++) {
+        if (i != this->frameIndex && previous != nullptr) {
+            this->frames[i].retiredBuffers.push_back(previous);
+        }
+    }
+
+    // Every Frame Region Moved, So Every Sprite Must Be Rewritten
+    this->spriteStorage->markAllDirty();
     return Result<void>::createError(Error::None);
 }
 
+Result<void> Renderer::createVertexBuffer() {
+    Result<std::shared_ptr<Buffer>> result = Buffer::createBuffer(6 * sizeof(Vertex),
+                                                                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                                  MemoryUsage::GpuOnly);
+
+    if (!result.hasError()) {
+        this->vertexBuffer = static_cast<std::shared_ptr<Buffer>>(result);
+        std::vector<Vertex> vertexData = this->getVertexData();
+
+        return this->vertexBuffer->fillBuffer(static_cast<uint64>(vertexData.size()) * sizeof(Vertex),
+                                              vertexData.data());
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
 std::vector<VkAttachmentDescription> Renderer::getAttachmentDescription() const noexcept {
     std::vector<VkAttachmentDescription> attachments (1);
 
@@ -436,6 +676,43 @@ VkPipelineColorBlendStateCreateInfo Renderer::getColorBlendStateCreateInfo(
     return pipelineColorBlendStateCreateInfo;
 }
 
+VkCommandBufferBeginInfo Renderer::getCommandBufferBeginInfo() const noexcept {
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.pNext = nullptr;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    commandBufferBeginInfo.pInheritanceInfo = nullptr;
+
+    return commandBufferBeginInfo;
+}
+
+VkCommandBufferInheritanceInfo Renderer::getCommandBufferInheritanceInfo() const noexcept {
+    VkCommandBufferInheritanceInfo commandBufferInheritanceInfo = {};
+
+    commandBufferInheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    commandBufferInheritanceInfo.pNext = nullptr;
+    commandBufferInheritanceInfo.renderPass = this->renderPass;
+    commandBufferInheritanceInfo.subpass = 0;
+    commandBufferInheritanceInfo.framebuffer = this->framebuffers[this->imageIndex];
+    commandBufferInheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    commandBufferInheritanceInfo.queryFlags = 0;
+    commandBufferInheritanceInfo.pipelineStatistics = 0;
+
+    return commandBufferInheritanceInfo;
+}
+
+VkCommandPoolCreateInfo Renderer::getCommandPoolCreateInfo() const noexcept {
+    VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.pNext = nullptr;
+    commandPoolCreateInfo.queueFamilyIndex = this->deviceQueues[0]->getFamily();
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+    return commandPoolCreateInfo;
+}
+
 VkDescriptorSetAllocateInfo Renderer::getDescriptorSetAllocateInfo() const noexcept {
     VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {};
 
@@ -454,13 +731,13 @@ std::vector<VkDescriptorSetLayoutBinding> Renderer::getDescriptorSetLayoutBindin
     // Configure Transform Bindings
     descriptorSetLayoutBindings[0].binding = 0;
     descriptorSetLayoutBindings[0].descriptorCount = 1;
-    descriptorSetLayoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorSetLayoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorSetLayoutBindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
     descriptorSetLayoutBindings[0].pImmutableSamplers = nullptr;
 
     // Configure Texture Bindings
     descriptorSetLayoutBindings[1].binding = 1;
-    descriptorSetLayoutBindings[1].descriptorCount = 1;
+    descriptorSetLayoutBindings[1].descriptorCount = this->textureCapacity;
     descriptorSetLayoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     descriptorSetLayoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     descriptorSetLayoutBindings[1].pImmutableSamplers = nullptr;
@@ -475,7 +752,7 @@ VkDescriptorPoolCreateInfo Renderer::getDescriptorPoolCreateInfo(
     descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     descriptorPoolCreateInfo.pNext = nullptr;
     descriptorPoolCreateInfo.flags = 0;
-    descriptorPoolCreateInfo.maxSets = this->numOfObjectsToRender;
+    descriptorPoolCreateInfo.maxSets = static_cast<uint32>(this->frames.size());
     descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32>(poolSize->size());
     descriptorPoolCreateInfo.pPoolSizes = poolSize->data();
 
@@ -486,11 +763,11 @@ std::vector<VkDescriptorPoolSize> Renderer::getDescriptorPoolSize() const noexce
     std::vector<VkDescriptorPoolSize> descriptorPoolSize (2);
 
     // Configure Transform Size
-    descriptorPoolSize[0].descriptorCount = 1;
-    descriptorPoolSize[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorPoolSize[0].descriptorCount = static_cast<uint32>(this->frames.size());
+    descriptorPoolSize[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
     // Configure Texture Size
-    descriptorPoolSize[1].descriptorCount = 1;
+    descriptorPoolSize[1].descriptorCount = static_cast<uint32>(this->frames.size()) * this->textureCapacity;
     descriptorPoolSize[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
     return descriptorPoolSize;
@@ -514,7 +791,7 @@ VkFenceCreateInfo Renderer::getFenceCreateInfo() const noexcept {
 
     fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceCreateInfo.pNext = nullptr;
-    fenceCreateInfo.flags = 0;
+    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
     return fenceCreateInfo;
 }
@@ -617,7 +894,7 @@ VkPresentInfoKHR Renderer::getPresentInfoKHR() const noexcept {
     presentInfoKHR.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     presentInfoKHR.pNext = nullptr;
     presentInfoKHR.waitSemaphoreCount = 1;
-    presentInfoKHR.pWaitSemaphores = &this->queueSemaphores[0];
+    presentInfoKHR.pWaitSemaphores = &this->frames[this->frameIndex].renderSemaphore;
     presentInfoKHR.swapchainCount = 1;
     presentInfoKHR.pSwapchains = &this->swapchain;
     presentInfoKHR.pImageIndices = &this->imageIndex;
@@ -712,12 +989,25 @@ VkSamplerCreateInfo Renderer::getSamplerCreateInfo() const noexcept {
     samplerCreateInfo.compareEnable = VK_FALSE;
     samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
     samplerCreateInfo.minLod = 0.0f;
-    samplerCreateInfo.maxLod = 1.0f;
+    samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
     samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
 
     return samplerCreateInfo;
 }
 
+VkCommandBufferBeginInfo Renderer::getSecondaryBufferBeginInfo(
+        VkCommandBufferInheritanceInfo *inheritanceInfo) const noexcept {
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.pNext = nullptr;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                                   VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    commandBufferBeginInfo.pInheritanceInfo = inheritanceInfo;
+
+    return commandBufferBeginInfo;
+}
+
 VkSemaphoreCreateInfo Renderer::getSemaphoreCreateInfo() const noexcept {
     VkSemaphoreCreateInfo semaphoreCreateInfo = {};
 
@@ -728,7 +1018,8 @@ VkSemaphoreCreateInfo Renderer::getSemaphoreCreateInfo() const noexcept {
     return semaphoreCreateInfo;
 }
 
-std::vector<VkPipelineShaderStageCreateInfo> Renderer::getShaderStageCreateInfo() const noexcept {
+std::vector<VkPipelineShaderStageCreateInfo> Renderer::getShaderStageCreateInfo(
+        VkSpecializationInfo *specializationInfo) const noexcept {
     std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStageCreateInfo (2);
 
     // Configure Vertex Shader
@@ -747,7 +1038,7 @@ std::vector<VkPipelineShaderStageCreateInfo> Renderer::getShaderStageCreateInfo(
     pipelineShaderStageCreateInfo[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
     pipelineShaderStageCreateInfo[1].module = this->material->getFragmentModule();
     pipelineShaderStageCreateInfo[1].pName = "main";
-    pipelineShaderStageCreateInfo[1].pSpecializationInfo = nullptr;
+    pipelineShaderStageCreateInfo[1].pSpecializationInfo = specializationInfo;
 
     return pipelineShaderStageCreateInfo;
 }
@@ -803,16 +1094,52 @@ Result<VkDevice> Renderer::getGraphicsDevice() const noexcept {
     return Result<VkDevice>::createError(result.getError());
 }
 
+std::vector<Vertex> Renderer::getVertexData() const noexcept {
+    std::vector<Vertex> vertexData (6);
+
+    // Configure 1st Vertex
+    vertexData[0].position = glm::vec3(-16.0f, 16.0f, 0.0f);
+    vertexData[0].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[0].texCoords = glm::vec2(0.0f, 0.0f);
+
+    // Configure 2nd Vertex
+    vertexData[1].position = glm::vec3(16.0f, 16.0f, 0.0f);
+    vertexData[1].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[1].texCoords = glm::vec2(1.0f, 0.0f);
+
+    // Configure 3rd Vertex
+    vertexData[2].position = glm::vec3(16.0f, -16.0f, 0.0f);
+    vertexData[2].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[2].texCoords = glm::vec2(1.0f, 1.0f);
+
+    // Configure 4th Vertex
+    vertexData[3].position = glm::vec3(-16.0f, 16.0f, 0.0f);
+    vertexData[3].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[3].texCoords = glm::vec2(0.0f, 0.0f);
+
+    // Configure 5th Vertex
+    vertexData[4].position = glm::vec3(16.0f, -16.0f, 0.0f);
+    vertexData[4].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[4].texCoords = glm::vec2(1.0f, 1.0f);
+
+    // Configure 6th Vertex
+    vertexData[5].position = glm::vec3(-16.0f, -16.0f, 0.0f);
+    vertexData[5].color = glm::vec3(1.0f, 1.0f, 1.0f);
+    vertexData[5].texCoords = glm::vec2(0.0f, 1.0f);
+
+    return vertexData;
+}
+
 VkPipelineVertexInputStateCreateInfo Renderer::getVertexInputStateCreateInfo(
-        VkVertexInputBindingDescription *bindings,
+        std::vector<VkVertexInputBindingDescription> *bindings,
         std::vector<VkVertexInputAttributeDescription> *attributes) const noexcept {
     VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo = {};
 
     pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     pipelineVertexInputStateCreateInfo.pNext = nullptr;
     pipelineVertexInputStateCreateInfo.flags = 0;
-    pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
-    pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = bindings;
+    pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = static_cast<uint32>(bindings->size());
+    pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = bindings->data();
     pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32>(attributes->size());
     pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions = attributes->data();
 
@@ -865,83 +1192,237 @@ Result<void> Renderer::loadQueues() {
     return Result<void>::createError(result.getError());
 }
 
-VkCommandBuffer Renderer::selectCommandBuffer() const noexcept {
-    Result<VkCommandBuffer> cmdBuffer = this->deviceQueues[0]->getVulkanBuffer();
-    return static_cast<VkCommandBuffer>(cmdBuffer);
+Result<void> Renderer::loadTextureLimits() {
+    GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<std::weak_ptr<const Device>>(result);
+
+        if (std::shared_ptr<const Device> dev = device.lock()) {
+            Result<VkPhysicalDevice> rslt = dev->getVulkanPhysicalDevice();
+
+            if (!rslt.hasError()) {
+                auto physicalDevice = static_cast<VkPhysicalDevice>(rslt);
+                VkPhysicalDeviceProperties properties = {};
+
+                // Clamp Texture Array To Device Limits
+                vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+                this->textureCapacity = std::min({ MAX_BOUND_TEXTURES,
+                                                   properties.limits.maxPerStageDescriptorSamplers,
+                                                   properties.limits.maxPerStageDescriptorSampledImages,
+                                                   properties.limits.maxDescriptorSetSamplers });
+                this->bDescriptorIndexing = dev->supportsDescriptorIndexing();
+
+                return Result<void>::createError(Error::None);
+            }
+            else {
+                return Result<void>::createError(rslt.getError());
+            }
+        }
+    }
+
+    return Result<void>::createError(result.getError());
 }
 
-void Renderer::updateDescriptorSets() {
-    static glm::mat4 lookAtTransform = glm::lookAt(glm::vec3(0.0f, 0.0f, 2.0f),
-                                                   glm::vec3(0.0f, 0.0f, 0.0f),
-                                                   glm::vec3(0.0f, 1.0f, 0.0f));
-    static glm::mat4 orthoTransform = glm::ortho(-256.0f, 256.0f, -256.0f, 256.0f, -256.0f, 256.0f);
+VkCommandBuffer Renderer::selectCommandBuffer() const noexcept {
+    return this->frames[this->frameIndex].cmdBuffer;
+}
 
+void Renderer::updateDescriptorSets(FrameData &frame) {
     VkDevice device = static_cast<VkDevice>(this->getGraphicsDevice());
-    std::vector<VkDescriptorBufferInfo> descriptorBufferInfo(this->numOfObjectsToRender);
-    std::vector<VkDescriptorImageInfo> descriptorImageInfo(this->numOfObjectsToRender);
-    std::vector<VkWriteDescriptorSet> writeDescriptorSet(2 * this->numOfObjectsToRender);
-    uint32 index = 0;
-
-    for (auto &obj : this->objectsToRender) {
-        Transform matrixTransform = {};
-
-        // Configure Transform
-        matrixTransform.model = obj->getModelTransform();
-        matrixTransform.view = lookAtTransform;
-        matrixTransform.proj = orthoTransform;
-
-        // Fill Transform Buffer
-        this->transformBuffers[index]->fillBuffer(sizeof(matrixTransform), &matrixTransform);
-
-        // Configure Transform Data
-        descriptorBufferInfo[index].buffer =
-                static_cast<VkBuffer>(this->transformBuffers[index]->getVulkanBuffer());
-        descriptorBufferInfo[index].offset = 0;
-        descriptorBufferInfo[index].range = VK_WHOLE_SIZE;
-
-        // Confiogure Texture Data
-        descriptorImageInfo[index].sampler = this->textureSampler;
-        descriptorImageInfo[index].imageView = obj->getTexture()->getImageView();
-        descriptorImageInfo[index].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        // Write Data To Descriptor Sets
-        writeDescriptorSet[2 * index + 0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSet[2 * index + 0].pNext = nullptr;
-        writeDescriptorSet[2 * index + 0].dstSet = this->descriptorSets[index];
-        writeDescriptorSet[2 * index + 0].dstBinding = 0;
-        writeDescriptorSet[2 * index + 0].dstArrayElement = 0;
-        writeDescriptorSet[2 * index + 0].descriptorCount = 1;
-        writeDescriptorSet[2 * index + 0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        writeDescriptorSet[2 * index + 0].pImageInfo = nullptr;
-        writeDescriptorSet[2 * index + 0].pBufferInfo = &descriptorBufferInfo[index];
-        writeDescriptorSet[2 * index + 0].pTexelBufferView = nullptr;
-
-        writeDescriptorSet[2 * index + 1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeDescriptorSet[2 * index + 1].pNext = nullptr;
-        writeDescriptorSet[2 * index + 1].dstSet = this->descriptorSets[index];
-        writeDescriptorSet[2 * index + 1].dstBinding = 1;
-        writeDescriptorSet[2 * index + 1].dstArrayElement = 0;
-        writeDescriptorSet[2 * index + 1].descriptorCount = 1;
-        writeDescriptorSet[2 * index + 1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        writeDescriptorSet[2 * index + 1].pImageInfo = &descriptorImageInfo[index];
-        writeDescriptorSet[2 * index + 1].pBufferInfo = nullptr;
-        writeDescriptorSet[2 * index + 1].pTexelBufferView = nullptr;
-
-        index++;
-    }
-
-    vkUpdateDescriptorSets(device,
-                           static_cast<uint32>(writeDescriptorSet.size()),
-                           writeDescriptorSet.data(),
+    const std::vector<std::shared_ptr<Texture>> &textures = this->spriteStorage->getTextures();
+    auto textureCount = std::min(static_cast<uint32>(textures.size()), this->textureCapacity);
+    std::vector<VkDescriptorImageInfo> descriptorImageInfo;
+    std::vector<VkWriteDescriptorSet> writeDescriptorSet(2);
+    VkDescriptorBufferInfo descriptorBufferInfo = {};
+
+    if (textureCount == 0) {
+        return;
+    }
+
+    // First Write Fills Every Slot, Later Writes Only Bind Newly Registered Textures
+    uint32 firstSlot = frame.boundTextures;
+    uint32 lastSlot = firstSlot == 0 ? this->textureCapacity : textureCount;
+
+    // Configure Transform Data, Each Frame Selects Its Camera Through A Dynamic Offset
+    descriptorBufferInfo.buffer = this->frameAllocator->getVulkanBuffer();
+    descriptorBufferInfo.offset = 0;
+    descriptorBufferInfo.range = sizeof(Transform);
+
+    // Configure Texture Data, Unused Slots Repeat The First Texture And Pending Ones Show Placeholder
+    for (uint32 index = firstSlot; index < lastSlot; index++) {
+        const std::shared_ptr<Texture> &slot = index < textureCount ? textures[index] : textures[0];
+        const std::shared_ptr<Texture> &texture = slot->isResident() ? slot : this->placeholderTexture;
+        VkDescriptorImageInfo imageInfo = {};
+
+        imageInfo.sampler = this->textureSampler;
+        imageInfo.imageView = texture->getImageView();
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        descriptorImageInfo.push_back(imageInfo);
+    }
+
+    // Write Data To Descriptor Set
+    writeDescriptorSet[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet[0].pNext = nullptr;
+    writeDescriptorSet[0].dstSet = frame.descriptorSet;
+    writeDescriptorSet[0].dstBinding = 0;
+    writeDescriptorSet[0].dstArrayElement = 0;
+    writeDescriptorSet[0].descriptorCount = 1;
+    writeDescriptorSet[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writeDescriptorSet[0].pImageInfo = nullptr;
+    writeDescriptorSet[0].pBufferInfo = &descriptorBufferInfo;
+    writeDescriptorSet[0].pTexelBufferView = nullptr;
+
+    writeDescriptorSet[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet[1].pNext = nullptr;
+    writeDescriptorSet[1].dstSet = frame.descriptorSet;
+    writeDescriptorSet[1].dstBinding = 1;
+    writeDescriptorSet[1].dstArrayElement = firstSlot;
+    writeDescriptorSet[1].descriptorCount = static_cast<uint32>(descriptorImageInfo.size());
+    writeDescriptorSet[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeDescriptorSet[1].pImageInfo = descriptorImageInfo.data();
+    writeDescriptorSet[1].pBufferInfo = nullptr;
+    writeDescriptorSet[1].pTexelBufferView = nullptr;
+
+    // Frame Allocator Buffer Never Changes, So It Is Written Only Once
+    if (firstSlot > 0) {
+        writeDescriptorSet.erase(writeDescriptorSet.begin());
+    }
+
+    if (!descriptorImageInfo.empty()) {
+        vkUpdateDescriptorSets(device,
+                               static_cast<uint32>(writeDescriptorSet.size()),
+                               writeDescriptorSet.data(),
+                               0,
+                               nullptr);
+    }
+
+    frame.boundTextures = textureCount;
+}
+
+Result<void> Renderer::writeTransform(FrameData &frame) {
+    Result<Memory> result = this->frameAllocator->allocate(sizeof(Transform));
+
+    if (!result.hasError()) {
+        auto memory = static_cast<Memory>(result);
+        Result<void *> mapping = this->frameAllocator->map(memory);
+
+        if (mapping.hasError()) {
+            return Result<void>::createError(mapping.getError());
+        }
+
+        // Configure Camera Transform
+        auto *cameraTransform = reinterpret_cast<Transform *>(static_cast<uint8 *>(static_cast<void *>(mapping)) +
+                                                              memory.getMemoryOffset());
+        cameraTransform->view = glm::lookAt(glm::vec3(0.0f, 0.0f, 2.0f),
+                                            glm::vec3(0.0f, 0.0f, 0.0f),
+                                            glm::vec3(0.0f, 1.0f, 0.0f));
+        cameraTransform->proj = glm::ortho(-256.0f, 256.0f, -256.0f, 256.0f, -256.0f, 256.0f);
+
+        // Memory Offsets Are Relative To Whole Buffer, So They Already Select The Current Frame Region
+        frame.transformOffset = static_cast<uint32>(memory.getMemoryOffset());
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+void Renderer::recordInstances(RecordSlot &slot) {
+    VkCommandBuffer cmdBuffer = slot.cmdBuffers[this->frameIndex];
+    VkCommandBufferInheritanceInfo inheritanceInfo = this->getCommandBufferInheritanceInfo();
+    VkCommandBufferBeginInfo commandBufferBeginInfo = this->getSecondaryBufferBeginInfo(&inheritanceInfo);
+    VkBuffer buffers[] = {
+            static_cast<VkBuffer>(this->vertexBuffer->getVulkanBuffer()),
+            static_cast<VkBuffer>(this->instanceBuffer->getVulkanBuffer())
+    };
+    VkDeviceSize offsets[] = { 0, 0 };
+    uint32 regionOffset = this->frameIndex * this->instanceCapacity;
+    uint32 first = slot.firstInstance;
+    uint32 last = slot.firstInstance + slot.instanceCount;
+
+    // Select Current Frame Region
+    auto *instances = reinterpret_cast<InstanceData *>(this->instanceMapping) + regionOffset;
+
+    // Recycle Slot Pool, Frame Fence Has Already Been Waited
+    vkResetCommandPool(this->device, slot.pools[this->frameIndex], 0);
+    vkBeginCommandBuffer(cmdBuffer, &commandBufferBeginInfo);
+
+    // Bind Pipeline State
+    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->pipeline);
+    vkCmdBindDescriptorSets(cmdBuffer,
+                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->pipelineLayout,
+                            0,
+                            1,
+                            &this->frames[this->frameIndex].descriptorSet,
+                            1,
+                            &this->frames[this->frameIndex].transformOffset);
+    vkCmdBindVertexBuffers(cmdBuffer,
                            0,
-                           nullptr);
+                           2,
+                           buffers,
+                           offsets);
+
+    // Rewrite Only Runs Of Sprites Changed Since This Frame Region Was Last Written
+    const uint32 *textureIds = this->spriteStorage->getTextureIds();
+    const glm::vec4 *uvRects = this->spriteStorage->getUvRects();
+    uint8 *dirtyMasks = this->spriteStorage->getDirtyMasks();
+    auto frameBit = static_cast<uint8>(1u << this->frameIndex);
+
+    slot.dirtyFirst = last;
+    slot.dirtyLast = first;
+    for (uint32 i = first; i < last; i++) {
+        if ((dirtyMasks[i] & frameBit) == 0) {
+            continue;
+        }
+
+        uint32 runFirst = i;
+        for (; i < last && (dirtyMasks[i] & frameBit) != 0; i++) {
+            dirtyMasks[i] &= static_cast<uint8>(~frameBit);
+            instances[i].textureIndex = textureIds[i];
+            instances[i].uvRect = uvRects[i];
+        }
+
+        buildSpriteTransforms(this->spriteStorage->getPositions() + runFirst,
+                              this->spriteStorage->getRotations() + runFirst,
+                              this->spriteStorage->getScales() + runFirst,
+                              i - runFirst,
+                              instances + runFirst);
+
+        slot.dirtyFirst = std::min(slot.dirtyFirst, runFirst);
+        slot.dirtyLast = i;
+    }
+
+    if (this->bDescriptorIndexing) {
+        // Draw Whole Range, Texture Selected Per Instance
+        if (slot.instanceCount > 0) {
+            vkCmdDraw(cmdBuffer, 6, slot.instanceCount, 0, regionOffset + first);
+        }
+    }
+    else {
+        // Keep Texture Index Uniform Within Each Draw
+        for (auto &batch : this->batches) {
+            uint32 batchFirst = std::max(first, batch.firstInstance);
+            uint32 batchLast = std::min(last, batch.firstInstance + batch.instanceCount);
+
+            if (batchFirst < batchLast) {
+                vkCmdDraw(cmdBuffer, 6, batchLast - batchFirst, 0, regionOffset + batchFirst);
+            }
+        }
+    }
+
+    vkEndCommandBuffer(cmdBuffer);
 }
 
-Renderer::Renderer() {
+Renderer::Renderer(std::shared_ptr<SpriteStorage> storage, uint32 framesInFlight) {
+    this->spriteStorage = std::move(storage);
+    this->batchVersion = 0;
     this->descriptorLayout = VK_NULL_HANDLE;
     this->descriptorPool = VK_NULL_HANDLE;
+    this->textureCapacity = 0;
+    this->bDescriptorIndexing = false;
     this->device = VK_NULL_HANDLE;
-    this->imageSemaphore = VK_NULL_HANDLE;
     this->pipelineLayout = VK_NULL_HANDLE;
     this->pipeline = VK_NULL_HANDLE;
     this->renderPass = VK_NULL_HANDLE;
@@ -949,50 +1430,112 @@ Renderer::Renderer() {
     this->framebuffers = std::vector<VkFramebuffer>();
     this->deviceQueues = std::vector<std::shared_ptr<Queue>>();
     this->transferQueue = nullptr;
+    this->transferScheduler = nullptr;
+    this->defragmenter = nullptr;
+    this->frameAllocator = nullptr;
+    this->textureLoader = nullptr;
+    this->textureCache = nullptr;
+    this->placeholderTexture = nullptr;
     this->imageIndex = 0;
+    this->instanceCapacity = 0;
+    this->instanceMapping = nullptr;
+    this->recordSlots = std::vector<RecordSlot>();
+    this->activeRecordJobs = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_RECORD_JOBS));
+    this->frames = std::vector<FrameData>(std::max(1u, std::min(framesInFlight, MAX_FRAMES_IN_FLIGHT)), FrameData {});
+    this->frameIndex = 0;
     this->width = 0;
     this->height = 0;
-    this->objectsToRender = {};
-    this->numOfObjectsToRender = 0;
 }
 
 Renderer::~Renderer() {
-    if (!this->deviceQueues.empty() || this->transferQueue != nullptr || this->pipeline != VK_NULL_HANDLE ||
-        this->pipelineLayout != VK_NULL_HANDLE || this->descriptorLayout != VK_NULL_HANDLE) {
+    if (!this->deviceQueues.empty() || this->transferQueue != nullptr || this->transferScheduler != nullptr ||
+        this->defragmenter != nullptr || this->frameAllocator != nullptr || this->textureLoader != nullptr ||
+        this->textureCache != nullptr || this->pipeline != VK_NULL_HANDLE || this->pipelineLayout != VK_NULL_HANDLE ||
+        this->descriptorLayout != VK_NULL_HANDLE || !this->recordSlots.empty()) {
         std::cout << "WARNING: Renderer deleted without being shutdown..." << std::endl;
         this->shutdown();
     }
 }
 
-void Renderer::addObject(std::shared_ptr<SpriteComponent> &object) {
-    this->objectsToRender.push_front(object);
-    this->numOfObjectsToRender++;
-}
-
 Result<void> Renderer::begin() {
     Result<VkDevice> result = this->getGraphicsDevice();
-    VkCommandBuffer cmdBuffer = this->selectCommandBuffer();
+    FrameData &frame = this->frames[this->frameIndex];
 
     if (!result.hasError()) {
         this->device = static_cast<VkDevice>(result);
 
+        // Wait For Frame Resources
+        vkWaitForFences(this->device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+        frame.retiredBuffers.clear();
+        frame.retiredTextures.clear();
+
+        // Transient Data Of This Frame Is No Longer Read
+        this->frameAllocator->beginFrame(this->frameIndex);
+
+        Result<void> transform = this->writeTransform(frame);
+        if (transform.hasError()) {
+            return transform;
+        }
+
+        // Destroy Unused Textures Over Budget Once No Frame Samples Them
+        this->textureCache->update();
+
         // Acquire Next Image
         if (vkAcquireNextImageKHR(this->device,
                                   this->swapchain,
-                                  0,
-                                  this->imageSemaphore,
+                                  UINT64_MAX,
+                                  frame.imageSemaphore,
                                   VK_NULL_HANDLE,
                                   &this->imageIndex) != VK_SUCCESS) {
             return Result<void>::createError(Error::FailedToAcquireNextImage);
         }
 
+        vkResetFences(this->device, 1, &frame.fence);
+
+        // Begin Command Buffer
+        VkCommandBufferBeginInfo commandBufferBeginInfo = this->getCommandBufferBeginInfo();
+        vkResetCommandBuffer(frame.cmdBuffer, 0);
+        vkBeginCommandBuffer(frame.cmdBuffer, &commandBufferBeginInfo);
+
+        // Await Only Uploads Of Textures About To Be Bound
+        const std::vector<std::shared_ptr<Texture>> &textures = this->spriteStorage->getTextures();
+        for (uint32 i = frame.boundTextures; i < static_cast<uint32>(textures.size()); i++) {
+            if (textures[i]->isResident()) {
+                this->transferScheduler->wait(textures[i]->getTransferTicket());
+            }
+        }
+
+        // Queue Decoded Textures And Flip Finished Ones Before Acquires Are Recorded
+        this->textureLoader->update();
+
+        // Submit Pending Uploads And Acquire Finished Ones On Graphics Queue
+        this->transferScheduler->flush();
+        bool bIdle = this->transferScheduler->getStagingSize() == 0;
+        this->transferScheduler->recordAcquires(frame.cmdBuffer);
+
+        // Compact Video Memory Only While No Upload Writes To Resources
+        this->defragmenter->step(frame.cmdBuffer, bIdle);
+        if (frame.relocationVersion != this->defragmenter->getVersion()) {
+            for (auto &texture : textures) {
+                texture->refreshImageView();
+            }
+
+            this->placeholderTexture->refreshImageView();
+
+            frame.boundTextures = 0;
+            frame.relocationVersion = this->defragmenter->getVersion();
+        }
+
+        // Replace Placeholders Of Textures That Became Resident
+        if (frame.residencyVersion != this->textureLoader->getVersion()) {
+            frame.boundTextures = 0;
+            frame.residencyVersion = this->textureLoader->getVersion();
+        }
+
         // Begin Render Pass
         VkClearValue clearColor = { 0.922f, 0.808f, 0.529f, 1.0f };
         VkRenderPassBeginInfo renderPassBeginInfo = this->getRenderPassBeginInfo(&clearColor);
-        vkCmdBeginRenderPass(cmdBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        // Bind Pipelines
-        this->deviceQueues[0]->bindPipeline(this->pipeline);
+        vkCmdBeginRenderPass(frame.cmdBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
         return Result<void>::createError(Error::None);
     }
@@ -1001,17 +1544,25 @@ Result<void> Renderer::begin() {
 }
 
 Result<void> Renderer::load() {
-    Result<void> result = this->createDescriptorPool();
+    this->instanceCapacity = std::max(this->spriteStorage->getSize(), MIN_INSTANCE_CAPACITY);
+
+    Result<void> result = this->createBatches();
+
+    if (!result.hasError()) {
+        result = this->createDescriptorPool();
+    }
 
     if (!result.hasError()) {
         Result<void> rslt = this->allocateDescriptorSets();
 
         if (!rslt.hasError()) {
-            Result<void> res = this->createTransformBuffers();
+            Result<void> res = this->createInstanceBuffer();
+
+            if (!res.hasError()) {
+                res = this->createVertexBuffer();
+            }
 
             if (!res.hasError()) {
-                this->updateDescriptorSets();
-                this->objectsToRender.front()->load();
                 return Result<void>::createError(Error::None);
             }
             else {
@@ -1026,44 +1577,107 @@ Result<void> Renderer::load() {
     return Result<void>::createError(result.getError());
 }
 
-void Renderer::draw() {
-    VkBuffer buffer = static_cast<VkBuffer>(this->objectsToRender.front()->getVertexBuffer()->getVulkanBuffer());
+Result<void> Renderer::draw() {
+    JobManager &jobManager = JobManager::getManager();
+    VkCommandBuffer secondaryBuffers[MAX_RECORD_JOBS];
     VkCommandBuffer cmdBuffer = this->selectCommandBuffer();
-    VkDeviceSize offsets[] = { 0 };
+    FrameData &frame = this->frames[this->frameIndex];
+    uint32 numInstances = this->spriteStorage->getSize();
+    uint32 chunkSize = (numInstances + this->activeRecordJobs - 1) / this->activeRecordJobs;
 
-    vkCmdBindVertexBuffers(cmdBuffer,
-                           0,
-                           1,
-                           &buffer,
-                           offsets);
+    // Make Room For Sprites Created After Load
+    if (numInstances > this->instanceCapacity) {
+        Result<void> result = this->growInstanceBuffer(numInstances);
 
-    this->updateDescriptorSets();
-    for (uint32 i = 0; i < this->numOfObjectsToRender; i++) {
-        vkCmdBindDescriptorSets(cmdBuffer,
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                this->pipelineLayout,
-                                0,
-                                1,
-                                &this->descriptorSets[i],
-                                0,
-                                nullptr);
-        vkCmdDraw(cmdBuffer, 6, 1, 0, 0);
+        if (result.hasError()) {
+            return result;
+        }
     }
+
+    // Regroup Batches After Sprites Were Created Or Destroyed
+    if (this->batchVersion != this->spriteStorage->getLayoutVersion()) {
+        Result<void> result = this->createBatches();
+
+        if (result.hasError()) {
+            return result;
+        }
+    }
+
+    // Dropped Textures Stay Alive Until Every Frame That May Sample Them Has Finished
+    std::vector<std::shared_ptr<Texture>> retired = this->spriteStorage->takeRetiredTextures();
+    if (!retired.empty()) {
+        for (auto &data : this->frames) {
+            data.retiredTextures.insert(data.retiredTextures.end(), retired.begin(), retired.end());
+        }
+    }
+
+    // Rebind Every Slot Once Textures Were Dropped And Others Took Their Ids
+    if (frame.textureVersion != this->spriteStorage->getTextureVersion()) {
+        frame.boundTextures = 0;
+        frame.textureVersion = this->spriteStorage->getTextureVersion();
+    }
+
+    // Bind Textures Registered Since This Frame Set Was Last Written
+    if (frame.boundTextures < this->spriteStorage->getTextures().size()) {
+        this->updateDescriptorSets(frame);
+    }
+
+    // Partition Instances Across Slots
+    for (uint32 i = 0; i < this->activeRecordJobs; i++) {
+        RecordSlot &slot = this->recordSlots[i];
+
+        slot.firstInstance = std::min(i * chunkSize, numInstances);
+        slot.instanceCount = std::min(chunkSize, numInstances - slot.firstInstance);
+        secondaryBuffers[i] = slot.cmdBuffers[this->frameIndex];
+    }
+
+    // Record Secondary Buffers In Parallel
+    JobHandle record = jobManager.parallelFor(this->activeRecordJobs, 1, [this](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++) {
+            this->recordInstances(this->recordSlots[i]);
+        }
+    });
+    jobManager.wait(record);
+
+    // Publish Rewritten Ranges To Device
+    for (uint32 i = 0; i < this->activeRecordJobs; i++) {
+        RecordSlot &slot = this->recordSlots[i];
+
+        if (slot.dirtyFirst < slot.dirtyLast) {
+            this->instanceBuffer->flushRange(
+                    (this->frameIndex * this->instanceCapacity + slot.dirtyFirst) * sizeof(InstanceData),
+                    (slot.dirtyLast - slot.dirtyFirst) * sizeof(InstanceData));
+        }
+    }
+
+    vkCmdExecuteCommands(cmdBuffer, this->activeRecordJobs, secondaryBuffers);
+    return Result<void>::createError(Error::None);
 }
 
 Result<void> Renderer::end() {
     auto queue = static_cast<VkQueue>(this->deviceQueues[0]->getVulkanQueue());
     VkPipelineStageFlags stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     VkPresentInfoKHR presentInfoKHR = this->getPresentInfoKHR();
-    VkCommandBuffer cmdBuffer = this->selectCommandBuffer();
+    FrameData &frame = this->frames[this->frameIndex];
 
     // Submit Buffers
-    vkCmdEndRenderPass(cmdBuffer);
-    this->deviceQueues[0]->submit(&this->queueSemaphores[0], 1, &this->imageSemaphore, 1, &stage, VK_NULL_HANDLE);
+    vkCmdEndRenderPass(frame.cmdBuffer);
+    vkEndCommandBuffer(frame.cmdBuffer);
+    this->frameAllocator->flush();
+
+    Result<void> result = this->deviceQueues[0]->submit(frame.cmdBuffer,
+                                                        &frame.renderSemaphore,
+                                                        1,
+                                                        &frame.imageSemaphore,
+                                                        1,
+                                                        &stage,
+                                                        frame.fence);
+    if (result.hasError()) {
+        return Result<void>::createError(result.getError());
+    }
 
-    // Reset Buffers
-    // vkQueueWaitIdle(queue);
-    this->deviceQueues[0]->resetBuffers();
+    // Advance To Next Frame
+    this->frameIndex = (this->frameIndex + 1) % static_cast<uint32>(this->frames.size());
 
     if (vkQueuePresentKHR(queue, &presentInfoKHR) != VK_SUCCESS) {
         return Result<void>::createError(Error::FailedToPresentImage);
@@ -1072,102 +1686,59 @@ Result<void> Renderer::end() {
     return Result<void>::createError(Error::None);
 }
 
-Result<void> Renderer::executeTransferBuffer(VkCommandBuffer cmdBuffer) const noexcept {
-    Result<VkDevice> result = this->getGraphicsDevice();
-
-    if (!result.hasError()) {
-        auto device = static_cast<VkDevice>(result);
-        Result<VkCommandPool> rslt = this->transferQueue->getVulkanPool();
+uint32 Renderer::getRecordedInstanceCount() const noexcept {
+    uint32 count = 0;
 
-        if (!rslt.hasError()) {
-            auto cmdPool = static_cast<VkCommandPool>(rslt);
-            Result<VkQueue> res = this->transferQueue->getVulkanQueue();
-
-            if (!res.hasError()) {
-                auto queue = static_cast<VkQueue>(res);
-                vkEndCommandBuffer(cmdBuffer);
-
-                VkSubmitInfo submitInfo = {};
-                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submitInfo.pNext = nullptr;
-                submitInfo.commandBufferCount = 1;
-                submitInfo.pCommandBuffers = &cmdBuffer;
-                submitInfo.signalSemaphoreCount = 0;
-                submitInfo.pSignalSemaphores = nullptr;
-                submitInfo.waitSemaphoreCount = 0;
-                submitInfo.pWaitSemaphores = nullptr;
-                submitInfo.pWaitDstStageMask = nullptr;
-
-                VkResult submitResult = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-                VkResult waitResult = vkQueueWaitIdle(queue);
-
-                if (submitResult == VK_SUCCESS && waitResult == VK_SUCCESS) {
-                    vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
-                    return Result<void>::createError(Error::None);
-                }
-                else {
-                    return Result<void>::createError(Error::FailedToSubmitQueue);
-                }
-            }
-            else {
-                return Result<void>::createError(res.getError());
-            }
-        }
-        else {
-            return Result<void>::createError(rslt.getError());
-        }
+    for (uint32 i = 0; i < this->activeRecordJobs && i < static_cast<uint32>(this->recordSlots.size()); i++) {
+        count += this->recordSlots[i].instanceCount;
     }
 
-    return Result<void>::createError(result.getError());
+    return count;
 }
 
-Result<VkCommandBuffer> Renderer::requestTransferBuffer() const noexcept {
-    Result<VkCommandPool> result = this->transferQueue->getVulkanPool();
-    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+void Renderer::setRecordJobs(uint32 count) noexcept {
+    this->activeRecordJobs = std::max(1u, std::min(count, MAX_RECORD_JOBS));
+}
 
-    if (!result.hasError()) {
-        auto commandPool = static_cast<VkCommandPool>(result);
-        Result<VkDevice> rslt = this->getGraphicsDevice();
+Result<void> Renderer::startup() {
+    Result<void> loadResult = this->loadQueues();
+    if (loadResult.hasError()) {
+        return Result<void>::createError(loadResult.getError());
+    }
 
-        if (!rslt.hasError()) {
-            auto device = static_cast<VkDevice>(rslt);
-            VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+    Result<void> transferSchedulerResult = this->createTransferScheduler();
+    if (transferSchedulerResult.hasError()) {
+        return Result<void>::createError(transferSchedulerResult.getError());
+    }
 
-            commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            commandBufferAllocateInfo.pNext = nullptr;
-            commandBufferAllocateInfo.commandBufferCount = 1;
-            commandBufferAllocateInfo.commandPool = commandPool;
-            commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    Result<void> defragmenterResult = this->createDefragmenter();
+    if (defragmenterResult.hasError()) {
+        return Result<void>::createError(defragmenterResult.getError());
+    }
 
-            VkResult res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
-            if (res == VK_SUCCESS) {
-                VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+    Result<void> frameAllocatorResult = this->createFrameAllocator();
+    if (frameAllocatorResult.hasError()) {
+        return Result<void>::createError(frameAllocatorResult.getError());
+    }
 
-                commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-                commandBufferAllocateInfo.pNext = nullptr;
-                commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    Result<void> textureLoaderResult = this->createTextureLoader();
+    if (textureLoaderResult.hasError()) {
+        return Result<void>::createError(textureLoaderResult.getError());
+    }
 
-                VkResult rst = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-                if (rst == VK_SUCCESS) {
-                    return Result<VkCommandBuffer>(commandBuffer);
-                }
-                else {
-                    return Result<VkCommandBuffer>::createError(Error::FailedToAllocateCommandBuffer);
-                }
-            }
-            else {
-                return Result<VkCommandBuffer>::createError(Error::FailedToAllocateCommandBuffer);
-            }
-        }
+    Result<void> textureCacheResult = this->createTextureCache();
+    if (textureCacheResult.hasError()) {
+        return Result<void>::createError(textureCacheResult.getError());
     }
 
-    return Result<VkCommandBuffer>::createError(result.getError());
-}
+    Result<void> placeholderResult = this->createPlaceholderTexture();
+    if (placeholderResult.hasError()) {
+        return Result<void>::createError(placeholderResult.getError());
+    }
 
-Result<void> Renderer::startup() {
-    Result<void> loadResult = this->loadQueues();
-    if (loadResult.hasError()) {
-        return Result<void>::createError(loadResult.getError());
+    Result<void> textureLimitsResult = this->loadTextureLimits();
+    if (textureLimitsResult.hasError()) {
+        return Result<void>::createError(textureLimitsResult.getError());
     }
 
     Result<void> materialResult = this->createMaterial();
@@ -1220,6 +1791,16 @@ Result<void> Renderer::startup() {
         return Result<void>::createError(fenceResult.getError());
     }
 
+    Result<void> commandBufferResult = this->createCommandBuffers();
+    if (commandBufferResult.hasError()) {
+        return Result<void>::createError(commandBufferResult.getError());
+    }
+
+    Result<void> recordSlotResult = this->createRecordSlots();
+    if (recordSlotResult.hasError()) {
+        return Result<void>::createError(recordSlotResult.getError());
+    }
+
     return Result<void>::createError(Error::None);
 }
 
@@ -1232,21 +1813,39 @@ void Renderer::shutdown() {
         // Finish Work
         vkDeviceWaitIdle(device);
 
-        if (this->imageFence != VK_NULL_HANDLE) {
-            vkDestroyFence(device, this->imageFence, nullptr);
-            this->imageFence = VK_NULL_HANDLE;
+        for (auto &slot : this->recordSlots) {
+            for (auto &pool : slot.pools) {
+                if (pool != VK_NULL_HANDLE) {
+                    vkDestroyCommandPool(device, pool, nullptr);
+                    pool = VK_NULL_HANDLE;
+                }
+            }
         }
+        this->recordSlots.clear();
 
-        for (auto &semaphore : this->queueSemaphores) {
-            if (semaphore != VK_NULL_HANDLE) {
-                vkDestroySemaphore(device, semaphore, nullptr);
-                semaphore = VK_NULL_HANDLE;
+        for (auto &frame : this->frames) {
+            if (frame.fence != VK_NULL_HANDLE) {
+                vkDestroyFence(device, frame.fence, nullptr);
+                frame.fence = VK_NULL_HANDLE;
             }
-        }
 
-        if (this->imageSemaphore != VK_NULL_HANDLE) {
-            vkDestroySemaphore(device, this->imageSemaphore, nullptr);
-            this->imageSemaphore = VK_NULL_HANDLE;
+            if (frame.imageSemaphore != VK_NULL_HANDLE) {
+                vkDestroySemaphore(device, frame.imageSemaphore, nullptr);
+                frame.imageSemaphore = VK_NULL_HANDLE;
+            }
+
+            if (frame.renderSemaphore != VK_NULL_HANDLE) {
+                vkDestroySemaphore(device, frame.renderSemaphore, nullptr);
+                frame.renderSemaphore = VK_NULL_HANDLE;
+            }
+
+            frame.retiredBuffers.clear();
+            frame.retiredTextures.clear();
+
+            if (frame.cmdBuffer != VK_NULL_HANDLE) {
+                this->deviceQueues[0]->freeBuffer(frame.cmdBuffer);
+                frame.cmdBuffer = VK_NULL_HANDLE;
+            }
         }
 
         if (this->textureSampler != VK_NULL_HANDLE) {
@@ -1283,14 +1882,19 @@ void Renderer::shutdown() {
             this->pipelineLayout = VK_NULL_HANDLE;
         }
 
-        if (!this->descriptorSets.empty()) {
-            this->descriptorSets.clear();
+        if (!this->batches.empty()) {
+            this->batches.clear();
         }
 
         if (this->descriptorPool != VK_NULL_HANDLE) {
             vkResetDescriptorPool(device, this->descriptorPool, 0);
             vkDestroyDescriptorPool(device, this->descriptorPool, nullptr);
             this->descriptorPool = VK_NULL_HANDLE;
+
+            for (auto &frame : this->frames) {
+                frame.descriptorSet = VK_NULL_HANDLE;
+                frame.boundTextures = 0;
+            }
         }
 
         if (this->descriptorLayout != VK_NULL_HANDLE) {
@@ -1303,7 +1907,16 @@ void Renderer::shutdown() {
 
     this->deviceQueues.clear();
     this->imageBuffers.clear();
-    this->transformBuffers.clear();
+    this->instanceMapping = nullptr;
+    this->instanceBuffer.reset();
+    this->instanceCapacity = 0;
+    this->vertexBuffer.reset();
+    this->textureCache.reset();
+    this->textureLoader.reset();
+    this->placeholderTexture.reset();
+    this->defragmenter.reset();
+    this->frameAllocator.reset();
+    this->transferScheduler.reset();
 
     this->device = VK_NULL_HANDLE;
     this->swapchain = VK_NULL_HANDLE;
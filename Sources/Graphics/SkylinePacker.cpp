@@ -0,0 +1,110 @@
+/**
+ * SkylinePacker.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+SkylinePacker::SkylinePacker(uint32 width, uint32 height) {
+    this->width = width;
+    this->height = height;
+    this->usedArea = 0;
+    this->nodes = std::vector<SkylineNode>(1, SkylineNode { 0, 0, width });
+}
+
+Result<uint32> SkylinePacker::fit(uint32 index, uint32 width, uint32 height) const noexcept {
+    if (this->nodes[index].x + width > this->width) {
+        return Result<uint32>::createError(Error::AtlasPageFull);
+    }
+
+    // Rectangle Rests On Highest Segment It Spans
+    uint32 y = this->nodes[index].y;
+    uint32 covered = 0;
+    for (uint32 i = index; covered < width; i++) {
+        y = std::max(y, this->nodes[i].y);
+
+        if (y + height > this->height) {
+            return Result<uint32>::createError(Error::AtlasPageFull);
+        }
+
+        covered += this->nodes[i].width;
+    }
+
+    return Result<uint32>(y);
+}
+
+void SkylinePacker::merge() noexcept {
+    for (uint32 i = 0; i + 1 < this->nodes.size();) {
+        if (this->nodes[i].y == this->nodes[i + 1].y) {
+            this->nodes[i].width += this->nodes[i + 1].width;
+            this->nodes.erase(this->nodes.begin() + i + 1);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+Result<PackedRect> SkylinePacker::insert(uint32 width, uint32 height) {
+    uint32 bestIndex = std::numeric_limits<uint32>::max();
+    uint32 bestTop = std::numeric_limits<uint32>::max();
+    uint32 bestWidth = std::numeric_limits<uint32>::max();
+    PackedRect rect = {};
+
+    if (width == 0 || height == 0) {
+        return Result<PackedRect>::createError(Error::IndexOutOfRange);
+    }
+
+    // Choose Lowest Top, Then Narrowest Segment
+    for (uint32 i = 0; i < this->nodes.size(); i++) {
+        Result<uint32> result = this->fit(i, width, height);
+
+        if (!result.hasError()) {
+            auto y = static_cast<uint32>(result);
+
+            if (y + height < bestTop || (y + height == bestTop && this->nodes[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = y + height;
+                bestWidth = this->nodes[i].width;
+                rect = PackedRect { this->nodes[i].x, y, width, height };
+            }
+        }
+    }
+
+    if (bestIndex == std::numeric_limits<uint32>::max()) {
+        return Result<PackedRect>::createError(Error::AtlasPageFull);
+    }
+
+    // Raise Skyline Over Placed Rectangle
+    this->nodes.insert(this->nodes.begin() + bestIndex, SkylineNode { rect.x, bestTop, width });
+
+    // Trim Segments Now Covered By New One
+    uint32 right = rect.x + width;
+    for (uint32 i = bestIndex + 1; i < this->nodes.size();) {
+        SkylineNode &node = this->nodes[i];
+
+        if (node.x >= right) {
+            break;
+        }
+
+        uint32 overlap = right - node.x;
+        if (overlap >= node.width) {
+            this->nodes.erase(this->nodes.begin() + i);
+        }
+        else {
+            node.x += overlap;
+            node.width -= overlap;
+            break;
+        }
+    }
+
+    this->merge();
+    this->usedArea += static_cast<uint64>(width) * height;
+
+    return Result<PackedRect>(rect);
+}
@@ -5,23 +5,61 @@
  *
  */
 
-#include "Buffer.h"
+#include "Defragmenter.h"
 #include "Device.h"
 #include "GraphicsManager.h"
 #include "Image.h"
+#include "MappedFile.h"
 #include "Renderer.h"
 #include "Texture.h"
+#include "TextureLoader.h"
+#include "TransferScheduler.h"
 #include "WorldManager.h"
 
+#include <algorithm>
 #include <FreeImage.h>
 #include <vulkan/vulkan.h>
 
 Texture::Texture() {
     this->width = 0;
     this->height = 0;
-    this->buffer = nullptr;
     this->image = nullptr;
+    this->pixels = std::vector<uint8>();
+    this->file = nullptr;
+    this->fileInfo = TextureFileInfo {};
+    this->format = VK_FORMAT_R8G8B8A8_UNORM;
+    this->mipLevels = 1;
+    this->memorySize = 0;
+    this->ticket = NULL_TRANSFER_TICKET;
     this->view = VK_NULL_HANDLE;
+    this->viewRelocations = 0;
+    this->state = TextureState::Decoded;
+    this->bStreamed = false;
+}
+
+Result<void> Texture::createImage() {
+    VkExtent3D extent = {};
+
+    extent.width = this->width;
+    extent.height = this->height;
+    extent.depth = 1;
+
+    Result<std::shared_ptr<Image>> result = Image::createImage(extent,
+                                                               VK_IMAGE_TYPE_2D,
+                                                               1,
+                                                               this->mipLevels,
+                                                               VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                                                               VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                                               VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                               this->format,
+                                                               VK_IMAGE_TILING_OPTIMAL);
+
+    if (!result.hasError()) {
+        this->image = static_cast<std::shared_ptr<Image>>(result);
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
 }
 
 Result<void> Texture::createImageView() {
@@ -40,13 +78,14 @@ Result<void> Texture::createImageView() {
     subresources.baseArrayLayer = 0;
     subresources.layerCount = 1;
     subresources.baseMipLevel = 0;
-    subresources.levelCount = 1;
+    subresources.levelCount = this->mipLevels;
 
     Result<VkImageView> result = this->image->getImageView(components,
                                                            subresources,
                                                            type);
     if (!result.hasError()) {
         this->view = static_cast<VkImageView>(result);
+        this->viewRelocations = this->image->getRelocationCount();
         return Result<void>::createError(Error::None);
     }
 
@@ -69,6 +108,31 @@ VkBufferImageCopy Texture::getBufferImageCopy() const noexcept {
     return bufferImageCopy;
 }
 
+std::vector<VkBufferImageCopy> Texture::getBufferImageCopies() const noexcept {
+    // Decoded Pixels Hold Only Base Level
+    if (this->file == nullptr) {
+        return std::vector<VkBufferImageCopy>(1, this->getBufferImageCopy());
+    }
+
+    std::vector<VkBufferImageCopy> bufferImageCopies(this->mipLevels);
+
+    for (uint32 i = 0; i < this->mipLevels; i++) {
+        const TextureFileLevel &level = this->fileInfo.levels[i];
+
+        bufferImageCopies[i].bufferOffset = level.offset;
+        bufferImageCopies[i].bufferRowLength = 0;
+        bufferImageCopies[i].bufferImageHeight = 0;
+        bufferImageCopies[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        bufferImageCopies[i].imageSubresource.mipLevel = i;
+        bufferImageCopies[i].imageSubresource.baseArrayLayer = 0;
+        bufferImageCopies[i].imageSubresource.layerCount = 1;
+        bufferImageCopies[i].imageExtent = { level.width, level.height, 1 };
+        bufferImageCopies[i].imageOffset = { 0, 0, 0 };
+    }
+
+    return bufferImageCopies;
+}
+
 Result<VkDevice> Texture::getGraphicsDevice() const noexcept {
     GraphicsManager &graphicsManager = GraphicsManager::getManager();
     Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
@@ -90,36 +154,80 @@ Result<std::shared_ptr<Renderer>> Texture::getRenderer() const noexcept {
     return worldManager.getRenderer();
 }
 
-Result<RawImageInfo> Texture::loadImage(const utf8 *filename) const noexcept {
-    FREE_IMAGE_FORMAT fmt = FreeImage_GetFileType(filename);
+/* Converte img em pixels RGBA de 32 bits, liberando img em todos os casos. */
+static Result<RawImageInfo> convertImage(FIBITMAP *img) noexcept {
     RawImageInfo info = {};
+    FIBITMAP *tmp = img ? FreeImage_ConvertTo32Bits(img) : nullptr;
 
-    if (fmt != FIF_UNKNOWN) {
-        FIBITMAP *img = FreeImage_Load(fmt, filename);
-        FIBITMAP *tmp = FreeImage_ConvertTo32Bits(img);
+    // Source Bitmap Is Released Whether Or Not Conversion Succeeded
+    if (img) {
+        FreeImage_Unload(img);
+    }
 
-        if (img && tmp) {
-            FreeImage_Unload(img);
-            img = tmp;
+    if (tmp) {
+        img = tmp;
 
-            // Configure Image Info
-            info.width = FreeImage_GetWidth(img);
-            info.height = FreeImage_GetHeight(img);
-            info.pixels = FreeImage_GetBits(img);
+        // Configure Image Info
+        info.width = FreeImage_GetWidth(img);
+        info.height = FreeImage_GetHeight(img);
+        info.pixels.assign(FreeImage_GetBits(img), FreeImage_GetBits(img) + 4 * info.width * info.height);
 
-            return Result<RawImageInfo>(info);
-        }
-        else {
-            return Result<RawImageInfo>::createError(Error::FailedToLoadImage);
+        // FreeImage Stores Pixels In Native Byte Order, Textures Are RGBA
+        if (FI_RGBA_RED != 0) {
+            for (uint64 i = 0; i < info.pixels.size(); i += 4) {
+                std::swap(info.pixels[i + FI_RGBA_RED], info.pixels[i + FI_RGBA_BLUE]);
+            }
         }
+
+        FreeImage_Unload(img);
+        return Result<RawImageInfo>(std::move(info));
+    }
+
+    return Result<RawImageInfo>::createError(Error::FailedToLoadImage);
+}
+
+Result<RawImageInfo> Texture::loadImage(const utf8 *filename) noexcept {
+    FREE_IMAGE_FORMAT fmt = FreeImage_GetFileType(filename);
+
+    if (fmt != FIF_UNKNOWN) {
+        return convertImage(FreeImage_Load(fmt, filename));
     }
 
     return Result<RawImageInfo>::createError(Error::UnknownImageFormat);
 }
 
+Result<RawImageInfo> Texture::loadImage(const uint8 *data, uint64 siz) noexcept {
+    FIMEMORY *stream = FreeImage_OpenMemory(const_cast<BYTE *>(data), static_cast<DWORD>(siz));
+    FREE_IMAGE_FORMAT fmt = stream ? FreeImage_GetFileTypeFromMemory(stream) : FIF_UNKNOWN;
+    Result<RawImageInfo> result = Result<RawImageInfo>::createError(Error::UnknownImageFormat);
+
+    if (fmt != FIF_UNKNOWN) {
+        result = convertImage(FreeImage_LoadFromMemory(fmt, stream));
+    }
+
+    if (stream) {
+        FreeImage_CloseMemory(stream);
+    }
+
+    return result;
+}
+
 Texture::~Texture() {
-    this->buffer.reset();
+    // Image Must Outlive Its Pending Upload
+    if (this->ticket != NULL_TRANSFER_TICKET) {
+        Result<std::shared_ptr<Renderer>> result = this->getRenderer();
+
+        if (!result.hasError()) {
+            auto renderer = static_cast<std::shared_ptr<Renderer>>(result);
+
+            if (renderer->getTransferScheduler() != nullptr) {
+                renderer->getTransferScheduler()->wait(this->ticket);
+            }
+        }
+    }
+
     this->image.reset();
+    this->pixels.clear();
     this->width = 0;
     this->height = 0;
 
@@ -133,56 +241,121 @@ Texture::~Texture() {
     }
 }
 
-Result<std::shared_ptr<Texture>> Texture::createTextureFromFile(const utf8 *filename) {
+Result<std::shared_ptr<Texture>> Texture::createTexture(uint32 width, uint32 height) {
+    std::shared_ptr<Texture> texture(new Texture);
+
+    texture->width = width;
+    texture->height = height;
+    texture->pixels.assign(4ull * width * height, 0);
+
+    Result<void> result = texture->createImage();
+    if (!result.hasError()) {
+        return Result<std::shared_ptr<Texture>>(std::move(texture));
+    }
+
+    return Result<std::shared_ptr<Texture>>::createError(result.getError());
+}
+
+Result<std::shared_ptr<Texture>> Texture::createTextureFromFile(const utf8 *filename,
+                                                                std::shared_ptr<MappedFile> mappedFile) {
     std::shared_ptr<Texture> texture(new Texture);
 
     // Load Image
-    Result<RawImageInfo> imageResult = texture->loadImage(filename);
-    if (!imageResult.hasError()) {
-        auto rawImageInfo = static_cast<RawImageInfo>(imageResult);
-
-        VkDeviceSize size = 4 * rawImageInfo.width * rawImageInfo.height;
-
-        Result<std::shared_ptr<Buffer>> bufferResult = Buffer::createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-        if (!bufferResult.hasError()) {
-            texture->buffer = static_cast<std::shared_ptr<Buffer>>(bufferResult);
-            texture->buffer->fillBuffer(size, static_cast<void*>(rawImageInfo.pixels));
-
-            VkExtent3D extent = {};
-            texture->width = extent.width = rawImageInfo.width;
-            texture->height = extent.height = rawImageInfo.height;
-            extent.depth = 1;
-
-            Result<std::shared_ptr<Image>> imageResult = Image::createImage(extent,
-                                                                            VK_IMAGE_TYPE_2D,
-                                                                            1,
-                                                                            1,
-                                                                            VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-                                                                            VK_IMAGE_USAGE_SAMPLED_BIT,
-                                                                            VK_FORMAT_R8G8B8A8_UNORM,
-                                                                            VK_IMAGE_TILING_OPTIMAL);
-
-            if (!imageResult.hasError()) {
-                texture->image = static_cast<std::shared_ptr<Image>>(imageResult);
-                return Result<std::shared_ptr<Texture>>(std::move(texture));
-            }
-            else {
-                return Result<std::shared_ptr<Texture>>::createError(imageResult.getError());
-            }
+    Result<void> decodeResult = texture->decode(filename, std::move(mappedFile));
+    if (!decodeResult.hasError()) {
+        Result<void> imgResult = texture->createImage();
+
+        if (!imgResult.hasError()) {
+            return Result<std::shared_ptr<Texture>>(std::move(texture));
         }
         else {
-            return Result<std::shared_ptr<Texture>>::createError(bufferResult.getError());
+            return Result<std::shared_ptr<Texture>>::createError(imgResult.getError());
         }
     }
 
-    return Result<std::shared_ptr<Texture>>::createError(imageResult.getError());
+    return Result<std::shared_ptr<Texture>>::createError(decodeResult.getError());
 }
 
-Result<std::weak_ptr<class Buffer>> Texture::getBuffer() const noexcept {
-    if (this->buffer != nullptr)
-        return Result<std::weak_ptr<class Buffer>>(this->buffer);
-    else
-        return Result<std::weak_ptr<class Buffer>>::createError(Error::FailedToRetrieveBuffer);
+Result<std::shared_ptr<Texture>> Texture::createTextureFromFileAsync(const utf8 *filename,
+                                                                     std::shared_ptr<MappedFile> mappedFile) {
+    std::shared_ptr<Texture> texture(new Texture);
+    Result<std::shared_ptr<Renderer>> result = texture->getRenderer();
+
+    if (!result.hasError()) {
+        auto renderer = static_cast<std::shared_ptr<Renderer>>(result);
+
+        texture->state = TextureState::Decoding;
+        texture->bStreamed = true;
+
+        // Decoded On Job Threads, Uploaded By Render Thread
+        renderer->getTextureLoader()->request(texture, filename, std::move(mappedFile));
+        return Result<std::shared_ptr<Texture>>(std::move(texture));
+    }
+
+    return Result<std::shared_ptr<Texture>>::createError(result.getError());
+}
+
+Result<void> Texture::decode(const utf8 *filename, std::shared_ptr<MappedFile> mappedFile) {
+    // Cooked Files Are Already In Upload Layout
+    if (isTextureFile(filename)) {
+        Result<std::shared_ptr<MappedFile>> mapped = mappedFile != nullptr ?
+                                                     Result<std::shared_ptr<MappedFile>>(std::move(mappedFile)) :
+                                                     MappedFile::createMappedFile(filename);
+
+        if (!mapped.hasError()) {
+            mappedFile = static_cast<std::shared_ptr<MappedFile>>(mapped);
+            Result<TextureFileInfo> parsed = parseTextureFile(mappedFile->getData(), mappedFile->getSize());
+
+            if (!parsed.hasError()) {
+                this->fileInfo = static_cast<TextureFileInfo>(parsed);
+                this->file = std::move(mappedFile);
+                this->width = this->fileInfo.header.width;
+                this->height = this->fileInfo.header.height;
+                this->format = this->fileInfo.header.format;
+                this->mipLevels = this->fileInfo.header.mipLevels;
+
+                this->state = TextureState::Decoded;
+                return Result<void>::createError(Error::None);
+            }
+
+            this->state = TextureState::Failed;
+            return Result<void>::createError(parsed.getError());
+        }
+
+        this->state = TextureState::Failed;
+        return Result<void>::createError(mapped.getError());
+    }
+
+    // Bytes Already Read By Caller Are Decoded Without Reading File Again
+    Result<RawImageInfo> result = mappedFile != nullptr ?
+                                  Texture::loadImage(mappedFile->getData(), mappedFile->getSize()) :
+                                  Texture::loadImage(filename);
+
+    if (!result.hasError()) {
+        auto rawImageInfo = static_cast<RawImageInfo>(result);
+
+        this->width = rawImageInfo.width;
+        this->height = rawImageInfo.height;
+        this->mipLevels = Texture::getMipLevelCount(this->width, this->height);
+        this->pixels = std::move(rawImageInfo.pixels);
+
+        // Publish Pixels To Render Thread
+        this->state = TextureState::Decoded;
+        return Result<void>::createError(Error::None);
+    }
+
+    this->state = TextureState::Failed;
+    return Result<void>::createError(result.getError());
+}
+
+uint32 Texture::getMipLevelCount(uint32 width, uint32 height) noexcept {
+    uint32 levels = 1;
+
+    for (uint32 extent = std::max(width, height); extent > 1; extent /= 2) {
+        levels++;
+    }
+
+    return levels;
 }
 
 VkImageView Texture::getImageView() const noexcept {
@@ -191,48 +364,61 @@ VkImageView Texture::getImageView() const noexcept {
 
 
 Result<void> Texture::load() {
+    // Already Uploaded Or Still Decoding
+    if (this->state != TextureState::Decoded) {
+        if (this->state == TextureState::Failed) {
+            return Result<void>::createError(Error::FailedToLoadImage);
+        }
+
+        return Result<void>::createError(Error::None);
+    }
+
+    // Streamed Textures Know Their Size Only After Decoding
+    if (this->image == nullptr) {
+        Result<void> imgResult = this->createImage();
+
+        if (imgResult.hasError()) {
+            this->state = TextureState::Failed;
+            return imgResult;
+        }
+    }
+
     Result<std::shared_ptr<Renderer>> result = this->getRenderer();
 
     if (!result.hasError()) {
         auto renderer = static_cast<std::shared_ptr<Renderer>>(result);
-        Result<VkCommandBuffer> rslt = renderer->requestTransferBuffer();
+        std::vector<VkBufferImageCopy> bufferImageCopies = this->getBufferImageCopies();
+        const void *data = this->file != nullptr ? static_cast<const void *>(this->fileInfo.data) : this->pixels.data();
+        uint64 siz = this->file != nullptr ? this->fileInfo.header.dataSize : this->pixels.size();
+
+        // Pixels Or Mapped Levels Are Copied Into Shared Staging Ring, Reclaimed When Transfer Fence Signals
+        Result<TransferTicket> rslt = renderer->getTransferScheduler()->uploadImage(
+                *this->image,
+                data,
+                siz,
+                bufferImageCopies.data(),
+                static_cast<uint32>(bufferImageCopies.size()),
+                this->file == nullptr);
 
         if (!rslt.hasError()) {
-            auto buf = static_cast<VkBuffer>(this->buffer->getVulkanBuffer());
-            auto img = static_cast<VkImage>(this->image->getVulkanImage());
-            auto transferBuffer = static_cast<VkCommandBuffer>(rslt);
-            VkBufferImageCopy bufferImageCopy = this->getBufferImageCopy();
-
-            this->image->transitionLayout(transferBuffer,
-                                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                          VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                                          VK_PIPELINE_STAGE_TRANSFER_BIT);
-            vkCmdCopyBufferToImage(transferBuffer,
-                                   buf,
-                                   img,
-                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                   1,
-                                   &bufferImageCopy);
-            this->image->transitionLayout(transferBuffer,
-                                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                          VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-
-            Result<void> executeResult = renderer->executeTransferBuffer(transferBuffer);
-            if (!executeResult.hasError()) {
-                Result<void> viewResult = this->createImageView();
-
-                if (!viewResult.hasError()) {
-                    return Result<void>::createError(Error::None);
-                }
-                else {
-                    return Result<void>::createError(viewResult.getError());
-                }
-            }
-            else {
-                return Result<void>::createError(executeResult.getError());
+            this->ticket = static_cast<TransferTicket>(rslt);
+            this->memorySize = siz;
+
+            // Count Levels Generated On GPU
+            for (uint32 i = 1; this->file == nullptr && i < this->mipLevels; i++) {
+                this->memorySize += 4ull * std::max(this->width >> i, 1u) * std::max(this->height >> i, 1u);
             }
+
+            // Renderer Waits For Eager Textures, Streamed Ones Wait For updateResidency
+            this->state = this->bStreamed ? TextureState::Uploading : TextureState::Resident;
+
+            // Release CPU Copy
+            this->pixels.clear();
+            this->pixels.shrink_to_fit();
+            this->file.reset();
+            this->fileInfo = TextureFileInfo {};
+
+            return this->createImageView();
         }
         else {
             return Result<void>::createError(rslt.getError());
@@ -241,3 +427,54 @@ Result<void> Texture::load() {
 
     return Result<void>::createError(result.getError());
 }
+
+Result<void> Texture::refreshImageView() {
+    if (this->view == VK_NULL_HANDLE || this->image->getRelocationCount() == this->viewRelocations) {
+        return Result<void>::createError(Error::None);
+    }
+
+    Result<std::shared_ptr<Renderer>> result = this->getRenderer();
+
+    if (!result.hasError()) {
+        auto renderer = static_cast<std::shared_ptr<Renderer>>(result);
+        VkImageView previous = this->view;
+
+        Result<void> rslt = this->createImageView();
+        if (!rslt.hasError()) {
+            // Frames In Flight May Still Sample Through Old View
+            renderer->getDefragmenter()->retireImageView(previous);
+        }
+
+        return rslt;
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+bool Texture::updateResidency(TransferScheduler &scheduler) {
+    if (this->state == TextureState::Uploading && scheduler.isComplete(this->ticket)) {
+        this->state = TextureState::Resident;
+        return true;
+    }
+
+    return false;
+}
+
+Result<void> Texture::writePixels(uint32 x, uint32 y, uint32 width, uint32 height, const uint8 *data) {
+    if (this->isLoaded()) {
+        return Result<void>::createError(Error::TextureAlreadyLoaded);
+    }
+
+    if (x + width > this->width || y + height > this->height || this->pixels.empty()) {
+        return Result<void>::createError(Error::IndexOutOfRange);
+    }
+
+    // Copy Row By Row Into Destination Rectangle
+    for (uint32 row = 0; row < height; row++) {
+        std::copy(data + 4ull * row * width,
+                  data + 4ull * (row + 1) * width,
+                  this->pixels.begin() + 4ull * ((y + row) * this->width + x));
+    }
+
+    return Result<void>::createError(Error::None);
+}
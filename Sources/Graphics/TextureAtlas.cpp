@@ -0,0 +1,207 @@
+/**
+ * TextureAtlas.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "JobManager.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <numeric>
+
+TextureAtlas::TextureAtlas() {
+    this->pages = std::vector<std::shared_ptr<Texture>>();
+    this->packers = std::vector<SkylinePacker>();
+    this->regions = std::unordered_map<std::string, AtlasRegion>();
+    this->pageSize = DEFAULT_ATLAS_PAGE_SIZE;
+}
+
+Result<uint32> TextureAtlas::createPage(uint32 width, uint32 height) {
+    Result<std::shared_ptr<Texture>> result = Texture::createTexture(width, height);
+
+    if (!result.hasError()) {
+        this->pages.push_back(static_cast<std::shared_ptr<Texture>>(result));
+        this->packers.emplace_back(width, height);
+        return Result<uint32>(static_cast<uint32>(this->pages.size()) - 1);
+    }
+
+    return Result<uint32>::createError(result.getError());
+}
+
+TextureAtlas::~TextureAtlas() {
+    this->regions.clear();
+    this->packers.clear();
+    this->pages.clear();
+}
+
+Result<std::shared_ptr<TextureAtlas>> TextureAtlas::createTextureAtlas(uint32 pageSize) {
+    std::shared_ptr<TextureAtlas> atlas(new TextureAtlas);
+
+    atlas->pageSize = pageSize;
+
+    return Result<std::shared_ptr<TextureAtlas>>(std::move(atlas));
+}
+
+Result<AtlasRegion> TextureAtlas::addImage(const utf8 *filename) {
+    auto it = this->regions.find(filename);
+
+    if (it != this->regions.end()) {
+        return Result<AtlasRegion>(it->second);
+    }
+
+    Result<RawImageInfo> result = Texture::loadImage(filename);
+    if (!result.hasError()) {
+        Result<AtlasRegion> rslt = this->addPixels(static_cast<RawImageInfo>(result));
+
+        if (!rslt.hasError()) {
+            this->regions.emplace(filename, static_cast<AtlasRegion>(rslt));
+        }
+
+        return rslt;
+    }
+
+    return Result<AtlasRegion>::createError(result.getError());
+}
+
+Result<std::vector<AtlasRegion>> TextureAtlas::addImages(const std::vector<std::string> &filenames) {
+    JobManager &jobManager = JobManager::getManager();
+    auto count = static_cast<uint32>(filenames.size());
+    std::vector<RawImageInfo> images(count);
+    std::vector<Error> errors(count, Error::None);
+    std::vector<AtlasRegion> regions(count);
+    std::vector<uint32> order(count);
+
+    // Decode Files Not Yet In Atlas In Parallel
+    JobHandle decode = jobManager.parallelFor(count, 1, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; i++) {
+            if (this->regions.find(filenames[i]) != this->regions.end()) {
+                continue;
+            }
+
+            Result<RawImageInfo> result = Texture::loadImage(filenames[i].c_str());
+            if (!result.hasError()) {
+                images[i] = static_cast<RawImageInfo>(result);
+            }
+            else {
+                errors[i] = result.getError();
+            }
+        }
+    });
+    jobManager.wait(decode);
+
+    // Place Tallest Images First
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) {
+        return images[a].height > images[b].height;
+    });
+
+    for (uint32 i : order) {
+        auto it = this->regions.find(filenames[i]);
+
+        if (it != this->regions.end()) {
+            regions[i] = it->second;
+            continue;
+        }
+
+        if (errors[i] != Error::None) {
+            return Result<std::vector<AtlasRegion>>::createError(errors[i]);
+        }
+
+        Result<AtlasRegion> result = this->addPixels(images[i]);
+        if (result.hasError()) {
+            return Result<std::vector<AtlasRegion>>::createError(result.getError());
+        }
+
+        regions[i] = static_cast<AtlasRegion>(result);
+        this->regions.emplace(filenames[i], regions[i]);
+    }
+
+    return Result<std::vector<AtlasRegion>>(std::move(regions));
+}
+
+Result<AtlasRegion> TextureAtlas::addPixels(const RawImageInfo &info) {
+    uint32 width = info.width + 2 * ATLAS_PADDING;
+    uint32 height = info.height + 2 * ATLAS_PADDING;
+    uint32 page = static_cast<uint32>(this->pages.size());
+    PackedRect rect = {};
+
+    if (info.width == 0 || info.height == 0) {
+        return Result<AtlasRegion>::createError(Error::IndexOutOfRange);
+    }
+
+    // Try Every Page Still Accepting Images
+    for (uint32 i = 0; i < this->pages.size(); i++) {
+        if (this->pages[i]->isLoaded()) {
+            continue;
+        }
+
+        Result<PackedRect> result = this->packers[i].insert(width, height);
+        if (!result.hasError()) {
+            rect = static_cast<PackedRect>(result);
+            page = i;
+            break;
+        }
+    }
+
+    // Open New Page, Sized To Image When It Exceeds Page Size
+    if (page == this->pages.size()) {
+        Result<uint32> result = this->createPage(std::max(this->pageSize, width), std::max(this->pageSize, height));
+
+        if (result.hasError()) {
+            return Result<AtlasRegion>::createError(result.getError());
+        }
+
+        page = static_cast<uint32>(result);
+
+        Result<PackedRect> rslt = this->packers[page].insert(width, height);
+        if (rslt.hasError()) {
+            return Result<AtlasRegion>::createError(rslt.getError());
+        }
+
+        rect = static_cast<PackedRect>(rslt);
+    }
+
+    // Extrude Image Edges Into Padding
+    std::vector<uint8> block(4ull * width * height);
+    for (uint32 y = 0; y < height; y++) {
+        uint32 sy = std::min(std::max(y, ATLAS_PADDING) - ATLAS_PADDING, info.height - 1);
+
+        for (uint32 x = 0; x < width; x++) {
+            uint32 sx = std::min(std::max(x, ATLAS_PADDING) - ATLAS_PADDING, info.width - 1);
+
+            std::copy(info.pixels.begin() + 4ull * (sy * info.width + sx),
+                      info.pixels.begin() + 4ull * (sy * info.width + sx + 1),
+                      block.begin() + 4ull * (y * width + x));
+        }
+    }
+
+    std::shared_ptr<Texture> &texture = this->pages[page];
+    Result<void> result = texture->writePixels(rect.x, rect.y, width, height, block.data());
+    if (result.hasError()) {
+        return Result<AtlasRegion>::createError(result.getError());
+    }
+
+    AtlasRegion region = {};
+    region.texture = texture;
+    region.uvRect = glm::vec4(static_cast<real32>(rect.x + ATLAS_PADDING) / texture->getWidth(),
+                              static_cast<real32>(rect.y + ATLAS_PADDING) / texture->getHeight(),
+                              static_cast<real32>(info.width) / texture->getWidth(),
+                              static_cast<real32>(info.height) / texture->getHeight());
+
+    return Result<AtlasRegion>(std::move(region));
+}
+
+Result<void> TextureAtlas::load() {
+    for (auto &page : this->pages) {
+        Result<void> result = page->load();
+
+        if (result.hasError()) {
+            return result;
+        }
+    }
+
+    return Result<void>::createError(Error::None);
+}
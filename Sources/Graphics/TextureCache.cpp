@@ -0,0 +1,235 @@
+/**
+ * TextureCache.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "MappedFile.h"
+#include "Texture.h"
+#include "TextureCache.h"
+
+#include <cstring>
+
+static uint64 hashContents(const uint8 *data, uint64 siz) noexcept {
+    uint64 hash = 0xcbf29ce484222325ull;
+
+    // FNV-1a
+    for (uint64 i = 0; i < siz; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+/* Compara, byte a byte, o conteúdo de filename com o de file. */
+static bool hasSameContents(const std::string &filename, const MappedFile &file) noexcept {
+    Result<std::shared_ptr<MappedFile>> mapped = MappedFile::createMappedFile(filename.c_str());
+
+    if (mapped.hasError()) {
+        return false;
+    }
+
+    auto other = static_cast<std::shared_ptr<MappedFile>>(mapped);
+    return other->getSize() == file.getSize() &&
+           (file.getSize() == 0 || std::memcmp(other->getData(), file.getData(), file.getSize()) == 0);
+}
+
+TextureCache::TextureCache() {
+    this->paths = std::unordered_map<std::string, uint64>();
+    this->entries = std::unordered_map<uint64, TextureCacheEntry>();
+    this->unreferenced = std::list<uint64>();
+    this->unreferencedSize = 0;
+    this->budget = DEFAULT_TEXTURE_CACHE_BUDGET;
+    this->frame = 0;
+    this->framesInFlight = 0;
+    this->hits = 0;
+    this->misses = 0;
+}
+
+TextureCache::~TextureCache() {
+    // Outstanding References Keep Their Textures Alive On Their Own
+    this->unreferenced.clear();
+    this->entries.clear();
+    this->paths.clear();
+}
+
+Result<std::shared_ptr<TextureCache>> TextureCache::createTextureCache(uint32 framesInFlight, uint64 budget) {
+    std::shared_ptr<TextureCache> cache(new TextureCache);
+
+    cache->framesInFlight = framesInFlight;
+    cache->budget = budget;
+    cache->self = cache;
+
+    return Result<std::shared_ptr<TextureCache>>(std::move(cache));
+}
+
+std::shared_ptr<Texture> TextureCache::createReference(uint64 hash, TextureCacheEntry &entry) {
+    // Revive Entry Waiting For Eviction
+    if (entry.references == 0 && entry.lru != this->unreferenced.end()) {
+        this->unreferenced.erase(entry.lru);
+        this->unreferencedSize -= entry.memorySize;
+        entry.lru = this->unreferenced.end();
+    }
+
+    entry.references++;
+
+    std::weak_ptr<TextureCache> cache = this->self;
+    std::shared_ptr<Texture> texture = entry.texture;
+
+    return std::shared_ptr<Texture>(texture.get(), [cache, texture, hash](Texture *) {
+        if (std::shared_ptr<TextureCache> owner = cache.lock()) {
+            owner->release(hash);
+        }
+    });
+}
+
+void TextureCache::evict(uint64 hash) {
+    auto entry = this->entries.find(hash);
+
+    if (entry != this->entries.end()) {
+        for (auto &path : entry->second.paths) {
+            this->paths.erase(path);
+        }
+
+        this->entries.erase(entry);
+    }
+}
+
+void TextureCache::release(uint64 hash) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto entry = this->entries.find(hash);
+
+    if (entry != this->entries.end() && --entry->second.references == 0) {
+        entry->second.memorySize = entry->second.texture->getMemorySize();
+        entry->second.releasedFrame = this->frame;
+        entry->second.lru = this->unreferenced.insert(this->unreferenced.begin(), hash);
+        this->unreferencedSize += entry->second.memorySize;
+    }
+}
+
+Result<std::shared_ptr<Texture>> TextureCache::acquire(const std::string &filename, bool bStreamed) {
+    std::shared_ptr<Texture> candidate = nullptr;
+    std::string candidatePath;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto path = this->paths.find(filename);
+
+        if (path != this->paths.end()) {
+            this->hits++;
+            return Result<std::shared_ptr<Texture>>(this->createReference(path->second,
+                                                                          this->entries.at(path->second)));
+        }
+    }
+
+    Result<std::shared_ptr<MappedFile>> mapped = MappedFile::createMappedFile(filename.c_str());
+
+    if (mapped.hasError()) {
+        return Result<std::shared_ptr<Texture>>::createError(mapped.getError());
+    }
+
+    auto file = static_cast<std::shared_ptr<MappedFile>>(mapped);
+    uint64 hash = hashContents(file->getData(), file->getSize());
+    uint64 contentSize = file->getSize();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto entry = this->entries.find(hash);
+
+        // Pin Entry So It Cannot Be Evicted While Its Bytes Are Compared
+        if (entry != this->entries.end() && entry->second.contentSize == contentSize) {
+            candidate = this->createReference(hash, entry->second);
+            candidatePath = entry->second.paths.front();
+        }
+    }
+
+    // Identical Contents Under Another Path Share One Texture, Colliding Hashes Never Do
+    if (candidate != nullptr && hasSameContents(candidatePath, *file)) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (this->paths.emplace(filename, hash).second) {
+            this->entries.at(hash).paths.push_back(filename);
+        }
+
+        this->hits++;
+        return Result<std::shared_ptr<Texture>>(std::move(candidate));
+    }
+
+    candidate.reset();
+    this->misses++;
+
+    // Decode Without Lock, Reusing Bytes Already Mapped For Hashing
+    Result<std::shared_ptr<Texture>> result = bStreamed ?
+                                              Texture::createTextureFromFileAsync(filename.c_str(), file) :
+                                              Texture::createTextureFromFile(filename.c_str(), file);
+
+    if (result.hasError()) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Another Thread Cached Same File While This One Decoded
+    auto path = this->paths.find(filename);
+    if (path != this->paths.end()) {
+        return Result<std::shared_ptr<Texture>>(this->createReference(path->second, this->entries.at(path->second)));
+    }
+
+    // Hash Taken By Contents Not Compared Against Is Left Uncached
+    if (this->entries.find(hash) != this->entries.end()) {
+        return result;
+    }
+
+    TextureCacheEntry &created = this->entries[hash];
+
+    created.texture = static_cast<std::shared_ptr<Texture>>(result);
+    created.paths.push_back(filename);
+    created.contentSize = contentSize;
+    created.references = 0;
+    created.memorySize = 0;
+    created.releasedFrame = 0;
+    created.lru = this->unreferenced.end();
+    this->paths[filename] = hash;
+
+    return Result<std::shared_ptr<Texture>>(this->createReference(hash, created));
+}
+
+uint32 TextureCache::getEntryCount() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return static_cast<uint32>(this->entries.size());
+}
+
+uint64 TextureCache::getUnreferencedSize() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->unreferencedSize;
+}
+
+void TextureCache::setBudget(uint64 bytes) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->budget = bytes;
+}
+
+void TextureCache::update() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->frame++;
+
+    // Oldest Releases First, Stopping At Textures Frames In Flight May Still Sample
+    while (this->unreferencedSize > this->budget && !this->unreferenced.empty()) {
+        uint64 hash = this->unreferenced.back();
+        TextureCacheEntry &entry = this->entries[hash];
+
+        if (entry.releasedFrame + this->framesInFlight > this->frame) {
+            break;
+        }
+
+        this->unreferencedSize -= entry.memorySize;
+        this->unreferenced.pop_back();
+        this->evict(hash);
+    }
+}
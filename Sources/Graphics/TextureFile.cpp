@@ -0,0 +1,141 @@
+/**
+ * TextureFile.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Texture.h"
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vulkan/vulkan.h>
+
+static inline uint64 alignUp(uint64 value, uint64 align) noexcept {
+    return (value + align - 1) & ~(align - 1);
+}
+
+static std::vector<uint8> downsample(const std::vector<uint8> &pixels, uint32 width, uint32 height) {
+    uint32 nextWidth = std::max(width / 2, 1u);
+    uint32 nextHeight = std::max(height / 2, 1u);
+    std::vector<uint8> next(4ull * nextWidth * nextHeight);
+
+    // Average 2x2 Blocks, Clamping On Odd Edges
+    for (uint32 y = 0; y < nextHeight; y++) {
+        uint32 y0 = std::min(2 * y, height - 1);
+        uint32 y1 = std::min(2 * y + 1, height - 1);
+
+        for (uint32 x = 0; x < nextWidth; x++) {
+            uint32 x0 = std::min(2 * x, width - 1);
+            uint32 x1 = std::min(2 * x + 1, width - 1);
+
+            for (uint32 c = 0; c < 4; c++) {
+                uint32 sum = pixels[4ull * (y0 * width + x0) + c] + pixels[4ull * (y0 * width + x1) + c] +
+                             pixels[4ull * (y1 * width + x0) + c] + pixels[4ull * (y1 * width + x1) + c];
+
+                next[4ull * (y * nextWidth + x) + c] = static_cast<uint8>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return next;
+}
+
+Result<void> cookTexture(const RawImageInfo &image, const utf8 *filename, bool bMipmaps) {
+    std::vector<std::vector<uint8>> levels;
+    std::vector<TextureFileLevel> table;
+    TextureFileHeader header = {};
+
+    if (image.width == 0 || image.height == 0 || image.pixels.size() != 4ull * image.width * image.height) {
+        return Result<void>::createError(Error::InvalidTextureFile);
+    }
+
+    // Build Mip Chain Down To 1x1
+    levels.push_back(image.pixels);
+    table.push_back(TextureFileLevel { 0, image.pixels.size(), image.width, image.height });
+    while (bMipmaps && (table.back().width > 1 || table.back().height > 1)) {
+        TextureFileLevel level = {};
+
+        levels.push_back(downsample(levels.back(), table.back().width, table.back().height));
+        level.width = std::max(table.back().width / 2, 1u);
+        level.height = std::max(table.back().height / 2, 1u);
+        level.offset = alignUp(table.back().offset + table.back().size, TEXTURE_FILE_ALIGNMENT);
+        level.size = levels.back().size();
+        table.push_back(level);
+    }
+
+    header.magic = TEXTURE_FILE_MAGIC;
+    header.version = TEXTURE_FILE_VERSION;
+    header.format = VK_FORMAT_R8G8B8A8_UNORM;
+    header.width = image.width;
+    header.height = image.height;
+    header.mipLevels = static_cast<uint32>(table.size());
+    header.dataOffset = alignUp(sizeof(TextureFileHeader) + table.size() * sizeof(TextureFileLevel),
+                                TEXTURE_FILE_ALIGNMENT);
+    header.dataSize = table.back().offset + table.back().size;
+
+    // Lay Out File Exactly As It Is Mapped
+    std::vector<uint8> contents(header.dataOffset + header.dataSize, 0);
+    memcpy(contents.data(), &header, sizeof(TextureFileHeader));
+    memcpy(contents.data() + sizeof(TextureFileHeader), table.data(), table.size() * sizeof(TextureFileLevel));
+    for (uint32 i = 0; i < table.size(); i++) {
+        memcpy(contents.data() + header.dataOffset + table[i].offset, levels[i].data(), levels[i].size());
+    }
+
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    if (!stream.write(reinterpret_cast<const char *>(contents.data()), contents.size())) {
+        return Result<void>::createError(Error::FailedToWriteTextureFile);
+    }
+
+    return Result<void>::createError(Error::None);
+}
+
+bool isTextureFile(const utf8 *filename) noexcept {
+    size_t length = strlen(filename);
+    size_t extension = strlen(TEXTURE_FILE_EXTENSION);
+
+    return length >= extension && strcmp(filename + length - extension, TEXTURE_FILE_EXTENSION) == 0;
+}
+
+Result<TextureFileInfo> parseTextureFile(const uint8 *bytes, uint64 size) noexcept {
+    TextureFileInfo info = {};
+
+    if (size < sizeof(TextureFileHeader)) {
+        return Result<TextureFileInfo>::createError(Error::InvalidTextureFile);
+    }
+
+    memcpy(&info.header, bytes, sizeof(TextureFileHeader));
+
+    // Only RGBA8 Is Cooked Today
+    const TextureFileHeader &header = info.header;
+    if (header.magic != TEXTURE_FILE_MAGIC || header.version != TEXTURE_FILE_VERSION ||
+        header.format != VK_FORMAT_R8G8B8A8_UNORM || header.width == 0 || header.height == 0 ||
+        header.mipLevels == 0 || header.mipLevels > Texture::getMipLevelCount(header.width, header.height)) {
+        return Result<TextureFileInfo>::createError(Error::InvalidTextureFile);
+    }
+
+    // Compare By Subtraction So Hostile Offsets Cannot Wrap Around
+    uint64 tableEnd = sizeof(TextureFileHeader) + static_cast<uint64>(header.mipLevels) * sizeof(TextureFileLevel);
+    if (tableEnd > header.dataOffset || header.dataOffset % TEXTURE_FILE_ALIGNMENT != 0 ||
+        header.dataOffset > size || header.dataSize > size - header.dataOffset) {
+        return Result<TextureFileInfo>::createError(Error::InvalidTextureFile);
+    }
+
+    info.levels = reinterpret_cast<const TextureFileLevel *>(bytes + sizeof(TextureFileHeader));
+    info.data = bytes + header.dataOffset;
+
+    // Every Level Must Have Its Mip Extent, Hold All Its Texels And Lie Inside Data
+    for (uint32 i = 0; i < header.mipLevels; i++) {
+        const TextureFileLevel &level = info.levels[i];
+
+        if (level.width != std::max(header.width >> i, 1u) || level.height != std::max(header.height >> i, 1u) ||
+            level.size < 4ull * level.width * level.height || level.offset > header.dataSize ||
+            level.size > header.dataSize - level.offset) {
+            return Result<TextureFileInfo>::createError(Error::InvalidTextureFile);
+        }
+    }
+
+    return Result<TextureFileInfo>(info);
+}
@@ -0,0 +1,149 @@
+/**
+ * TextureLoader.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "MappedFile.h"
+#include "Texture.h"
+#include "TextureLoader.h"
+#include "TransferScheduler.h"
+
+#include <algorithm>
+
+TextureLoader::TextureLoader() {
+    this->transferScheduler = nullptr;
+    this->decodes = std::vector<JobHandle>();
+    this->decoded = std::vector<std::weak_ptr<Texture>>();
+    this->uploading = std::vector<std::weak_ptr<Texture>>();
+    this->budget = DEFAULT_TEXTURE_UPLOAD_BUDGET;
+    this->version = 0;
+}
+
+TextureLoader::~TextureLoader() {
+    JobManager &jobManager = JobManager::getManager();
+    std::vector<JobHandle> decodes;
+
+    // Decode Jobs Reference This Loader
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        decodes.swap(this->decodes);
+    }
+
+    for (auto &job : decodes) {
+        jobManager.wait(job);
+    }
+
+    this->decoded.clear();
+    this->uploading.clear();
+    this->transferScheduler.reset();
+}
+
+Result<std::shared_ptr<TextureLoader>> TextureLoader::createTextureLoader(std::shared_ptr<TransferScheduler> scheduler,
+                                                                          uint64 budget) {
+    std::shared_ptr<TextureLoader> loader(new TextureLoader);
+
+    loader->transferScheduler = std::move(scheduler);
+    loader->budget = budget;
+
+    return Result<std::shared_ptr<TextureLoader>>(std::move(loader));
+}
+
+uint32 TextureLoader::getPendingCount() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto count = static_cast<uint32>(this->decoded.size() + this->uploading.size());
+
+    for (auto &job : this->decodes) {
+        if (!job->bFinished.load()) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void TextureLoader::request(const std::shared_ptr<Texture> &texture,
+                            const std::string &filename,
+                            std::shared_ptr<MappedFile> mappedFile) {
+    JobManager &jobManager = JobManager::getManager();
+    std::weak_ptr<Texture> weak = texture;
+
+    JobHandle job = jobManager.createJob([this, weak, filename, mappedFile] {
+        std::shared_ptr<Texture> txt = weak.lock();
+
+        // Texture Dropped Before Its Turn
+        if (txt == nullptr) {
+            return;
+        }
+
+        if (!txt->decode(filename.c_str(), mappedFile).hasError()) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->decoded.push_back(weak);
+        }
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->decodes.push_back(job);
+    }
+
+    jobManager.submit(job);
+}
+
+void TextureLoader::setBudget(uint64 bytes) noexcept {
+    this->budget = bytes;
+}
+
+void TextureLoader::update() {
+    std::vector<std::weak_ptr<Texture>> decoded;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->decodes.erase(std::remove_if(this->decodes.begin(), this->decodes.end(),
+                                           [](const JobHandle &job) { return job->bFinished.load(); }),
+                            this->decodes.end());
+        decoded.swap(this->decoded);
+    }
+
+    // Flip Finished Uploads Before Their Acquires Are Recorded
+    this->uploading.erase(std::remove_if(this->uploading.begin(), this->uploading.end(),
+                                         [this](const std::weak_ptr<Texture> &weak) {
+        std::shared_ptr<Texture> texture = weak.lock();
+
+        if (texture == nullptr) {
+            return true;
+        }
+
+        if (texture->updateResidency(*this->transferScheduler)) {
+            this->version++;
+            return true;
+        }
+
+        return texture->getState() != TextureState::Uploading;
+    }), this->uploading.end());
+
+    // Hand Decoded Pixels To Transfer Queue Within Budget
+    uint64 uploaded = 0;
+    uint32 count = 0;
+    for (; count < decoded.size() && uploaded < this->budget; count++) {
+        std::shared_ptr<Texture> texture = decoded[count].lock();
+
+        if (texture == nullptr) {
+            continue;
+        }
+
+        uploaded += 4ull * texture->getWidth() * texture->getHeight();
+
+        if (!texture->load().hasError() && texture->getState() == TextureState::Uploading) {
+            this->uploading.push_back(texture);
+        }
+    }
+
+    // Leave Remainder For Next Frames
+    if (count < decoded.size()) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->decoded.insert(this->decoded.begin(), decoded.begin() + count, decoded.end());
+    }
+}
@@ -0,0 +1,736 @@
+/**
+ * TransferScheduler.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Buffer.h"
+#include "Device.h"
+#include "GraphicsManager.h"
+#include "Image.h"
+#include "Queue.h"
+#include "TransferScheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vulkan/vulkan.h>
+
+TransferScheduler::TransferScheduler() {
+    this->transferQueue = nullptr;
+    this->graphicsFamily = 0;
+    this->pool = VK_NULL_HANDLE;
+    this->ring = nullptr;
+    this->ringMapping = nullptr;
+    this->ringSize = 0;
+    this->ringHead = 0;
+    this->ringTail = 0;
+    this->oversizedSize = 0;
+    this->recording = TransferBatch {};
+    this->recording.ticket = NULL_TRANSFER_TICKET + 1;
+    this->inFlight = std::deque<TransferBatch>();
+    this->pendingBufferAcquires = std::vector<VkBufferMemoryBarrier>();
+    this->pendingImageAcquires = std::vector<VkImageMemoryBarrier>();
+    this->pendingMipmaps = std::vector<MipmapGeneration>();
+    this->spareFences = std::vector<VkFence>();
+    this->completedTicket = NULL_TRANSFER_TICKET;
+}
+
+Result<void> TransferScheduler::beginBatch() {
+    if (this->recording.cmdBuffer != VK_NULL_HANDLE) {
+        return Result<void>::createError(Error::None);
+    }
+
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        // Reuse Fence Of A Retired Batch
+        if (!this->spareFences.empty()) {
+            this->recording.fence = this->spareFences.back();
+            this->spareFences.pop_back();
+        }
+        else {
+            VkFenceCreateInfo fenceCreateInfo = {};
+
+            fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            fenceCreateInfo.pNext = nullptr;
+            fenceCreateInfo.flags = 0;
+
+            if (vkCreateFence(device, &fenceCreateInfo, nullptr, &this->recording.fence) != VK_SUCCESS) {
+                this->recording.fence = VK_NULL_HANDLE;
+                return Result<void>::createError(Error::FailedToCreateFence);
+            }
+        }
+
+        VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+
+        commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferAllocateInfo.pNext = nullptr;
+        commandBufferAllocateInfo.commandBufferCount = 1;
+        commandBufferAllocateInfo.commandPool = this->pool;
+        commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+        if (vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &this->recording.cmdBuffer) != VK_SUCCESS) {
+            this->spareFences.push_back(this->recording.fence);
+            this->recording.fence = VK_NULL_HANDLE;
+            this->recording.cmdBuffer = VK_NULL_HANDLE;
+            return Result<void>::createError(Error::FailedToAllocateCommandBuffer);
+        }
+
+        VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+
+        commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        commandBufferBeginInfo.pNext = nullptr;
+        commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(this->recording.cmdBuffer, &commandBufferBeginInfo);
+        this->recording.ringEnd = this->ringHead;
+
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+Result<VkDevice> TransferScheduler::getGraphicsDevice() const noexcept {
+    GraphicsManager &graphicsManager = GraphicsManager::getManager();
+    Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<std::weak_ptr<const Device>>(result);
+
+        if (std::shared_ptr<const Device> dev = device.lock())
+            return dev->getVulkanDevice();
+        else
+            return Result<VkDevice>::createError(Error::GraphicsManagerNotStartedUp);
+    }
+
+    return Result<VkDevice>::createError(result.getError());
+}
+
+bool TransferScheduler::isOwnershipTransfer() const noexcept {
+    return this->transferQueue->getFamily() != this->graphicsFamily;
+}
+
+Result<uint8 *> TransferScheduler::reserveStaging(uint64 siz, VkBuffer *src, uint64 *off) {
+    // Larger Than Ring, Use Dedicated Staging Buffer Kept Alive By Batch
+    if (siz > this->ringSize) {
+        Result<std::shared_ptr<Buffer>> result = Buffer::createBuffer(siz,
+                                                                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                                      MemoryUsage::Upload);
+
+        if (!result.hasError()) {
+            auto staging = static_cast<std::shared_ptr<Buffer>>(result);
+            Result<void *> mapResult = staging->map();
+
+            if (mapResult.hasError()) {
+                return Result<uint8 *>::createError(mapResult.getError());
+            }
+
+            *src = static_cast<VkBuffer>(staging->getVulkanBuffer());
+            *off = 0;
+            this->recording.oversized.push_back(std::move(staging));
+            this->recording.oversizedSize += siz;
+            this->oversizedSize += siz;
+
+            return Result<uint8 *>(static_cast<uint8 *>(static_cast<void *>(mapResult)));
+        }
+
+        return Result<uint8 *>::createError(result.getError());
+    }
+
+    while (true) {
+        // Ring Is Empty, Restart At Its Beginning
+        if (this->ringHead == this->ringTail) {
+            this->ringHead = this->ringTail = (this->ringHead + this->ringSize - 1) / this->ringSize * this->ringSize;
+        }
+
+        // Never Split A Region Across The End Of The Ring
+        uint64 start = (this->ringHead + STAGING_RING_ALIGNMENT - 1) & ~(STAGING_RING_ALIGNMENT - 1);
+        if (start % this->ringSize + siz > this->ringSize) {
+            start = (start / this->ringSize + 1) * this->ringSize;
+        }
+
+        if (start + siz - this->ringTail <= this->ringSize) {
+            this->ringHead = start + siz;
+            this->recording.ringEnd = this->ringHead;
+
+            *src = static_cast<VkBuffer>(this->ring->getVulkanBuffer());
+            *off = start % this->ringSize;
+
+            return Result<uint8 *>(this->ringMapping + *off);
+        }
+
+        // Ring Is Full, Reclaim Space Of Oldest Batch
+        if (!this->inFlight.empty()) {
+            Result<void> result = this->waitOldestBatch();
+
+            if (result.hasError()) {
+                return Result<uint8 *>::createError(result.getError());
+            }
+        }
+        else {
+            Result<void> result = this->submitBatch();
+
+            if (!result.hasError()) {
+                result = this->beginBatch();
+            }
+
+            if (result.hasError()) {
+                return Result<uint8 *>::createError(result.getError());
+            }
+        }
+    }
+}
+
+void TransferScheduler::retireBatches() {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        while (!this->inFlight.empty() && vkGetFenceStatus(device, this->inFlight.front().fence) == VK_SUCCESS) {
+            TransferBatch &batch = this->inFlight.front();
+
+            // Queue Acquires For Graphics
+            this->pendingBufferAcquires.insert(this->pendingBufferAcquires.end(),
+                                               batch.bufferAcquires.begin(),
+                                               batch.bufferAcquires.end());
+            this->pendingImageAcquires.insert(this->pendingImageAcquires.end(),
+                                              batch.imageAcquires.begin(),
+                                              batch.imageAcquires.end());
+            this->pendingMipmaps.insert(this->pendingMipmaps.end(), batch.mipmaps.begin(), batch.mipmaps.end());
+
+            // Return Staging Memory And Fence
+            this->ringTail = std::max(this->ringTail, batch.ringEnd);
+            this->oversizedSize -= batch.oversizedSize;
+            this->completedTicket = batch.ticket;
+
+            vkFreeCommandBuffers(device, this->pool, 1, &batch.cmdBuffer);
+            vkResetFences(device, 1, &batch.fence);
+            this->spareFences.push_back(batch.fence);
+
+            this->inFlight.pop_front();
+        }
+    }
+}
+
+Result<void> TransferScheduler::submitBatch() {
+    if (this->recording.cmdBuffer == VK_NULL_HANDLE) {
+        return Result<void>::createError(Error::None);
+    }
+
+    vkEndCommandBuffer(this->recording.cmdBuffer);
+
+    Result<void> result = this->transferQueue->submit(this->recording.cmdBuffer,
+                                                      nullptr,
+                                                      0,
+                                                      nullptr,
+                                                      0,
+                                                      nullptr,
+                                                      this->recording.fence);
+
+    if (!result.hasError()) {
+        TransferTicket next = this->recording.ticket + 1;
+
+        this->inFlight.push_back(std::move(this->recording));
+        this->recording = TransferBatch {};
+        this->recording.ticket = next;
+    }
+
+    return result;
+}
+
+Result<void> TransferScheduler::waitOldestBatch() {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        if (vkWaitForFences(device, 1, &this->inFlight.front().fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+            return Result<void>::createError(Error::FailedToWaitForFence);
+        }
+
+        this->retireBatches();
+        return Result<void>::createError(Error::None);
+    }
+
+    return Result<void>::createError(result.getError());
+}
+
+TransferScheduler::~TransferScheduler() {
+    Result<VkDevice> result = this->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+
+        // Finish Submitted Transfers
+        while (!this->inFlight.empty()) {
+            if (this->waitOldestBatch().hasError()) {
+                break;
+            }
+        }
+
+        if (this->recording.fence != VK_NULL_HANDLE) {
+            this->spareFences.push_back(this->recording.fence);
+            this->recording.fence = VK_NULL_HANDLE;
+        }
+
+        for (auto &fence : this->spareFences) {
+            vkDestroyFence(device, fence, nullptr);
+        }
+        this->spareFences.clear();
+
+        if (this->pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, this->pool, nullptr);
+            this->pool = VK_NULL_HANDLE;
+        }
+    }
+
+    this->inFlight.clear();
+    this->recording = TransferBatch {};
+    this->ringMapping = nullptr;
+    this->ring.reset();
+    this->transferQueue.reset();
+}
+
+Result<std::shared_ptr<TransferScheduler>> TransferScheduler::createTransferScheduler(std::shared_ptr<Queue> queue,
+                                                                                     uint32 graphicsFamily,
+                                                                                     uint64 ringSize) {
+    std::shared_ptr<TransferScheduler> scheduler(new TransferScheduler);
+
+    scheduler->transferQueue = std::move(queue);
+    scheduler->graphicsFamily = graphicsFamily;
+    scheduler->ringSize = (ringSize + STAGING_RING_ALIGNMENT - 1) & ~(STAGING_RING_ALIGNMENT - 1);
+
+    Result<VkDevice> result = scheduler->getGraphicsDevice();
+
+    if (!result.hasError()) {
+        auto device = static_cast<VkDevice>(result);
+        VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+
+        // Own Pool, Batches May Be Recorded Outside Render Thread
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.pNext = nullptr;
+        commandPoolCreateInfo.queueFamilyIndex = scheduler->transferQueue->getFamily();
+        commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+        if (vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &scheduler->pool) != VK_SUCCESS) {
+            return Result<std::shared_ptr<TransferScheduler>>::createError(Error::FailedToCreateCommandPool);
+        }
+
+        Result<std::shared_ptr<Buffer>> bufferResult = Buffer::createBuffer(scheduler->ringSize,
+                                                                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                                            MemoryUsage::Upload);
+
+        if (!bufferResult.hasError()) {
+            scheduler->ring = static_cast<std::shared_ptr<Buffer>>(bufferResult);
+
+            // Keep Ring Mapped For Scheduler Lifetime
+            Result<void *> mapResult = scheduler->ring->map();
+
+            if (!mapResult.hasError()) {
+                scheduler->ringMapping = static_cast<uint8 *>(static_cast<void *>(mapResult));
+                return Result<std::shared_ptr<TransferScheduler>>(std::move(scheduler));
+            }
+            else {
+                return Result<std::shared_ptr<TransferScheduler>>::createError(mapResult.getError());
+            }
+        }
+        else {
+            return Result<std::shared_ptr<TransferScheduler>>::createError(bufferResult.getError());
+        }
+    }
+
+    return Result<std::shared_ptr<TransferScheduler>>::createError(result.getError());
+}
+
+Result<void> TransferScheduler::flush() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Result<void> result = this->submitBatch();
+
+    this->retireBatches();
+    return result;
+}
+
+uint64 TransferScheduler::getStagingSize() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->retireBatches();
+    return (this->ringHead - this->ringTail) + this->oversizedSize;
+}
+
+bool TransferScheduler::isComplete(TransferTicket ticket) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->retireBatches();
+    return ticket <= this->completedTicket;
+}
+
+void TransferScheduler::recordAcquires(VkCommandBuffer cmdBuffer) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->retireBatches();
+
+    if (!this->pendingBufferAcquires.empty() || !this->pendingImageAcquires.empty()) {
+        vkCmdPipelineBarrier(cmdBuffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             static_cast<uint32>(this->pendingBufferAcquires.size()),
+                             this->pendingBufferAcquires.data(),
+                             static_cast<uint32>(this->pendingImageAcquires.size()),
+                             this->pendingImageAcquires.data());
+
+        this->pendingBufferAcquires.clear();
+        this->pendingImageAcquires.clear();
+    }
+
+    // Transfer-Only Families Cannot Blit, So Levels Are Generated Here
+    for (auto &mipmap : this->pendingMipmaps) {
+        TransferScheduler::recordMipmaps(cmdBuffer, mipmap);
+    }
+
+    this->pendingMipmaps.clear();
+}
+
+void TransferScheduler::recordMipmaps(VkCommandBuffer cmdBuffer, const MipmapGeneration &mipmap) {
+    VkImageMemoryBarrier imageMemoryBarriers[2] = {};
+
+    for (auto &imageMemoryBarrier : imageMemoryBarriers) {
+        imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageMemoryBarrier.pNext = nullptr;
+        imageMemoryBarrier.image = mipmap.image;
+        imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageMemoryBarrier.subresourceRange.levelCount = 1;
+        imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+        imageMemoryBarrier.subresourceRange.layerCount = 1;
+    }
+
+    int32 width = static_cast<int32>(mipmap.width);
+    int32 height = static_cast<int32>(mipmap.height);
+
+    for (uint32 level = 1; level < mipmap.mipLevels; level++) {
+        int32 nextWidth = std::max(width / 2, 1);
+        int32 nextHeight = std::max(height / 2, 1);
+        VkImageBlit imageBlit = {};
+
+        // Previous Level Becomes Source, Current Level Contents Are Discarded
+        imageMemoryBarriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageMemoryBarriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        imageMemoryBarriers[0].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageMemoryBarriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        imageMemoryBarriers[0].subresourceRange.baseMipLevel = level - 1;
+
+        imageMemoryBarriers[1].srcAccessMask = 0;
+        imageMemoryBarriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageMemoryBarriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageMemoryBarriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageMemoryBarriers[1].subresourceRange.baseMipLevel = level;
+
+        // Fragment Stage Chains With Release Or Acquire That Left Levels Readable
+        vkCmdPipelineBarrier(cmdBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             2,
+                             imageMemoryBarriers);
+
+        imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBlit.srcSubresource.mipLevel = level - 1;
+        imageBlit.srcSubresource.baseArrayLayer = 0;
+        imageBlit.srcSubresource.layerCount = 1;
+        imageBlit.srcOffsets[0] = { 0, 0, 0 };
+        imageBlit.srcOffsets[1] = { width, height, 1 };
+        imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        imageBlit.dstSubresource.mipLevel = level;
+        imageBlit.dstSubresource.baseArrayLayer = 0;
+        imageBlit.dstSubresource.layerCount = 1;
+        imageBlit.dstOffsets[0] = { 0, 0, 0 };
+        imageBlit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+
+        vkCmdBlitImage(cmdBuffer,
+                       mipmap.image,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       mipmap.image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       1,
+                       &imageBlit,
+                       VK_FILTER_LINEAR);
+
+        // Return Source Level To Shaders, Current Level Is Left Readable After Its Own Blit
+        imageMemoryBarriers[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        imageMemoryBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        imageMemoryBarriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        imageMemoryBarriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        imageMemoryBarriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageMemoryBarriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        imageMemoryBarriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageMemoryBarriers[1].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        vkCmdPipelineBarrier(cmdBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             2,
+                             imageMemoryBarriers);
+
+        width = nextWidth;
+        height = nextHeight;
+    }
+}
+
+Result<TransferTicket> TransferScheduler::uploadBuffer(const Buffer &dst, uint64 off, const void *data, uint64 siz) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Result<void> batchResult = this->beginBatch();
+
+    if (!batchResult.hasError()) {
+        VkBuffer src = VK_NULL_HANDLE;
+        uint64 srcOffset = 0;
+        Result<uint8 *> result = this->reserveStaging(siz, &src, &srcOffset);
+
+        if (!result.hasError()) {
+            VkBufferCopy bufferCopy = {};
+            VkBufferMemoryBarrier bufferMemoryBarrier = {};
+            VkAccessFlags readAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                       VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+            memcpy(static_cast<uint8 *>(result), data, siz);
+
+            // Copy From Staging
+            bufferCopy.srcOffset = srcOffset;
+            bufferCopy.dstOffset = off;
+            bufferCopy.size = siz;
+
+            vkCmdCopyBuffer(this->recording.cmdBuffer,
+                            src,
+                            static_cast<VkBuffer>(dst.getVulkanBuffer()),
+                            1,
+                            &bufferCopy);
+
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferMemoryBarrier.pNext = nullptr;
+            bufferMemoryBarrier.buffer = static_cast<VkBuffer>(dst.getVulkanBuffer());
+            bufferMemoryBarrier.offset = off;
+            bufferMemoryBarrier.size = siz;
+            bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            bufferMemoryBarrier.dstAccessMask = readAccess;
+            bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+            if (this->isOwnershipTransfer()) {
+                // Release To Graphics Family, Matching Acquire Is Recorded By Renderer
+                bufferMemoryBarrier.dstAccessMask = 0;
+                bufferMemoryBarrier.srcQueueFamilyIndex = this->transferQueue->getFamily();
+                bufferMemoryBarrier.dstQueueFamilyIndex = this->graphicsFamily;
+
+                vkCmdPipelineBarrier(this->recording.cmdBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &bufferMemoryBarrier,
+                                     0,
+                                     nullptr);
+
+                bufferMemoryBarrier.srcAccessMask = 0;
+                bufferMemoryBarrier.dstAccessMask = readAccess;
+                this->recording.bufferAcquires.push_back(bufferMemoryBarrier);
+            }
+            else {
+                vkCmdPipelineBarrier(this->recording.cmdBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &bufferMemoryBarrier,
+                                     0,
+                                     nullptr);
+            }
+
+            return Result<TransferTicket>(this->recording.ticket);
+        }
+
+        return Result<TransferTicket>::createError(result.getError());
+    }
+
+    return Result<TransferTicket>::createError(batchResult.getError());
+}
+
+Result<TransferTicket> TransferScheduler::uploadImage(Image &dst,
+                                                      const void *data,
+                                                      uint64 siz,
+                                                      const VkBufferImageCopy &region) {
+    return this->uploadImage(dst, data, siz, &region, 1);
+}
+
+Result<TransferTicket> TransferScheduler::uploadImage(Image &dst,
+                                                      const void *data,
+                                                      uint64 siz,
+                                                      const VkBufferImageCopy *regions,
+                                                      uint32 regionCount,
+                                                      bool bGenerateMipmaps) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Result<void> batchResult = this->beginBatch();
+
+    if (!batchResult.hasError()) {
+        VkBuffer src = VK_NULL_HANDLE;
+        uint64 srcOffset = 0;
+        Result<uint8 *> result = this->reserveStaging(siz, &src, &srcOffset);
+
+        if (!result.hasError()) {
+            auto image = static_cast<VkImage>(dst.getVulkanImage());
+            std::vector<VkBufferImageCopy> bufferImageCopies(regions, regions + regionCount);
+            VkImageMemoryBarrier imageMemoryBarrier = {};
+
+            memcpy(static_cast<uint8 *>(result), data, siz);
+
+            // Prepare Image For Copy
+            imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            imageMemoryBarrier.pNext = nullptr;
+            imageMemoryBarrier.image = image;
+            imageMemoryBarrier.srcAccessMask = 0;
+            imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.oldLayout = static_cast<VkImageLayout>(dst.getLayout());
+            imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            imageMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+            imageMemoryBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+            imageMemoryBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+            vkCmdPipelineBarrier(this->recording.cmdBuffer,
+                                 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 1,
+                                 &imageMemoryBarrier);
+
+            for (auto &bufferImageCopy : bufferImageCopies) {
+                bufferImageCopy.bufferOffset += srcOffset;
+            }
+
+            vkCmdCopyBufferToImage(this->recording.cmdBuffer,
+                                   src,
+                                   image,
+                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   regionCount,
+                                   bufferImageCopies.data());
+
+            // Make Image Readable By Shaders
+            imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            if (this->isOwnershipTransfer()) {
+                // Release To Graphics Family, Layout Transition Must Match Acquire
+                imageMemoryBarrier.dstAccessMask = 0;
+                imageMemoryBarrier.srcQueueFamilyIndex = this->transferQueue->getFamily();
+                imageMemoryBarrier.dstQueueFamilyIndex = this->graphicsFamily;
+
+                vkCmdPipelineBarrier(this->recording.cmdBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &imageMemoryBarrier);
+
+                imageMemoryBarrier.srcAccessMask = 0;
+                imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                this->recording.imageAcquires.push_back(imageMemoryBarrier);
+            }
+            else {
+                vkCmdPipelineBarrier(this->recording.cmdBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &imageMemoryBarrier);
+            }
+
+            if (bGenerateMipmaps && dst.getMipLevels() > 1 && regionCount > 0) {
+                MipmapGeneration mipmap = {};
+
+                mipmap.image = image;
+                mipmap.width = regions[0].imageExtent.width;
+                mipmap.height = regions[0].imageExtent.height;
+                mipmap.mipLevels = dst.getMipLevels();
+
+                // Graphics Family Can Blit Right After Copy
+                if (this->isOwnershipTransfer()) {
+                    this->recording.mipmaps.push_back(mipmap);
+                }
+                else {
+                    TransferScheduler::recordMipmaps(this->recording.cmdBuffer, mipmap);
+                }
+            }
+
+            dst.setLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            return Result<TransferTicket>(this->recording.ticket);
+        }
+
+        return Result<TransferTicket>::createError(result.getError());
+    }
+
+    return Result<TransferTicket>::createError(batchResult.getError());
+}
+
+Result<void> TransferScheduler::wait(TransferTicket ticket) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (ticket >= this->recording.ticket) {
+        Result<void> result = this->submitBatch();
+
+        if (result.hasError()) {
+            return result;
+        }
+    }
+
+    this->retireBatches();
+
+    while (ticket > this->completedTicket && !this->inFlight.empty()) {
+        Result<void> result = this->waitOldestBatch();
+
+        if (result.hasError()) {
+            return result;
+        }
+    }
+
+    return Result<void>::createError(Error::None);
+}
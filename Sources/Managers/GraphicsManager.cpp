@@ -47,6 +47,8 @@ Result<void> GraphicsManager::startup() {
     VkPhysicalDeviceFeatures features = {};
     VkPhysicalDeviceLimits limits = {};
 
+    features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+
     // Allocate objects
     this->instance = std::make_shared<Instance>("Test Application", VK_MAKE_VERSION(1, 0, 0), false);
     this->device = std::make_shared<Device>(extensions, features, limits, false);
@@ -0,0 +1,225 @@
+/**
+ * JobManager.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "JobManager.h"
+
+#include <algorithm>
+#include <iostream>
+
+/* A fila pertencente à thread atual, ou -1 para as threads que não pertencem ao JobManager. */
+static thread_local int32 currentQueue = -1;
+
+JobManager::JobManager() {
+    this->workers = std::vector<std::thread>();
+    this->queues = std::vector<std::unique_ptr<JobQueue>>();
+    this->nextQueue = 0;
+    this->queuedJobs = 0;
+    this->bStopWorkers = false;
+}
+
+JobManager::~JobManager() {
+    if (!this->workers.empty()) {
+        std::cout << "WARNING: JobManager deleted without being shutdown..." << std::endl;
+        this->shutdown();
+    }
+}
+
+void JobManager::enqueue(JobHandle job) {
+    uint32 index = currentQueue >= 0 ? static_cast<uint32>(currentQueue) :
+                   this->nextQueue.fetch_add(1) % static_cast<uint32>(this->queues.size());
+
+    {
+        std::lock_guard<std::mutex> lock(this->queues[index]->mutex);
+        this->queues[index]->jobs.push_back(std::move(job));
+    }
+
+    // Wake Idle Worker
+    this->queuedJobs.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+    }
+    this->jobAvailable.notify_one();
+}
+
+void JobManager::execute(const JobHandle &job) {
+    std::vector<JobHandle> continuations;
+
+    job->work();
+
+    // Mark Finished And Collect Dependents
+    {
+        std::lock_guard<std::mutex> lock(job->continuationMutex);
+        job->bFinished.store(true);
+        continuations.swap(job->continuations);
+    }
+
+    for (auto &continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1) == 1) {
+            this->enqueue(std::move(continuation));
+        }
+    }
+}
+
+JobHandle JobManager::findJob(uint32 queueIndex) {
+    auto queueCount = static_cast<uint32>(this->queues.size());
+    JobHandle job = nullptr;
+
+    // Pop Newest Job From Own Queue
+    {
+        JobQueue &queue = *this->queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+    }
+
+    // Steal Oldest Job From Other Queues
+    for (uint32 i = 1; job == nullptr && i < queueCount; i++) {
+        JobQueue &queue = *this->queues[(queueIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+
+    if (job != nullptr) {
+        this->queuedJobs.fetch_sub(1);
+    }
+
+    return job;
+}
+
+void JobManager::runWorker(uint32 queueIndex) {
+    currentQueue = static_cast<int32>(queueIndex);
+
+    while (true) {
+        JobHandle job = this->findJob(queueIndex);
+
+        if (job != nullptr) {
+            this->execute(job);
+            continue;
+        }
+
+        // Sleep Until Work Arrives
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->jobAvailable.wait(lock, [this] {
+            return this->bStopWorkers || this->queuedJobs.load() > 0;
+        });
+
+        if (this->bStopWorkers) {
+            return;
+        }
+    }
+}
+
+void JobManager::addDependency(const JobHandle &job, const JobHandle &dependency) {
+    std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+
+    if (!dependency->bFinished.load()) {
+        job->pendingDependencies.fetch_add(1);
+        dependency->continuations.push_back(job);
+    }
+}
+
+JobHandle JobManager::createJob(std::function<void()> work) {
+    JobHandle job = std::make_shared<Job>();
+
+    job->work = std::move(work);
+    job->pendingDependencies = 1;
+    job->bFinished = false;
+
+    return job;
+}
+
+JobHandle JobManager::parallelFor(uint32 count,
+                                  uint32 grain,
+                                  std::function<void(uint32, uint32)> work,
+                                  const JobHandle &dependency) {
+    JobHandle parent = this->createJob([] {});
+    uint32 step = std::max(grain, 1u);
+
+    // Split Range Into Parts
+    for (uint32 begin = 0; begin < count; begin += step) {
+        uint32 end = std::min(count, begin + step);
+        JobHandle part = this->createJob([work, begin, end] { work(begin, end); });
+
+        if (dependency != nullptr) {
+            this->addDependency(part, dependency);
+        }
+
+        this->addDependency(parent, part);
+        this->submit(part);
+    }
+
+    this->submit(parent);
+    return parent;
+}
+
+void JobManager::submit(const JobHandle &job) {
+    if (job->pendingDependencies.fetch_sub(1) == 1) {
+        this->enqueue(job);
+    }
+}
+
+void JobManager::wait(const JobHandle &job) {
+    auto queueIndex = currentQueue >= 0 ? static_cast<uint32>(currentQueue) :
+                      static_cast<uint32>(this->queues.size() - 1);
+
+    // Help Execute Jobs While Waiting
+    while (!job->bFinished.load()) {
+        JobHandle next = this->findJob(queueIndex);
+
+        if (next != nullptr) {
+            this->execute(next);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+Result<void> JobManager::startup() {
+    std::cout << "Starting Up JobManager..." << std::endl;
+
+    uint32 workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    // Create One Queue Per Worker And One For External Threads
+    this->bStopWorkers = false;
+    for (uint32 i = 0; i < workerCount + 1; i++) {
+        this->queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    for (uint32 i = 0; i < workerCount; i++) {
+        this->workers.emplace_back(&JobManager::runWorker, this, i);
+    }
+
+    return Result<void>::createError(Error::None);
+}
+
+void JobManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->bStopWorkers = true;
+    }
+
+    this->jobAvailable.notify_all();
+    for (auto &worker : this->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    this->workers.clear();
+    this->queues.clear();
+    this->queuedJobs = 0;
+
+    std::cout << "Shutting Down JobManager..." << std::endl;
+}
@@ -8,15 +8,30 @@
 #include "Allocator.h"
 #include "Device.h"
 #include "GraphicsManager.h"
+#include "LinearAllocator.h"
+#include "Memory.h"
 #include "MemoryManager.h"
 #include "PoolAllocator.h"
+#include "TlsfAllocator.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vulkan/vulkan.hpp>
 
 MemoryManager::MemoryManager() {
-    this->allocatorList = std::forward_list<std::shared_ptr<PoolAllocator>>();
+    this->allocatorIdleTime = DEFAULT_ALLOCATOR_IDLE_TIME;
+    this->blockAllocatorList = std::forward_list<std::shared_ptr<TlsfAllocator>>();
+    this->bufferImageGranularity = 1;
+    this->evacuatedAllocator = nullptr;
+    this->linearAllocators = std::vector<std::weak_ptr<LinearAllocator>>();
+    this->heapBudgets = std::vector<uint64>();
+    this->heapUsages = std::vector<uint64>();
+    this->heapPeaks = std::vector<uint64>();
     this->memoryProperties = std::make_unique<VkPhysicalDeviceMemoryProperties>();
+    this->nonCoherentAtomSize = 1;
+    this->poolAllocators = std::unordered_map<PoolKey, std::shared_ptr<PoolAllocator>, PoolKeyHash>();
 }
 
 MemoryManager::~MemoryManager() {
@@ -26,6 +41,39 @@ MemoryManager::~MemoryManager() {
     }
 }
 
+void MemoryManager::addHeapUsage(uint32 heapIndex, uint64 siz) noexcept {
+    if (heapIndex < this->heapUsages.size()) {
+        this->heapUsages[heapIndex] += siz;
+        this->heapPeaks[heapIndex] = std::max(this->heapPeaks[heapIndex], this->heapUsages[heapIndex]);
+    }
+}
+
+Result<void> MemoryManager::checkHeapBudget(uint32 memoryType, uint64 siz) noexcept {
+    uint32 heapIndex = this->getHeapIndex(memoryType);
+
+    if (heapIndex >= this->heapBudgets.size()) {
+        return Result<void>::createError(Error::MemoryManagerNotStartedUp);
+    }
+
+    // Evict Empty Allocators Of This Heap Before Giving Up
+    if (this->heapUsages[heapIndex] + siz > this->heapBudgets[heapIndex]) {
+        this->releaseAllocators(std::chrono::steady_clock::now(), heapIndex);
+    }
+
+    if (this->heapUsages[heapIndex] + siz > this->heapBudgets[heapIndex]) {
+        return Result<void>::createError(Error::DeviceMemoryBudgetExceeded);
+    }
+
+    return Result<void>::createError(Error::None);
+}
+
+uint32 MemoryManager::getHeapIndex(uint32 memoryType) const noexcept {
+    if (this->memoryProperties != nullptr && memoryType < this->memoryProperties->memoryTypeCount)
+        return this->memoryProperties->memoryTypes[memoryType].heapIndex;
+    else
+        return ALL_MEMORY_HEAPS;
+}
+
 Result<VkPhysicalDevice> MemoryManager::getPhysicalDevice() const noexcept {
     GraphicsManager &graphicsManager = GraphicsManager::getManager();
     Result<std::weak_ptr<const Device>> result = graphicsManager.getGraphicsDevice();
@@ -48,13 +96,285 @@ Result<void> MemoryManager::getPhysicalDeviceMemoryProperties() noexcept {
     if (!result.hasError()) {
         auto physicalDevice = static_cast<VkPhysicalDevice>(result);
 
+        VkPhysicalDeviceProperties physicalDeviceProperties = {};
+
         vkGetPhysicalDeviceMemoryProperties(physicalDevice, this->memoryProperties.get());
+        vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+        this->nonCoherentAtomSize = physicalDeviceProperties.limits.nonCoherentAtomSize;
+        this->bufferImageGranularity = physicalDeviceProperties.limits.bufferImageGranularity;
+
+        // Budget A Fraction Of Every Heap
+        this->heapBudgets.resize(this->memoryProperties->memoryHeapCount);
+        this->heapUsages.assign(this->memoryProperties->memoryHeapCount, 0);
+        this->heapPeaks.assign(this->memoryProperties->memoryHeapCount, 0);
+
+        for (uint32 i = 0; i < this->memoryProperties->memoryHeapCount; i++) {
+            auto heapSize = static_cast<real64>(this->memoryProperties->memoryHeaps[i].size);
+            this->heapBudgets[i] = static_cast<uint64>(heapSize * DEFAULT_HEAP_BUDGET_FRACTION);
+        }
+
         return Result<void>::createError(Error::None);
     }
 
     return Result<void>::createError(result.getError());
 }
 
+void MemoryManager::releaseAllocators(std::chrono::steady_clock::time_point idleSince, uint32 heapIndex) noexcept {
+    auto release = [this, idleSince, heapIndex](const auto &alloc) {
+        uint32 index = this->getHeapIndex(alloc->getAllocatorHeap());
+
+        if (heapIndex != ALL_MEMORY_HEAPS && heapIndex != index) {
+            return false;
+        }
+
+        // Only The Manager Holds It, So No Resource Can Own A Region Of The Block
+        if (alloc.use_count() == 1 && alloc->getUsedSize() == 0 && alloc->getLastUseTime() <= idleSince) {
+            std::cout << "Releasing Idle Allocator: " << alloc->getAllocatorSize() << " Bytes" << std::endl;
+
+            if (static_cast<const Allocator *>(alloc.get()) == this->evacuatedAllocator)
+                this->evacuatedAllocator = nullptr;
+
+            if (index < this->heapUsages.size())
+                this->heapUsages[index] -= alloc->getAllocatorSize();
+            return true;
+        }
+
+        return false;
+    };
+
+    this->blockAllocatorList.remove_if(release);
+
+    for (auto it = this->poolAllocators.begin(); it != this->poolAllocators.end();) {
+        if (release(it->second))
+            it = this->poolAllocators.erase(it);
+        else
+            ++it;
+    }
+}
+
+void MemoryManager::collectIdleAllocators() noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto idleTime = std::chrono::duration<real64>(this->allocatorIdleTime);
+    auto idleSince = std::chrono::steady_clock::now() -
+                     std::chrono::duration_cast<std::chrono::steady_clock::duration>(idleTime);
+
+    this->releaseAllocators(idleSince, ALL_MEMORY_HEAPS);
+}
+
+std::shared_ptr<TlsfAllocator> MemoryManager::findSparseAllocator(real64 threshold,
+                                                                 const TlsfAllocator *exclude) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::shared_ptr<TlsfAllocator> sparsest = nullptr;
+    real64 sparsestUsage = threshold;
+
+    for (auto &alloc : this->blockAllocatorList) {
+        real64 usage = static_cast<real64>(alloc->getUsedSize()) / alloc->getAllocatorSize();
+
+        if (alloc.get() == exclude || alloc->getUsedSize() == 0 || usage >= sparsestUsage) {
+            continue;
+        }
+
+        // Host Visible Blocks Hold Mapped Buffers, Which Cannot Be Moved
+        uint32 propertyFlags = this->memoryProperties->memoryTypes[alloc->getAllocatorHeap()].propertyFlags;
+        if ((propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0) {
+            continue;
+        }
+
+        // Other Blocks Of The Same Type Must Have Room For Everything It Holds
+        uint64 freeSize = 0;
+        for (auto &other : this->blockAllocatorList) {
+            if (other != alloc && other->getAllocatorHeap() == alloc->getAllocatorHeap() &&
+                other->getUsedSize() >= alloc->getUsedSize()) {
+                freeSize += other->getAllocatorSize() - other->getUsedSize();
+            }
+        }
+
+        if (freeSize >= alloc->getUsedSize()) {
+            sparsest = alloc;
+            sparsestUsage = usage;
+        }
+    }
+
+    return sparsest;
+}
+
+Result<void> MemoryManager::dumpStats(const utf8 *filename) {
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) {
+        return Result<void>::createError(Error::FailedToOpenStatsFile);
+    }
+
+    file << this->getStatsJson() << std::endl;
+    return Result<void>::createError(Error::None);
+}
+
+MemoryStats MemoryManager::getStats() noexcept {
+    // Declared Before Lock, So A Last Reference Is Dropped Only After Unlocking
+    std::vector<std::shared_ptr<LinearAllocator>> linear;
+    std::vector<std::shared_ptr<PoolAllocator>> pools;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    MemoryStats stats = {};
+
+    if (this->memoryProperties == nullptr) {
+        return stats;
+    }
+
+    stats.heaps.resize(this->memoryProperties->memoryHeapCount, HeapStats {});
+    stats.memoryTypes.resize(this->memoryProperties->memoryTypeCount, MemoryTypeStats {});
+
+    for (uint32 i = 0; i < this->memoryProperties->memoryHeapCount; i++) {
+        stats.heaps[i].heapSize = this->memoryProperties->memoryHeaps[i].size;
+        stats.heaps[i].budget = this->getHeapBudget(i);
+        stats.heaps[i].reservedSize = this->getHeapUsage(i);
+        stats.heaps[i].peakReservedSize = i < this->heapPeaks.size() ? this->heapPeaks[i] : 0;
+    }
+
+    for (uint32 i = 0; i < this->memoryProperties->memoryTypeCount; i++) {
+        stats.memoryTypes[i].heapIndex = this->memoryProperties->memoryTypes[i].heapIndex;
+        stats.memoryTypes[i].propertyFlags = this->memoryProperties->memoryTypes[i].propertyFlags;
+    }
+
+    // Roll Each Allocator Up Into Its Memory Type And Heap
+    auto collect = [this, &stats](const utf8 *kind, uint32 memoryType, Allocator &alloc) {
+        AllocatorStats allocatorStats = {};
+
+        allocatorStats.kind = kind;
+        allocatorStats.memoryType = memoryType;
+        allocatorStats.blockCount = alloc.getBlockCount();
+        allocatorStats.reservedSize = alloc.getAllocatorSize();
+        allocatorStats.usedSize = alloc.getUsedSize();
+        allocatorStats.peakUsedSize = alloc.getPeakUsedSize();
+        allocatorStats.allocationCount = alloc.getAllocationCount();
+        allocatorStats.totalAllocationCount = alloc.getTotalAllocationCount();
+
+        if (memoryType < stats.memoryTypes.size()) {
+            MemoryTypeStats &typeStats = stats.memoryTypes[memoryType];
+
+            typeStats.blockCount += allocatorStats.blockCount;
+            typeStats.reservedSize += allocatorStats.reservedSize;
+            typeStats.usedSize += allocatorStats.usedSize;
+            typeStats.allocationCount += allocatorStats.allocationCount;
+
+            uint32 heapIndex = this->getHeapIndex(memoryType);
+            if (heapIndex < stats.heaps.size()) {
+                stats.heaps[heapIndex].blockCount += allocatorStats.blockCount;
+                stats.heaps[heapIndex].usedSize += allocatorStats.usedSize;
+                stats.heaps[heapIndex].allocationCount += allocatorStats.allocationCount;
+            }
+        }
+
+        stats.allocators.push_back(allocatorStats);
+        return &stats.allocators.back();
+    };
+
+    for (auto &alloc : this->blockAllocatorList) {
+        collect("tlsf", alloc->getAllocatorHeap(), *alloc);
+    }
+
+    // Forget Linear Allocators Their Owners Destroyed
+    this->linearAllocators.erase(std::remove_if(this->linearAllocators.begin(), this->linearAllocators.end(),
+                                                [](const std::weak_ptr<LinearAllocator> &alloc) {
+                                                    return alloc.expired();
+                                                }),
+                                 this->linearAllocators.end());
+
+    for (auto &weak : this->linearAllocators) {
+        if (std::shared_ptr<LinearAllocator> alloc = weak.lock()) {
+            collect("linear", alloc->getAllocatorHeap(), *alloc);
+            linear.push_back(std::move(alloc));
+        }
+    }
+
+    pools.reserve(this->poolAllocators.size());
+    for (auto &entry : this->poolAllocators) {
+        pools.push_back(entry.second);
+    }
+
+    // Pools Reserve Heap Space While Holding Their Own Lock, So They Are Queried Only After Unlocking
+    lock.unlock();
+
+    for (auto &pool : pools) {
+        AllocatorStats *poolStats = collect("pool", pool->getAllocatorHeap(), *pool);
+
+        poolStats->chunkSize = pool->getAllocatorChunkSize();
+        poolStats->chunkCount = pool->getChunkCount();
+        poolStats->usedChunks = poolStats->usedSize / std::max<uint64>(poolStats->chunkSize, 1);
+    }
+
+    return stats;
+}
+
+std::string MemoryManager::getStatsJson() noexcept {
+    MemoryStats stats = this->getStats();
+    std::ostringstream json;
+
+    json << "{\n  \"heaps\": [";
+    for (size_t i = 0; i < stats.heaps.size(); i++) {
+        const HeapStats &heap = stats.heaps[i];
+
+        json << (i > 0 ? "," : "") << "\n    { \"index\": " << i
+             << ", \"size\": " << heap.heapSize
+             << ", \"budget\": " << heap.budget
+             << ", \"blocks\": " << heap.blockCount
+             << ", \"reserved\": " << heap.reservedSize
+             << ", \"peakReserved\": " << heap.peakReservedSize
+             << ", \"used\": " << heap.usedSize
+             << ", \"unused\": " << heap.reservedSize - std::min(heap.usedSize, heap.reservedSize)
+             << ", \"allocations\": " << heap.allocationCount << " }";
+    }
+
+    json << "\n  ],\n  \"memoryTypes\": [";
+    for (size_t i = 0; i < stats.memoryTypes.size(); i++) {
+        const MemoryTypeStats &type = stats.memoryTypes[i];
+
+        json << (i > 0 ? "," : "") << "\n    { \"index\": " << i
+             << ", \"heap\": " << type.heapIndex
+             << ", \"flags\": " << type.propertyFlags
+             << ", \"blocks\": " << type.blockCount
+             << ", \"reserved\": " << type.reservedSize
+             << ", \"used\": " << type.usedSize
+             << ", \"allocations\": " << type.allocationCount << " }";
+    }
+
+    json << "\n  ],\n  \"allocators\": [";
+    for (size_t i = 0; i < stats.allocators.size(); i++) {
+        const AllocatorStats &alloc = stats.allocators[i];
+
+        json << (i > 0 ? "," : "") << "\n    { \"kind\": \"" << alloc.kind << "\""
+             << ", \"memoryType\": " << alloc.memoryType
+             << ", \"blocks\": " << alloc.blockCount
+             << ", \"reserved\": " << alloc.reservedSize
+             << ", \"used\": " << alloc.usedSize
+             << ", \"peakUsed\": " << alloc.peakUsedSize
+             << ", \"allocations\": " << alloc.allocationCount
+             << ", \"totalAllocations\": " << alloc.totalAllocationCount;
+
+        if (alloc.chunkSize != 0) {
+            json << ", \"chunkSize\": " << alloc.chunkSize
+                 << ", \"chunks\": " << alloc.chunkCount
+                 << ", \"usedChunks\": " << alloc.usedChunks
+                 << ", \"chunkUtilization\": "
+                 << (alloc.chunkCount != 0 ? static_cast<real64>(alloc.usedChunks) / alloc.chunkCount : 0.0);
+        }
+
+        json << " }";
+    }
+
+    json << "\n  ]\n}";
+    return json.str();
+}
+
+uint64 MemoryManager::getHeapBudget(uint32 heapIndex) const noexcept {
+    return heapIndex < this->heapBudgets.size() ? this->heapBudgets[heapIndex] : 0;
+}
+
+uint64 MemoryManager::getHeapUsage(uint32 heapIndex) const noexcept {
+    return heapIndex < this->heapUsages.size() ? this->heapUsages[heapIndex] : 0;
+}
+
 Result<VkPhysicalDeviceMemoryProperties> MemoryManager::getMemoryProperties() const noexcept {
     if (this->memoryProperties != nullptr)
         return Result<VkPhysicalDeviceMemoryProperties>(*this->memoryProperties);
@@ -62,35 +382,257 @@ Result<VkPhysicalDeviceMemoryProperties> MemoryManager::getMemoryProperties() co
         return Result<VkPhysicalDeviceMemoryProperties>::createError(Error::MemoryManagerNotStartedUp);
 }
 
+Result<Memory> MemoryManager::allocateFromBlocks(uint64 siz,
+                                                uint64 alignment,
+                                                uint32 memoryTypeBits,
+                                                uint32 flags,
+                                                std::shared_ptr<TlsfAllocator> *allocator) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    VkMemoryRequirements memoryRequirements = {};
+
+    memoryRequirements.size = siz;
+    memoryRequirements.alignment = alignment;
+    memoryRequirements.memoryTypeBits = memoryTypeBits;
+
+    Result<uint32> result = Memory::chooseHeapFromFlags(memoryRequirements, flags);
+    if (result.hasError()) {
+        return Result<Memory>::createError(result.getError());
+    }
+
+    auto heap = static_cast<uint32>(result);
+
+    // Reuse Any Block Of The Same Memory Type With Room, Except One Being Emptied
+    for (auto &alloc : this->blockAllocatorList) {
+        if (alloc.get() == this->evacuatedAllocator || alloc->getAllocatorHeap() != heap) {
+            continue;
+        }
+
+        // Allocation Itself Is The Check, Failed Blocks Fall Through To The Next
+        Result<Memory> memory = alloc->allocate(siz, alignment);
+        if (!memory.hasError()) {
+            *allocator = alloc;
+            return memory;
+        }
+    }
+
+    // Buffers And Optimal Images May Share Blocks, Keep Them Apart By The Device Granularity
+    uint64 requiredSize = siz + std::max(alignment, this->bufferImageGranularity);
+    uint64 blockSize = std::max(DEFAULT_DEVICE_BLOCK_SIZE, requiredSize);
+
+    // Shrink The Block To The Request When A Full Block Exceeds The Budget
+    Result<void> budget = this->checkHeapBudget(heap, blockSize);
+    if (budget.hasError() && blockSize > requiredSize) {
+        blockSize = requiredSize;
+        budget = this->checkHeapBudget(heap, blockSize);
+    }
+
+    if (budget.hasError()) {
+        return Result<Memory>::createError(budget.getError());
+    }
+
+    Result<std::shared_ptr<TlsfAllocator>> rslt =
+            TlsfAllocator::createAllocator(blockSize, this->bufferImageGranularity, heap, flags);
+
+    if (!rslt.hasError()) {
+        auto alloc = static_cast<std::shared_ptr<TlsfAllocator>>(rslt);
+
+        this->addHeapUsage(this->getHeapIndex(heap), alloc->getAllocatorSize());
+        this->blockAllocatorList.push_front(alloc);
+
+        Result<Memory> memory = alloc->allocate(siz, alignment);
+        if (!memory.hasError()) {
+            *allocator = alloc;
+        }
+
+        return memory;
+    }
+
+    return Result<Memory>::createError(rslt.getError());
+}
+
+Result<Memory> MemoryManager::allocateMemory(uint64 siz,
+                                             uint64 alignment,
+                                             uint32 memoryTypeBits,
+                                             uint32 flags,
+                                             std::shared_ptr<Allocator> *allocator) noexcept {
+    if (siz <= MAX_POOL_CHUNK_SIZE && alignment <= MAX_POOL_CHUNK_SIZE) {
+        // Power Of Two Chunks Are Aligned To Their Size, And Never Share A Granularity Page With Another Resource
+        uint64 chunkSize = std::max<uint64>(this->bufferImageGranularity, 1);
+        while (chunkSize < siz || chunkSize < alignment) {
+            chunkSize <<= 1;
+        }
+
+        Result<std::shared_ptr<PoolAllocator>> result =
+                this->requestPoolAllocator(chunkSize, chunkSize, memoryTypeBits, flags);
+
+        if (!result.hasError()) {
+            auto pool = static_cast<std::shared_ptr<PoolAllocator>>(result);
+            Result<Memory> memory = pool->allocate(siz);
+
+            if (!memory.hasError()) {
+                *allocator = std::move(pool);
+                return memory;
+            }
+        }
+    }
+
+    std::shared_ptr<TlsfAllocator> block = nullptr;
+    Result<Memory> memory = this->allocateFromBlocks(siz, alignment, memoryTypeBits, flags, &block);
+
+    if (!memory.hasError()) {
+        *allocator = std::move(block);
+    }
+
+    return memory;
+}
+
 Result<std::shared_ptr<PoolAllocator>> MemoryManager::requestPoolAllocator(uint64 alignment,
                                                                            uint64 chunkSize,
+                                                                           uint32 memoryTypeBits,
                                                                            uint32 flags) noexcept {
-    for (auto &alloc : allocatorList) {
-        if (alloc->getAllocatorAlignment() == alignment &&
-            alloc->getAllocatorChunkSize() == chunkSize &&
-            alloc->getAllocatorFlags() == flags &&
-            alloc->hasMemory()) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    VkMemoryRequirements memoryRequirements = {};
 
-            return Result<std::shared_ptr<PoolAllocator>>(alloc);
-        }
+    memoryRequirements.size = chunkSize * DEFAULT_POOL_CHUNK_COUNT;
+    memoryRequirements.alignment = alignment;
+    memoryRequirements.memoryTypeBits = memoryTypeBits;
+
+    // Choose Type Before Any Block Exists, So No Pool Is Created For A Type The Resource Rejects
+    Result<uint32> type = Memory::chooseHeapFromFlags(memoryRequirements, flags);
+    if (type.hasError()) {
+        return Result<std::shared_ptr<PoolAllocator>>::createError(type.getError());
+    }
+
+    PoolKey key = { alignment, chunkSize, flags, static_cast<uint32>(type) };
+
+    auto it = this->poolAllocators.find(key);
+    if (it != this->poolAllocators.end()) {
+        return Result<std::shared_ptr<PoolAllocator>>(it->second);
+    }
+
+    Result<void> budget = this->checkHeapBudget(static_cast<uint32>(type), memoryRequirements.size);
+    if (budget.hasError()) {
+        return Result<std::shared_ptr<PoolAllocator>>::createError(budget.getError());
     }
 
     Result<std::shared_ptr<PoolAllocator>> result =
-            PoolAllocator::createAllocator(chunkSize * 100,
+            PoolAllocator::createAllocator(memoryRequirements.size,
                                            chunkSize,
                                            alignment,
+                                           1u << static_cast<uint32>(type),
                                            flags);
 
     if (!result.hasError()) {
         auto alloc = static_cast<std::shared_ptr<PoolAllocator>>(result);
 
-        this->allocatorList.push_front(alloc);
+        this->addHeapUsage(this->getHeapIndex(alloc->getAllocatorHeap()), alloc->getAllocatorSize());
+        this->poolAllocators.emplace(key, alloc);
         return Result<std::shared_ptr<PoolAllocator>>(alloc);
     }
 
     return Result<std::shared_ptr<PoolAllocator>>::createError(result.getError());
 }
 
+void MemoryManager::releaseHeapSpace(uint32 memoryType, uint64 siz) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    uint32 heapIndex = this->getHeapIndex(memoryType);
+
+    if (heapIndex < this->heapUsages.size()) {
+        this->heapUsages[heapIndex] -= std::min(siz, this->heapUsages[heapIndex]);
+    }
+}
+
+Result<std::shared_ptr<LinearAllocator>> MemoryManager::requestLinearAllocator(uint64 frameSize,
+                                                                              uint32 frameCount,
+                                                                              uint32 usage,
+                                                                              uint32 flags) noexcept {
+    // Created Outside Lock, Allocator Reserves Its Own Heap Space
+    Result<std::shared_ptr<LinearAllocator>> result =
+            LinearAllocator::createAllocator(frameSize, frameCount, usage, flags);
+
+    if (!result.hasError()) {
+        auto alloc = static_cast<std::shared_ptr<LinearAllocator>>(result);
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->linearAllocators.push_back(alloc);
+        return Result<std::shared_ptr<LinearAllocator>>(alloc);
+    }
+
+    return Result<std::shared_ptr<LinearAllocator>>::createError(result.getError());
+}
+
+bool MemoryManager::releaseEvacuatedAllocator() noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    bool released = false;
+
+    // Free The Emptied Block Right Away Instead Of Waiting For It To Idle
+    this->blockAllocatorList.remove_if([this, &released](const auto &alloc) {
+        if (alloc.get() != this->evacuatedAllocator || alloc.use_count() != 1 || alloc->getUsedSize() != 0) {
+            return false;
+        }
+
+        std::cout << "Releasing Evacuated Allocator: " << alloc->getAllocatorSize() << " Bytes" << std::endl;
+
+        uint32 index = this->getHeapIndex(alloc->getAllocatorHeap());
+        if (index < this->heapUsages.size())
+            this->heapUsages[index] -= alloc->getAllocatorSize();
+
+        released = true;
+        return true;
+    });
+
+    if (released) {
+        this->evacuatedAllocator = nullptr;
+    }
+
+    return released;
+}
+
+Result<std::shared_ptr<TlsfAllocator>> MemoryManager::requestRelocationTarget(uint64 siz,
+                                                                              uint64 alignment,
+                                                                              const TlsfAllocator &source) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Only Denser Blocks, So Resources Never Bounce Between Sparse Ones
+    for (auto &alloc : this->blockAllocatorList) {
+        if (alloc.get() != &source && alloc->getAllocatorHeap() == source.getAllocatorHeap() &&
+            alloc->getUsedSize() >= source.getUsedSize() && alloc->canAllocate(siz, alignment)) {
+            return Result<std::shared_ptr<TlsfAllocator>>(alloc);
+        }
+    }
+
+    return Result<std::shared_ptr<TlsfAllocator>>::createError(Error::NoMemoryAvailableInAllocator);
+}
+
+Result<void> MemoryManager::reserveHeapSpace(uint32 memoryType, uint64 siz) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    Result<void> result = this->checkHeapBudget(memoryType, siz);
+    if (!result.hasError()) {
+        this->addHeapUsage(this->getHeapIndex(memoryType), siz);
+    }
+
+    return result;
+}
+
+void MemoryManager::setAllocatorIdleTime(real64 seconds) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->allocatorIdleTime = seconds;
+}
+
+void MemoryManager::setEvacuatedAllocator(const TlsfAllocator *alloc) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->evacuatedAllocator = alloc;
+}
+
+void MemoryManager::setHeapBudget(uint32 heapIndex, uint64 budget) noexcept {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (heapIndex < this->heapBudgets.size()) {
+        this->heapBudgets[heapIndex] = budget;
+    }
+}
+
 Result<void> MemoryManager::startup() {
     std::cout << "Starting Up MemoryManager..." << std::endl;
 
@@ -103,8 +645,16 @@ Result<void> MemoryManager::startup() {
 }
 
 void MemoryManager::shutdown() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
     // Clear objects
-    this->allocatorList.clear();
+    this->poolAllocators.clear();
+    this->blockAllocatorList.clear();
+    this->evacuatedAllocator = nullptr;
+    this->linearAllocators.clear();
+    this->heapBudgets.clear();
+    this->heapUsages.clear();
+    this->heapPeaks.clear();
     this->memoryProperties.reset();
 
     std::cout << "Shutting Down MemoryManager..." << std::endl;
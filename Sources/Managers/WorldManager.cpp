@@ -8,28 +8,37 @@
 #include "Device.h"
 #include "Game.h"
 #include "GraphicsManager.h"
+#include "JobManager.h"
+#include "MemoryManager.h"
 #include "Renderer.h"
 #include "SpriteComponent.h"
+#include "SpriteStorage.h"
 #include "Texture.h"
 #include "Window.h"
 #include "WindowManager.h"
 #include "WorldManager.h"
 
+#include <chrono>
 #include <iostream>
 #include <vulkan/vulkan.h>
 
+const uint32 SPRITE_UPDATE_GRAIN = 1024;
+
 WorldManager::WorldManager() {
     this->components = {};
     this->renderer = nullptr;
+    this->spriteStorage = nullptr;
+    this->averageFrameTime = 0.0;
 }
 
 WorldManager::~WorldManager() {
+    this->components.clear();
     this->renderer.reset();
+    this->spriteStorage.reset();
 }
 
 void WorldManager::addObject(std::shared_ptr<SpriteComponent> object) noexcept {
-    this->renderer->addObject(object);
-    this->components.emplace_front(object);
+    this->components.push_back(std::move(object));
 }
 
 Result<VkDevice> WorldManager::getGraphicsDevice() const noexcept {
@@ -57,12 +66,23 @@ Result<std::shared_ptr<Renderer>> WorldManager::getRenderer() const noexcept {
     }
 }
 
+Result<std::shared_ptr<SpriteStorage>> WorldManager::getSpriteStorage() const noexcept {
+    if (this->spriteStorage != nullptr) {
+        return Result<std::shared_ptr<SpriteStorage>>(this->spriteStorage);
+    }
+    else {
+        return Result<std::shared_ptr<SpriteStorage>>::createError(Error::WorldManagerNotStartedUp);
+    }
+}
+
 Result<void> WorldManager::play(Game *game) {
     WindowManager &windowManager = WindowManager::getManager();
     Result<std::shared_ptr<Window>> result = windowManager.getWindow();
 
     if (!result.hasError()) {
         auto window = static_cast<std::shared_ptr<Window>>(result);
+        JobManager &jobManager = JobManager::getManager();
+        MemoryManager &memoryManager = MemoryManager::getManager();
 
         game->begin();
         renderer->load();
@@ -71,19 +91,51 @@ Result<void> WorldManager::play(Game *game) {
             spr->begin();
         }
 
+#ifdef REALENGINE_MEASURE_FRAME_TIME
+        std::chrono::duration<real64, std::milli> frameTime(0.0);
+        uint32 frameCount = 0;
+#endif
+
         while (!window->shouldClose()) {
+#ifdef REALENGINE_MEASURE_FRAME_TIME
+            auto frameStart = std::chrono::high_resolution_clock::now();
+#endif
             game->update();
 
-            for (auto &spr: components) {
-                spr->update();
-            }
+            // Update Sprites In Parallel
+            JobHandle spriteUpdate = jobManager.parallelFor(static_cast<uint32>(this->components.size()),
+                                                            SPRITE_UPDATE_GRAIN,
+                                                            [this](uint32 begin, uint32 end) {
+                for (uint32 i = begin; i < end; i++) {
+                    this->components[i]->update();
+                }
+            });
 
-            // Render Loop
+            // Render Loop, Frame Acquire Overlaps Sprite Updates
             this->renderer->begin();
-            this->renderer->draw();
+            jobManager.wait(spriteUpdate);
+            Result<void> drawResult = this->renderer->draw();
             this->renderer->end();
 
+            if (drawResult.hasError()) {
+                return drawResult;
+            }
+
+            // Return Blocks Of Allocators Left Empty To The Device
+            memoryManager.collectIdleAllocators();
+
             window->pollEvents();
+
+#ifdef REALENGINE_MEASURE_FRAME_TIME
+            // Publish Average Frame Time
+            frameTime += std::chrono::high_resolution_clock::now() - frameStart;
+            if (++frameCount == FRAME_TIME_SAMPLES) {
+                this->averageFrameTime = frameTime.count() / frameCount;
+
+                frameTime = std::chrono::duration<real64, std::milli>(0.0);
+                frameCount = 0;
+            }
+#endif
         }
     }
 
@@ -93,7 +145,14 @@ Result<void> WorldManager::play(Game *game) {
 Result<void> WorldManager::startup() {
     std::cout << "Starting Up WorldManager..." << std::endl;
 
-    this->renderer = std::make_shared<Renderer>();
+    Result<std::shared_ptr<SpriteStorage>> storageResult = SpriteStorage::createSpriteStorage();
+    if (storageResult.hasError()) {
+        std::cout << "Failed To Start Up WorldManager - SpriteStorage..." << std::endl;
+        return Result<void>::createError(storageResult.getError());
+    }
+
+    this->spriteStorage = static_cast<std::shared_ptr<SpriteStorage>>(storageResult);
+    this->renderer = std::make_shared<Renderer>(this->spriteStorage);
 
     Result<void> rendererResult = this->renderer->startup();
     if (rendererResult.hasError()) {
@@ -109,6 +168,8 @@ void WorldManager::shutdown() {
         this->renderer->shutdown();
     }
 
+    this->components.clear();
     this->renderer.reset();
+    this->spriteStorage.reset();
     std::cout << "Shutting Down WorldManager..." << std::endl;
 }
@@ -0,0 +1,43 @@
+/**
+ * TextureCooker.cpp
+ *
+ * Todos os direitos reservados.
+ *
+ */
+
+#include "Texture.h"
+#include "TextureFile.h"
+
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char **argv) {
+    bool bMipmaps = true;
+
+    if (argc < 3 || argc > 4 || (argc == 4 && strcmp(argv[3], "--no-mips") != 0)) {
+        std::cout << "Usage: TextureCooker <input image> <output" << TEXTURE_FILE_EXTENSION << "> [--no-mips]"
+                  << std::endl;
+        return 1;
+    }
+
+    if (argc == 4) {
+        bMipmaps = false;
+    }
+
+    // Decode Once Offline
+    Result<RawImageInfo> result = Texture::loadImage(argv[1]);
+    if (result.hasError()) {
+        std::cout << "ERROR: Failed to decode " << argv[1] << "..." << std::endl;
+        return 1;
+    }
+
+    auto image = static_cast<RawImageInfo>(result);
+    if (cookTexture(image, argv[2], bMipmaps).hasError()) {
+        std::cout << "ERROR: Failed to write " << argv[2] << "..." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Cooked " << argv[1] << " (" << image.width << "x" << image.height << ") into " << argv[2]
+              << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -8,7 +8,7 @@
 #include "Game.h"
 #include "Renderer.h"
 #include "SpriteComponent.h"
-#include "Texture.h"
+#include "TextureAtlas.h"
 #include "WorldManager.h"
 
 #include <iostream>
@@ -19,40 +19,24 @@ public:
     void begin() override {
         WorldManager &worldManager = WorldManager::getManager();
 
-        // Create Textures
-        std::shared_ptr<Texture> blueTexture = Texture::createTextureFromFile("blue.png").unwrap();
-        std::shared_ptr<Texture> gohaTexture = Texture::createTextureFromFile("gohan.png").unwrap();
-        std::shared_ptr<Texture> gokuTexture = Texture::createTextureFromFile("goku.png").unwrap();
-        std::shared_ptr<Texture> vegeTexture = Texture::createTextureFromFile("vegeta.png").unwrap();
+        // Decode Images In Parallel And Pack Into Shared Atlas
+        std::shared_ptr<TextureAtlas> atlas = TextureAtlas::createTextureAtlas().unwrap();
+        std::vector<AtlasRegion> regions =
+                atlas->addImages({ "blue.png", "gohan.png", "goku.png", "vegeta.png" }).unwrap();
 
-        // Load Textures
-        blueTexture->load();
-        gohaTexture->load();
-        gokuTexture->load();
-        vegeTexture->load();
+        // Load Atlas Pages
+        atlas->load();
 
         // Create Sprites
         for (uint32 i = 0; i < 10000; ++i) {
-            std::shared_ptr<SpriteComponent> sprite = nullptr;
             glm::vec2 pos = glm::vec2(rand()%25600/100.0f-rand()%25600/100.0f,
                                       rand()%25600/100.0f-rand()%25600/100.0f);
             glm::quat rot = glm::angleAxis(glm::radians(rand()%18000/100.0f),
                                            glm::vec3(0.0f,0.0f,1.0f));
             glm::vec2 scl = glm::vec2(2.0f, 2.0f);
 
-            int r = rand() % 4;
-            if (r == 0) {
-                sprite = SpriteComponent::createSpriteComponent(pos, rot, scl, blueTexture).unwrap();
-            }
-            else if (r == 1) {
-                sprite = SpriteComponent::createSpriteComponent(pos, rot, scl, gohaTexture).unwrap();
-            }
-            else if (r == 2) {
-                sprite = SpriteComponent::createSpriteComponent(pos, rot, scl, gokuTexture).unwrap();
-            }
-            else {
-                sprite = SpriteComponent::createSpriteComponent(pos, rot, scl, vegeTexture).unwrap();
-            }
+            std::shared_ptr<SpriteComponent> sprite =
+                    SpriteComponent::createSpriteComponent(pos, rot, scl, regions[rand() % 4]).unwrap();
 
             components.emplace_front(sprite);
         }